@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/**
+ * Measures the latency of the database work behind an api v2 account_tx request with limit=400 against a live
+ * Cassandra/ScyllaDB instance: one page of account transactions followed by the headers of the ledgers they were
+ * included in. Reading one header per transaction is compared with a single batched read through the ledger header
+ * cache. The p99 of the per-request latency is reported in the `p99_ms` counter.
+ *
+ * The account has two transactions in each of kNUM_LEDGERS ledgers; pages are walked in order and wrap around, so with
+ * more ledgers than the header cache holds every page misses the cache and the batched read itself is measured.
+ *
+ * The database is taken from the CLIO_BENCHMARK_DB_HOST environment variable (127.0.0.1 by default); the benchmarks are
+ * skipped if it can't be reached. Note: the `clio_benchmark_account_tx` keyspace is dropped and recreated on every run.
+ */
+
+#include "data/BackendInterface.hpp"
+#include "data/CassandraBackend.hpp"
+#include "data/DBHelpers.hpp"
+#include "data/LedgerHeaderCache.hpp"
+#include "data/Types.hpp"
+#include "data/cassandra/Handle.hpp"
+#include "data/cassandra/SettingsProvider.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/ObjectView.hpp"
+#include "util/newconfig/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/spawn.hpp>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/AccountID.h>
+#include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace util::config;
+
+namespace {
+
+constexpr uint32_t kFIRST_SEQ = 1000;
+constexpr uint32_t kNUM_LEDGERS = 2 * data::LedgerHeaderCache::kDEFAULT_CAPACITY + 1;
+constexpr uint32_t kTXNS_PER_LEDGER = 2;
+constexpr uint32_t kLIMIT = 400;
+constexpr auto kKEYSPACE = "clio_benchmark_account_tx";
+
+ripple::AccountID const kACCOUNT{42};
+
+std::string
+dbHost()
+{
+    if (auto const* host = std::getenv("CLIO_BENCHMARK_DB_HOST"); host != nullptr)  // NOLINT(concurrency-mt-unsafe)
+        return host;
+    return "127.0.0.1";
+}
+
+ClioConfigDefinition
+makeConfig()
+{
+    ClioConfigDefinition config{
+        {"prometheus.compress_reply", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"prometheus.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"database.cassandra.contact_points", ConfigValue{ConfigType::String}.defaultValue(dbHost())},
+        {"database.cassandra.secure_connect_bundle", ConfigValue{ConfigType::String}.optional()},
+        {"database.cassandra.port", ConfigValue{ConfigType::Integer}.optional()},
+        {"database.cassandra.keyspace", ConfigValue{ConfigType::String}.defaultValue(kKEYSPACE)},
+        {"database.cassandra.replication_factor", ConfigValue{ConfigType::Integer}.defaultValue(1)},
+        {"database.cassandra.table_prefix", ConfigValue{ConfigType::String}.optional()},
+        {"database.cassandra.max_write_requests_outstanding", ConfigValue{ConfigType::Integer}.defaultValue(10'000)},
+        {"database.cassandra.max_read_requests_outstanding", ConfigValue{ConfigType::Integer}.defaultValue(100'000)},
+        {"database.cassandra.threads",
+         ConfigValue{ConfigType::Integer}.defaultValue(static_cast<uint32_t>(std::thread::hardware_concurrency()))},
+        {"database.cassandra.core_connections_per_host", ConfigValue{ConfigType::Integer}.defaultValue(1)},
+        {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional()},
+        {"database.cassandra.write_batch_size", ConfigValue{ConfigType::Integer}.defaultValue(20)},
+        {"database.cassandra.connect_timeout", ConfigValue{ConfigType::Integer}.defaultValue(2).optional()},
+        {"database.cassandra.request_timeout", ConfigValue{ConfigType::Integer}.defaultValue(10).optional()},
+        {"database.cassandra.username", ConfigValue{ConfigType::String}.optional()},
+        {"database.cassandra.password", ConfigValue{ConfigType::String}.optional()},
+        {"database.cassandra.certfile", ConfigValue{ConfigType::String}.optional()},
+    };
+    return config;
+}
+
+std::string
+headerToBlob(ripple::LedgerHeader const& header)
+{
+    ripple::Serializer serializer;
+    ripple::addRaw(header, serializer, true);
+    return {serializer.peekData().begin(), serializer.peekData().end()};
+}
+
+/**
+ * @brief Lazily creates a keyspace holding kNUM_LEDGERS ledgers with kTXNS_PER_LEDGER transactions of kACCOUNT each.
+ */
+class AccountTxFixture {
+    ClioConfigDefinition config_ = makeConfig();
+    std::unique_ptr<data::BackendInterface> backend_;
+
+public:
+    AccountTxFixture()
+    {
+        data::cassandra::Handle const handle{dbHost()};
+        if (not handle.connect())
+            return;
+
+        [[maybe_unused]] auto const dropped = handle.execute(std::string{"DROP KEYSPACE IF EXISTS "} + kKEYSPACE);
+
+        PrometheusService::init(config_);
+        backend_ = std::make_unique<data::cassandra::CassandraBackend>(
+            data::cassandra::SettingsProvider{config_.getObject("database.cassandra")}, false
+        );
+
+        backend_->startWrites();
+        for (auto seq = kFIRST_SEQ; seq < kFIRST_SEQ + kNUM_LEDGERS; ++seq) {
+            ripple::LedgerHeader header;
+            header.seq = seq;
+            header.hash = ripple::uint256{seq};
+            backend_->writeLedger(header, headerToBlob(header));
+
+            std::vector<data::AccountTransactionsData> accountTxns;
+            for (auto index = 0u; index < kTXNS_PER_LEDGER; ++index) {
+                auto& accountTx = accountTxns.emplace_back();
+                accountTx.accounts.insert(kACCOUNT);
+                accountTx.ledgerSequence = seq;
+                accountTx.transactionIndex = index;
+                accountTx.txHash = ripple::uint256{(static_cast<std::uint64_t>(seq) << 8u) | index};
+
+                backend_->writeTransaction(
+                    data::uint256ToString(accountTx.txHash), seq, seq, std::string(256, 't'), std::string(512, 'm')
+                );
+            }
+            backend_->writeAccountTransactions(std::move(accountTxns));
+        }
+        [[maybe_unused]] auto const finished = backend_->finishWrites(kFIRST_SEQ + kNUM_LEDGERS - 1);
+    }
+
+    data::BackendInterface*
+    backend()
+    {
+        return backend_.get();
+    }
+};
+
+data::BackendInterface*
+backend()
+{
+    static AccountTxFixture fixture;
+    return fixture.backend();
+}
+
+template <bool Batched>
+void
+benchmarkAccountTx(benchmark::State& state)
+{
+    auto* db = backend();
+    if (db == nullptr) {
+        state.SkipWithError("Database is not reachable");
+        return;
+    }
+
+    std::optional<data::TransactionsCursor> cursor;
+    std::vector<double> latencies;
+
+    for (auto _ : state) {
+        auto const start = std::chrono::steady_clock::now();
+        auto const [txns, nextCursor] = data::synchronous([&](boost::asio::yield_context yield) {
+            auto page = db->fetchAccountTransactions(kACCOUNT, kLIMIT, false, cursor, yield);
+
+            if constexpr (Batched) {
+                std::vector<std::uint32_t> sequences;
+                for (auto const& txn : page.txns) {
+                    if (sequences.empty() or sequences.back() != txn.ledgerSequence)
+                        sequences.push_back(txn.ledgerSequence);
+                }
+                benchmark::DoNotOptimize(db->fetchLedgersBySequence(sequences, yield));
+            } else {
+                for (auto const& txn : page.txns)
+                    benchmark::DoNotOptimize(db->fetchLedgerBySequence(txn.ledgerSequence, yield));
+            }
+            return page;
+        });
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+        latencies.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+
+        benchmark::DoNotOptimize(txns.data());
+        cursor = nextCursor;  // starts over from the newest ledger after the last page
+    }
+
+    if (latencies.empty())
+        return;
+
+    std::ranges::sort(latencies);
+    auto const p99Rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(latencies.size())));
+    state.counters["p99_ms"] = latencies[p99Rank - 1];
+}
+
+}  // namespace
+
+BENCHMARK(benchmarkAccountTx<false>)->Name("AccountTxLedgerHeadersPerTransaction")->UseRealTime();
+BENCHMARK(benchmarkAccountTx<true>)->Name("AccountTxLedgerHeadersBatched")->UseRealTime();
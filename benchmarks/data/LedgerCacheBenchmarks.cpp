@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "util/Random.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+namespace {
+
+constexpr auto kNUM_OBJECTS = 1'000'000uz;
+constexpr auto kDIFF_SIZE = 512uz;
+constexpr auto kBLOB_SIZE = 64uz;
+
+/**
+ * @brief The previous LedgerCache storage: a single std::map behind a single shared mutex. Kept as the baseline.
+ */
+class MapLedgerCache {
+    struct CacheEntry {
+        uint32_t seq = 0;
+        data::Blob blob;
+    };
+
+    std::map<ripple::uint256, CacheEntry> map_;
+    mutable std::shared_mutex mtx_;
+    uint32_t latestSeq_ = 0;
+
+public:
+    void
+    update(std::vector<data::LedgerObject> const& objs, uint32_t seq, bool /* isBackground */ = false)
+    {
+        std::scoped_lock const lck{mtx_};
+        latestSeq_ = std::max(seq, latestSeq_);
+        for (auto const& obj : objs) {
+            if (!obj.blob.empty()) {
+                auto& e = map_[obj.key];
+                if (seq > e.seq)
+                    e = {.seq = seq, .blob = obj.blob};
+            } else {
+                map_.erase(obj.key);
+            }
+        }
+    }
+
+    std::optional<data::Blob>
+    get(ripple::uint256 const& key, uint32_t seq) const
+    {
+        std::shared_lock const lck{mtx_};
+        if (seq > latestSeq_)
+            return {};
+        auto e = map_.find(key);
+        if (e == map_.end() or seq < e->second.seq)
+            return {};
+        return {e->second.blob};
+    }
+
+    std::optional<data::LedgerObject>
+    getSuccessor(ripple::uint256 const& key, uint32_t seq) const
+    {
+        std::shared_lock const lck{mtx_};
+        if (seq != latestSeq_)
+            return {};
+        auto e = map_.upper_bound(key);
+        if (e == map_.end())
+            return {};
+        return {{.key = e->first, .blob = e->second.blob}};
+    }
+
+    void
+    setFull()
+    {
+    }
+};
+
+ripple::uint256
+randomKey()
+{
+    ripple::uint256 key;
+    for (auto& byte : key)
+        byte = static_cast<unsigned char>(util::Random::uniform(0, 255));
+    return key;
+}
+
+std::vector<data::LedgerObject>
+generateObjects(std::size_t count)
+{
+    std::vector<data::LedgerObject> objs;
+    objs.reserve(count);
+    for (auto i = 0uz; i < count; ++i)
+        objs.push_back({.key = randomKey(), .blob = data::Blob(kBLOB_SIZE, 'x')});
+    return objs;
+}
+
+void
+initPrometheus()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        util::config::ClioConfigDefinition const config{
+            {"prometheus.compress_reply",
+             util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(false)},
+            {"prometheus.enabled", util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(true)}
+        };
+        PrometheusService::init(config);
+    });
+}
+
+template <typename CacheType>
+struct CacheFixture {
+    std::unique_ptr<CacheType> cache;
+    std::vector<data::LedgerObject> objects;
+
+    CacheFixture()
+    {
+        initPrometheus();
+        cache = std::make_unique<CacheType>();
+        objects = generateObjects(kNUM_OBJECTS);
+        cache->update(objects, 1);
+        cache->setFull();
+    }
+};
+
+template <typename CacheType>
+CacheFixture<CacheType>&
+fixture()
+{
+    static CacheFixture<CacheType> instance;
+    return instance;
+}
+
+}  // namespace
+
+template <typename CacheType>
+static void
+benchmarkCacheGet(benchmark::State& state)
+{
+    auto& f = fixture<CacheType>();
+    auto i = static_cast<std::size_t>(state.thread_index()) * 7919uz;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.cache->get(f.objects[i % f.objects.size()].key, 1));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename CacheType>
+static void
+benchmarkCacheSuccessor(benchmark::State& state)
+{
+    auto& f = fixture<CacheType>();
+    auto i = static_cast<std::size_t>(state.thread_index()) * 7919uz;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.cache->getSuccessor(f.objects[i % f.objects.size()].key, 1));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename CacheType>
+static void
+benchmarkCacheUpdate(benchmark::State& state)
+{
+    initPrometheus();
+    CacheType cache;
+    auto const objects = generateObjects(kNUM_OBJECTS / 10);
+    cache.update(objects, 1);
+    cache.setFull();
+
+    // each ledger modifies existing objects, creates new ones and deletes some
+    uint32_t seq = 2;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto diff = generateObjects(kDIFF_SIZE / 2);
+        for (auto i = 0uz; i < kDIFF_SIZE / 2; ++i) {
+            auto const& existing = objects[util::Random::uniform(0uz, objects.size() - 1)];
+            diff.push_back({.key = existing.key, .blob = i % 4 == 0 ? data::Blob{} : existing.blob});
+        }
+        state.ResumeTiming();
+
+        cache.update(diff, seq++);
+    }
+    state.SetItemsProcessed(state.iterations() * kDIFF_SIZE);
+}
+
+BENCHMARK(benchmarkCacheGet<MapLedgerCache>)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(benchmarkCacheGet<data::LedgerCache>)->ThreadRange(1, 32)->UseRealTime();
+
+BENCHMARK(benchmarkCacheSuccessor<MapLedgerCache>)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(benchmarkCacheSuccessor<data::LedgerCache>)->ThreadRange(1, 32)->UseRealTime();
+
+BENCHMARK(benchmarkCacheUpdate<MapLedgerCache>);
+BENCHMARK(benchmarkCacheUpdate<data::LedgerCache>);
@@ -0,0 +1,215 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/**
+ * Measures pages per second of BackendInterface::fetchLedgerPage against a live Cassandra/ScyllaDB instance and compares
+ * it with a strictly sequential successor walk followed by a single object fetch.
+ *
+ * The database is taken from the CLIO_BENCHMARK_DB_HOST environment variable (127.0.0.1 by default); the benchmarks are
+ * skipped if it can't be reached. A local instance can be started with e.g. `docker run -p 9042:9042 scylladb/scylla`.
+ * Note: the `clio_benchmark_ledger_page` keyspace is dropped and recreated on every run.
+ */
+
+#include "data/BackendInterface.hpp"
+#include "data/CassandraBackend.hpp"
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+#include "data/cassandra/Handle.hpp"
+#include "data/cassandra/SettingsProvider.hpp"
+#include "util/Random.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/ObjectView.hpp"
+#include "util/newconfig/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/spawn.hpp>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace util::config;
+
+namespace {
+
+constexpr auto kNUM_OBJECTS = 20'000uz;
+constexpr auto kBLOB_SIZE = 128uz;
+constexpr uint32_t kSEQ = 1000;
+constexpr auto kKEYSPACE = "clio_benchmark_ledger_page";
+
+std::string
+dbHost()
+{
+    if (auto const* host = std::getenv("CLIO_BENCHMARK_DB_HOST"); host != nullptr)  // NOLINT(concurrency-mt-unsafe)
+        return host;
+    return "127.0.0.1";
+}
+
+ClioConfigDefinition
+makeConfig()
+{
+    ClioConfigDefinition config{
+        {"prometheus.compress_reply", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"prometheus.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"database.cassandra.contact_points", ConfigValue{ConfigType::String}.defaultValue(dbHost())},
+        {"database.cassandra.secure_connect_bundle", ConfigValue{ConfigType::String}.optional()},
+        {"database.cassandra.port", ConfigValue{ConfigType::Integer}.optional()},
+        {"database.cassandra.keyspace", ConfigValue{ConfigType::String}.defaultValue(kKEYSPACE)},
+        {"database.cassandra.replication_factor", ConfigValue{ConfigType::Integer}.defaultValue(1)},
+        {"database.cassandra.table_prefix", ConfigValue{ConfigType::String}.optional()},
+        {"database.cassandra.max_write_requests_outstanding", ConfigValue{ConfigType::Integer}.defaultValue(10'000)},
+        {"database.cassandra.max_read_requests_outstanding", ConfigValue{ConfigType::Integer}.defaultValue(100'000)},
+        {"database.cassandra.threads",
+         ConfigValue{ConfigType::Integer}.defaultValue(static_cast<uint32_t>(std::thread::hardware_concurrency()))},
+        {"database.cassandra.core_connections_per_host", ConfigValue{ConfigType::Integer}.defaultValue(1)},
+        {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional()},
+        {"database.cassandra.write_batch_size", ConfigValue{ConfigType::Integer}.defaultValue(20)},
+        {"database.cassandra.connect_timeout", ConfigValue{ConfigType::Integer}.defaultValue(2).optional()},
+        {"database.cassandra.request_timeout", ConfigValue{ConfigType::Integer}.defaultValue(10).optional()},
+        {"database.cassandra.username", ConfigValue{ConfigType::String}.optional()},
+        {"database.cassandra.password", ConfigValue{ConfigType::String}.optional()},
+        {"database.cassandra.certfile", ConfigValue{ConfigType::String}.optional()},
+    };
+    return config;
+}
+
+/**
+ * @brief Lazily creates a keyspace holding kNUM_OBJECTS ledger objects linked through the successor table.
+ */
+class LedgerPageFixture {
+    ClioConfigDefinition config_ = makeConfig();
+    std::unique_ptr<data::BackendInterface> backend_;
+
+public:
+    LedgerPageFixture()
+    {
+        data::cassandra::Handle const handle{dbHost()};
+        if (not handle.connect())
+            return;
+
+        [[maybe_unused]] auto const dropped = handle.execute(std::string{"DROP KEYSPACE IF EXISTS "} + kKEYSPACE);
+
+        PrometheusService::init(config_);
+        backend_ = std::make_unique<data::cassandra::CassandraBackend>(
+            data::cassandra::SettingsProvider{config_.getObject("database.cassandra")}, false
+        );
+
+        std::vector<ripple::uint256> keys(kNUM_OBJECTS);
+        for (auto& key : keys) {
+            for (auto& byte : key)
+                byte = static_cast<unsigned char>(util::Random::uniform(0, 255));
+        }
+        std::ranges::sort(keys);
+
+        backend_->startWrites();
+        auto prev = data::kFIRST_KEY;
+        for (auto const& key : keys) {
+            backend_->writeLedgerObject(data::uint256ToString(key), kSEQ, std::string(kBLOB_SIZE, 'x'));
+            backend_->writeSuccessor(data::uint256ToString(prev), kSEQ, data::uint256ToString(key));
+            prev = key;
+        }
+        backend_->writeSuccessor(data::uint256ToString(prev), kSEQ, data::uint256ToString(data::kLAST_KEY));
+        [[maybe_unused]] auto const finished = backend_->finishWrites(kSEQ);
+    }
+
+    data::BackendInterface*
+    backend()
+    {
+        return backend_.get();
+    }
+};
+
+data::BackendInterface*
+backend()
+{
+    static LedgerPageFixture fixture;
+    return fixture.backend();
+}
+
+// the way pages were fetched before pipelining: walk all successors, then fetch all objects at once
+data::LedgerPage
+fetchLedgerPageSequentially(
+    data::BackendInterface& backend,
+    std::optional<ripple::uint256> const& cursor,
+    uint32_t limit,
+    boost::asio::yield_context yield
+)
+{
+    std::vector<ripple::uint256> keys;
+    auto succ = backend.fetchSuccessorKey(cursor.value_or(data::kFIRST_KEY), kSEQ, yield);
+    while (succ.has_value() and keys.size() < limit) {
+        keys.push_back(*succ);
+        if (keys.size() < limit)
+            succ = backend.fetchSuccessorKey(keys.back(), kSEQ, yield);
+    }
+
+    data::LedgerPage page;
+    auto objects = backend.fetchLedgerObjects(keys, kSEQ, yield);
+    for (auto i = 0uz; i < objects.size(); ++i)
+        page.objects.push_back({.key = keys[i], .blob = std::move(objects[i])});
+
+    if (succ.has_value() and not keys.empty())
+        page.cursor = keys.back();
+    return page;
+}
+
+template <bool Pipelined>
+void
+benchmarkFetchLedgerPage(benchmark::State& state)
+{
+    auto* db = backend();
+    if (db == nullptr) {
+        state.SkipWithError("Database is not reachable");
+        return;
+    }
+
+    auto const limit = static_cast<uint32_t>(state.range(0));
+    std::optional<ripple::uint256> cursor;
+    std::size_t pages = 0;
+
+    for (auto _ : state) {
+        auto const page = data::synchronous([&](boost::asio::yield_context yield) {
+            if constexpr (Pipelined) {
+                return db->fetchLedgerPage(cursor, kSEQ, limit, false, yield);
+            } else {
+                return fetchLedgerPageSequentially(*db, cursor, limit, yield);
+            }
+        });
+
+        benchmark::DoNotOptimize(page.objects.data());
+        cursor = page.cursor;  // wraps around to the first page at the end of the ledger
+        ++pages;
+    }
+
+    state.counters["pages_per_second"] = benchmark::Counter(static_cast<double>(pages), benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+BENCHMARK(benchmarkFetchLedgerPage<false>)->Name("FetchLedgerPageSequential")->Arg(64)->Arg(256)->Arg(2048)->UseRealTime();
+BENCHMARK(benchmarkFetchLedgerPage<true>)->Name("FetchLedgerPagePipelined")->Arg(64)->Arg(256)->Arg(2048)->UseRealTime();
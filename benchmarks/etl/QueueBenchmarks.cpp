@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/**
+ * Compares the mutex based ThreadSafeQueue with the LockFreeQueue used by the ETL extraction pipeline and the cache
+ * loader.
+ *
+ * - PushPop: every benchmark thread pushes and pops one element per iteration on a shared queue; reports the number of
+ *   elements that went through the queue in `items_per_second`.
+ * - Handoff: half of the threads produce timestamps and the other half consume them through a small queue; reports
+ *   the throughput and the average time an element spent between push and pop in `latency_ns`.
+ */
+
+#include "etl/ETLHelpers.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr auto kQUEUE_SIZE = 1024uz;
+constexpr auto kHANDOFF_QUEUE_SIZE = 64uz;
+constexpr auto kHANDOFF_ITEMS = 100'000uz;
+
+template <typename QueueType>
+std::unique_ptr<QueueType> gSharedQueue;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+template <typename QueueType>
+void
+benchmarkPushPop(benchmark::State& state)
+{
+    // code before the loop runs in every thread; the loop starts only after all threads got there
+    if (state.thread_index() == 0)
+        gSharedQueue<QueueType> = std::make_unique<QueueType>(kQUEUE_SIZE);
+
+    for (auto _ : state) {
+        gSharedQueue<QueueType>->push(std::uint64_t{42});
+        benchmark::DoNotOptimize(gSharedQueue<QueueType>->pop());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename QueueType>
+void
+benchmarkHandoff(benchmark::State& state)
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto const numThreads = static_cast<std::size_t>(state.range(0));
+    auto const numProducers = std::max(numThreads / 2, 1uz);
+    auto const numConsumers = std::max(numThreads - numProducers, 1uz);
+    auto const itemsPerProducer = kHANDOFF_ITEMS / numProducers;
+
+    std::int64_t totalLatency = 0;
+    std::size_t totalItems = 0;
+
+    for (auto _ : state) {
+        QueueType queue{kHANDOFF_QUEUE_SIZE};
+        std::atomic_int64_t latency = 0;
+        std::vector<std::thread> threads;
+
+        for (auto i = 0uz; i < numProducers; ++i) {
+            threads.emplace_back([&queue, itemsPerProducer] {
+                for (auto item = 0uz; item < itemsPerProducer; ++item)
+                    queue.push(Clock::now().time_since_epoch().count());
+            });
+        }
+
+        for (auto i = 0uz; i < numConsumers; ++i) {
+            threads.emplace_back([&queue, &latency] {
+                std::int64_t localLatency = 0;
+                while (auto pushedAt = queue.pop()) {
+                    localLatency += Clock::now().time_since_epoch().count() - *pushedAt;
+                }
+                latency += localLatency;
+            });
+        }
+
+        for (auto i = 0uz; i < numProducers; ++i)
+            threads[i].join();
+
+        for (auto i = 0uz; i < numConsumers; ++i)
+            queue.push(std::nullopt);
+
+        for (auto& thread : threads) {
+            if (thread.joinable())
+                thread.join();
+        }
+
+        totalLatency += latency;
+        totalItems += itemsPerProducer * numProducers;
+    }
+
+    auto const averageLatency = Clock::duration{totalLatency / static_cast<std::int64_t>(totalItems)};
+    state.SetItemsProcessed(static_cast<std::int64_t>(totalItems));
+    state.counters["latency_ns"] = std::chrono::duration_cast<std::chrono::nanoseconds>(averageLatency).count();
+}
+
+using MutexQueue = etl::ThreadSafeQueue<std::uint64_t>;
+using LockFreeQueue = etl::LockFreeQueue<std::uint64_t>;
+using MutexHandoffQueue = etl::ThreadSafeQueue<std::optional<std::int64_t>>;
+using LockFreeHandoffQueue = etl::LockFreeQueue<std::optional<std::int64_t>>;
+
+}  // namespace
+
+BENCHMARK(benchmarkPushPop<MutexQueue>)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(benchmarkPushPop<LockFreeQueue>)->ThreadRange(1, 32)->UseRealTime();
+
+BENCHMARK(benchmarkHandoff<MutexHandoffQueue>)->RangeMultiplier(2)->Range(2, 32)->UseRealTime();
+BENCHMARK(benchmarkHandoff<LockFreeHandoffQueue>)->RangeMultiplier(2)->Range(2, 32)->UseRealTime();
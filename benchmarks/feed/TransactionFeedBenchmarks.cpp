@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/**
+ * Measures how fast the transactions feed fans messages out to many subscribers. Every subscriber listens to all
+ * transactions; each iteration publishes one ledger worth of transactions and waits until every subscriber received
+ * all of them. The rate of delivered messages is reported in `items_per_second`.
+ *
+ * The subscribers only count what they receive, so the cost measured is the fan-out itself: slot lookup and invocation,
+ * duplicate detection and the lazy serialization of the messages, split across the given number of shards (strands).
+ */
+
+#include "data/Types.hpp"
+#include "feed/impl/TransactionFeed.hpp"
+#include "util/Taggable.hpp"
+#include "util/async/AnyExecutionContext.hpp"
+#include "util/async/context/BasicExecutionContext.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ConfigValue.hpp"
+#include "util/newconfig/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+#include "web/SubscriptionContextInterface.hpp"
+
+#include <benchmark/benchmark.h>
+#include <xrpl/basics/Slice.h>
+#include <xrpl/protocol/AccountID.h>
+#include <xrpl/protocol/LedgerFormats.h>
+#include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/STArray.h>
+#include <xrpl/protocol/STObject.h>
+#include <xrpl/protocol/TER.h>
+#include <xrpl/protocol/TxFormats.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr auto kNUM_THREADS = 8uz;
+constexpr auto kTXNS_PER_LEDGER = 16uz;
+constexpr std::uint32_t kLEDGER_SEQ = 1000;
+
+class CountingSubscriber : public web::SubscriptionContextInterface {
+    std::atomic_size_t& delivered_;
+
+public:
+    CountingSubscriber(util::TagDecoratorFactory const& tagFactory, std::atomic_size_t& delivered)
+        : web::SubscriptionContextInterface(tagFactory), delivered_(delivered)
+    {
+    }
+
+    void
+    send(std::shared_ptr<std::string> message) override
+    {
+        benchmark::DoNotOptimize(message);
+        delivered_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void
+    onDisconnect(OnDisconnectSlot const&) override
+    {
+    }
+
+    void
+    setApiSubversion(std::uint32_t) override
+    {
+    }
+
+    std::uint32_t
+    apiSubversion() const override
+    {
+        return 2;
+    }
+};
+
+util::config::ClioConfigDefinition
+makeConfig()
+{
+    return util::config::ClioConfigDefinition{
+        {"prometheus.compress_reply", util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(false)},
+        {"prometheus.enabled", util::config::ConfigValue{util::config::ConfigType::Boolean}.defaultValue(true)},
+        {"log_tag_style", util::config::ConfigValue{util::config::ConfigType::String}.defaultValue("none")}
+    };
+}
+
+void
+initPrometheus(util::config::ClioConfigDefinition const& config)
+{
+    static std::once_flag once;
+    std::call_once(once, [&config] { PrometheusService::init(config); });
+}
+
+data::TransactionAndMetadata
+makePayment(std::uint32_t index)
+{
+    ripple::AccountID const sender{index + 1};
+    ripple::AccountID const receiver{index + 2};
+
+    ripple::STObject tx(ripple::sfTransaction);
+    tx.setFieldU16(ripple::sfTransactionType, ripple::ttPAYMENT);
+    tx.setAccountID(ripple::sfAccount, sender);
+    tx.setAccountID(ripple::sfDestination, receiver);
+    tx.setFieldAmount(ripple::sfAmount, ripple::STAmount(100, false));
+    tx.setFieldAmount(ripple::sfFee, ripple::STAmount(10, false));
+    tx.setFieldU32(ripple::sfSequence, index);
+    tx.setFieldVL(ripple::sfSigningPubKey, ripple::Slice("test", 4));
+
+    ripple::STArray nodes{2};
+    for (auto const& [account, balance] : {std::pair{sender, 1000}, std::pair{receiver, 2000}}) {
+        ripple::STObject finalFields(ripple::sfFinalFields);
+        finalFields.setAccountID(ripple::sfAccount, account);
+        finalFields.setFieldAmount(ripple::sfBalance, ripple::STAmount(balance));
+
+        ripple::STObject node(ripple::sfModifiedNode);
+        node.setFieldU16(ripple::sfLedgerEntryType, ripple::ltACCOUNT_ROOT);
+        node.emplace_back(std::move(finalFields));
+        nodes.push_back(std::move(node));
+    }
+
+    ripple::STObject meta(ripple::sfTransactionMetaData);
+    meta.setFieldArray(ripple::sfAffectedNodes, nodes);
+    meta.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    meta.setFieldU32(ripple::sfTransactionIndex, index);
+
+    return {tx.getSerializer().peekData(), meta.getSerializer().peekData(), kLEDGER_SEQ, 0};
+}
+
+}  // namespace
+
+static void
+benchmarkTransactionFeedFanOut(benchmark::State& state)
+{
+    auto const numSubscribers = static_cast<std::size_t>(state.range(0));
+    auto const numShards = static_cast<std::size_t>(state.range(1));
+
+    auto const config = makeConfig();
+    initPrometheus(config);
+    util::TagDecoratorFactory const tagFactory{config};
+
+    util::async::PoolExecutionContext pool{kNUM_THREADS};
+    util::async::AnyExecutionContext ctx{pool};
+    feed::impl::TransactionFeed feed{ctx, numShards};
+
+    std::atomic_size_t delivered = 0;
+    std::vector<std::shared_ptr<CountingSubscriber>> subscribers;
+    subscribers.reserve(numSubscribers);
+    for (auto i = 0uz; i < numSubscribers; ++i) {
+        subscribers.push_back(std::make_shared<CountingSubscriber>(tagFactory, delivered));
+        feed.sub(subscribers.back());
+    }
+
+    std::vector<data::TransactionAndMetadata> ledger;
+    for (auto i = 0u; i < kTXNS_PER_LEDGER; ++i)
+        ledger.push_back(makePayment(i));
+
+    ripple::LedgerHeader header;
+    header.seq = kLEDGER_SEQ;
+
+    auto const messagesPerLedger = numSubscribers * kTXNS_PER_LEDGER;
+    auto expected = 0uz;
+
+    for (auto _ : state) {
+        expected += messagesPerLedger;
+        feed.pub(ledger, header, nullptr);
+
+        while (delivered.load(std::memory_order_relaxed) < expected)
+            std::this_thread::yield();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * messagesPerLedger));
+
+    for (auto const& subscriber : subscribers)
+        feed.unsub(subscriber);
+    pool.stop();
+    pool.join();
+}
+
+BENCHMARK(benchmarkTransactionFeedFanOut)
+    ->ArgsProduct({{1'000, 10'000, 50'000}, {1, 2, 4, 8}})
+    ->ArgNames({"subscribers", "shards"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
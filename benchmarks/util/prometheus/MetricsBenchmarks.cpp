@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/**
+ * Measures contention on the hot path of the prometheus metrics: every benchmark thread updates the same metric on
+ * each iteration. Compares the mutex/single atomic implementations with the sharded ones used by default.
+ *
+ * - Observe: HistogramInt::observe() with a value spread over all the buckets.
+ * - Add: ++CounterInt.
+ */
+
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Histogram.hpp"
+#include "util/prometheus/impl/CounterImpl.hpp"
+#include "util/prometheus/impl/HistogramImpl.hpp"
+#include "util/prometheus/impl/ShardedCounterImpl.hpp"
+#include "util/prometheus/impl/ShardedHistogramImpl.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+using util::prometheus::CounterInt;
+using util::prometheus::HistogramInt;
+
+constexpr std::int64_t kMAX_VALUE = 1024;
+
+template <typename ImplType>
+std::unique_ptr<HistogramInt> gSharedHistogram;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+template <typename ImplType>
+std::unique_ptr<CounterInt> gSharedCounter;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+template <typename ImplType>
+void
+benchmarkObserve(benchmark::State& state)
+{
+    // code before the loop runs in every thread; the loop starts only after all threads got there
+    if (state.thread_index() == 0) {
+        gSharedHistogram<ImplType> = std::make_unique<HistogramInt>(
+            "benchmark_histogram", "", HistogramInt::Buckets{1, 2, 4, 8, 16, 32, 64, 128, 256, 512}, ImplType{}
+        );
+    }
+
+    std::int64_t value = state.thread_index();
+    for (auto _ : state) {
+        gSharedHistogram<ImplType>->observe(value);
+        value = (value + 1) % kMAX_VALUE;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename ImplType>
+void
+benchmarkAdd(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+        gSharedCounter<ImplType> = std::make_unique<CounterInt>("benchmark_counter", "", ImplType{});
+
+    for (auto _ : state)
+        ++(*gSharedCounter<ImplType>);
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+using MutexHistogram = util::prometheus::impl::HistogramImpl<std::int64_t>;
+using ShardedHistogram = util::prometheus::impl::ShardedHistogramImpl<std::int64_t>;
+using AtomicCounter = util::prometheus::impl::CounterImpl<std::uint64_t>;
+using ShardedCounter = util::prometheus::impl::ShardedCounterImpl<std::uint64_t>;
+
+}  // namespace
+
+BENCHMARK(benchmarkObserve<MutexHistogram>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(benchmarkObserve<ShardedHistogram>)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK(benchmarkAdd<AtomicCounter>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(benchmarkAdd<ShardedCounter>)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/**
+ * Measures the cost of adding the rate limit warning to a large response of a client that went over its DOSGuard
+ * budget. Parsing the serialized response, adding the warning and serializing it again is compared with serializing
+ * the response once with its warnings at the end and rewriting only that tail. Responses look like an account_tx
+ * result and are 1, 4 and 16 MB large; the processed response bytes are reported in `bytes_per_second`.
+ */
+
+#include "web/impl/WarningsTail.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace {
+
+boost::json::object
+makeResponse(std::size_t approximateSize)
+{
+    boost::json::array transactions;
+    std::size_t size = 0;
+    for (auto i = 0u; size < approximateSize; ++i) {
+        boost::json::object tx{
+            {"Account", "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"},
+            {"Destination", "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun"},
+            {"Amount", fmt::format("{}", 1'000'000 + i)},
+            {"Fee", "10"},
+            {"Sequence", i},
+            {"TransactionType", "Payment"},
+            {"hash", fmt::format("{:064X}", i)},
+            {"ledger_index", 1000 + (i / 16)},
+        };
+        size += boost::json::serialize(tx).size();
+        transactions.push_back(boost::json::object{{"tx", std::move(tx)}, {"validated", true}});
+    }
+
+    return boost::json::object{
+        {"result", {{"account", "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"}, {"transactions", std::move(transactions)}}},
+        {"warnings", boost::json::array{boost::json::object{{"id", 2001}, {"message", "This is a clio server"}}}},
+    };
+}
+
+boost::json::object
+makeWarning()
+{
+    return {{"id", 2003}, {"message", "You are about to be rate limited"}};
+}
+
+void
+benchmarkReparse(benchmark::State& state)
+{
+    auto const response = makeResponse(static_cast<std::size_t>(state.range(0)));
+    auto const warning = makeWarning();
+    std::size_t bytes = 0;
+
+    for (auto _ : state) {
+        auto message = boost::json::serialize(response);
+        auto json = boost::json::parse(message).as_object();
+        web::impl::addLoadWarning(json, warning);
+        message = boost::json::serialize(json);
+
+        bytes += message.size();
+        benchmark::DoNotOptimize(message);
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+}
+
+void
+benchmarkWarningsTail(benchmark::State& state)
+{
+    auto const response = makeResponse(static_cast<std::size_t>(state.range(0)));
+    auto const warning = makeWarning();
+    std::size_t bytes = 0;
+
+    for (auto _ : state) {
+        // the response is moved into serialize() by the server, so its copy is not measured
+        state.PauseTiming();
+        auto responseCopy = response;
+        state.ResumeTiming();
+
+        auto [message, tail] = web::impl::WarningsTail::serialize(std::move(responseCopy));
+        tail.addLoadWarning(message, warning);
+
+        bytes += message.size();
+        benchmark::DoNotOptimize(message);
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+}
+
+}  // namespace
+
+BENCHMARK(benchmarkReparse)
+    ->Name("LoadWarningReparse")
+    ->Arg(1 << 20)
+    ->Arg(4 << 20)
+    ->Arg(16 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmarkWarningsTail)
+    ->Name("LoadWarningTail")
+    ->Arg(1 << 20)
+    ->Arg(4 << 20)
+    ->Arg(16 << 20)
+    ->Unit(benchmark::kMillisecond);
@@ -131,7 +131,7 @@ ClioApplication::run(bool const useNgWebServer)
     // ETL is responsible for writing and publishing to streams. In read-only mode, ETL only publishes
     auto etl = etl::ETLService::makeETLService(config_, ioc, backend, subscriptions, balancer, ledgers);
 
-    auto workQueue = rpc::WorkQueue::makeWorkQueue(config_);
+    auto workQueue = rpc::WorkQueue::makeWorkQueue(config_, [backend] { return backend->readLatency(); });
     auto counters = rpc::Counters::makeCounters(workQueue);
     auto const amendmentCenter = std::make_shared<data::AmendmentCenter const>(backend);
     auto const handlerProvider = std::make_shared<rpc::impl::ProductionHandlerProvider const>(
@@ -30,7 +30,6 @@
 
 #include <boost/asio/spawn.hpp>
 #include <boost/beast/http/status.hpp>
-#include <boost/json/array.hpp>
 #include <boost/json/parse.hpp>
 
 #include <exception>
@@ -209,16 +208,8 @@ public:
         try {
             auto response = rpcHandler_(request, connectionMetadata, std::move(subscriptionContext), yield);
 
-            if (not dosguard_.get().add(connectionMetadata.ip(), response.message().size())) {
-                auto jsonResponse = boost::json::parse(response.message()).as_object();
-                jsonResponse["warning"] = "load";
-                if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                    jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::WarnRpcRateLimit));
-                } else {
-                    jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::WarnRpcRateLimit)};
-                }
-                response.setMessage(jsonResponse);
-            }
+            if (not dosguard_.get().add(connectionMetadata.ip(), response.message().size()))
+                response.addLoadWarning(rpc::makeWarning(rpc::WarnRpcRateLimit));
 
             return response;
         } catch (std::exception const&) {
@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/AccountTxCache.hpp"
+
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+
+#include <xrpl/protocol/AccountID.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+bool
+AccountTxCache::PageKey::operator<(PageKey const& other) const
+{
+    auto const asTuple = [](PageKey const& key) {
+        return std::make_tuple(
+            key.account,
+            key.forward,
+            key.limit,
+            key.cursor.has_value(),
+            key.cursor.value_or(TransactionsCursor{}).asTuple()
+        );
+    };
+    return asTuple(*this) < asTuple(other);
+}
+
+namespace {
+
+std::size_t
+pageBytes(TransactionsAndCursor const& page)
+{
+    std::size_t bytes = 0;
+    for (auto const& txn : page.txns)
+        bytes += txn.transaction.size() + txn.metadata.size();
+    return bytes;
+}
+
+}  // namespace
+
+AccountTxCache::AccountTxCache(std::size_t maxBytes) : maxBytes_(maxBytes)
+{
+}
+
+std::optional<TransactionsAndCursor>
+AccountTxCache::get(PageKey const& key, std::uint32_t latestSeq)
+{
+    ++reqCounter_.get();
+    std::scoped_lock const lck{mtx_};
+
+    auto const it = pages_.find(key);
+    if (it == pages_.end())
+        return std::nullopt;
+
+    if (not isValid(key, it->second, latestSeq)) {
+        erase(it);
+        return std::nullopt;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+    ++hitCounter_.get();
+    return it->second.page;
+}
+
+void
+AccountTxCache::put(PageKey const& key, TransactionsAndCursor page, std::uint32_t seq)
+{
+    auto const bytes = pageBytes(page);
+    if (bytes > maxBytes_)
+        return;
+
+    std::scoped_lock const lck{mtx_};
+
+    // the page was read before the latest committed ledger and may miss its transactions
+    if (seq < trackedTo_)
+        return;
+
+    if (auto const it = pages_.find(key); it != pages_.end())
+        erase(it);
+
+    numBytes_ += bytes;
+    lru_.push_front(key);
+    pages_.emplace(key, Entry{.page = std::move(page), .bytes = bytes, .seq = seq, .lruPosition = lru_.begin()});
+
+    while (numBytes_ > maxBytes_)
+        erase(pages_.find(lru_.back()));
+}
+
+void
+AccountTxCache::invalidate(std::vector<AccountTransactionsData> const& data)
+{
+    std::scoped_lock const lck{mtx_};
+
+    for (auto const& record : data) {
+        for (auto const& account : record.accounts) {
+            if (pendingAccounts_.insert(account).second)
+                eraseAccount(account);
+        }
+    }
+}
+
+void
+AccountTxCache::commit(std::uint32_t seq)
+{
+    std::scoped_lock const lck{mtx_};
+
+    // pages read while the ledger was being written may miss some of its transactions
+    for (auto const& account : pendingAccounts_)
+        eraseAccount(account);
+    pendingAccounts_.clear();
+
+    if (trackedTo_ == 0 or seq != trackedTo_ + 1)
+        trackedFrom_ = seq;
+    trackedTo_ = seq;
+}
+
+std::size_t
+AccountTxCache::size() const
+{
+    std::scoped_lock const lck{mtx_};
+    return pages_.size();
+}
+
+std::size_t
+AccountTxCache::bytes() const
+{
+    std::scoped_lock const lck{mtx_};
+    return numBytes_;
+}
+
+bool
+AccountTxCache::isValid(PageKey const& key, Entry const& entry, std::uint32_t latestSeq) const
+{
+    // a backward page starting in a validated ledger only holds older transactions
+    if (not key.forward and key.cursor.has_value() and key.cursor->ledgerSequence <= entry.seq)
+        return true;
+
+    if (entry.seq == latestSeq)
+        return true;
+
+    // all ledgers since the page was read were written through this cache without touching the account
+    return trackedFrom_ != 0 and trackedFrom_ <= entry.seq and entry.seq <= latestSeq and latestSeq <= trackedTo_;
+}
+
+void
+AccountTxCache::erase(std::map<PageKey, Entry>::iterator it)
+{
+    numBytes_ -= it->second.bytes;
+    lru_.erase(it->second.lruPosition);
+    pages_.erase(it);
+}
+
+void
+AccountTxCache::eraseAccount(ripple::AccountID const& account)
+{
+    auto it = pages_.lower_bound(PageKey{.account = account});
+    while (it != pages_.end() and it->first.account == account)
+        erase(std::exchange(it, std::next(it)));
+}
+
+}  // namespace data
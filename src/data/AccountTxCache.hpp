@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <xrpl/protocol/AccountID.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief A bounded LRU cache of account_tx pages keyed by account and cursor.
+ *
+ * A page is cached together with the latest validated ledger sequence at the time it was read. Pages that end before
+ * that ledger (backward pages starting at a cursor) can never change and stay valid. Pages that may grow with new
+ * transactions (the newest page and forward pages) are valid for the ledger they were read at; when this process is
+ * the one writing ledgers they stay valid across newer ledgers for as long as the account has no new transactions.
+ * Writes of account transactions invalidate the pages of the affected accounts both when the transactions are written
+ * and once the ledger is committed.
+ *
+ * The cache is bounded by the total size of the transaction and metadata blobs of the cached pages.
+ *
+ * @note This class is thread-safe.
+ */
+class AccountTxCache {
+public:
+    /**
+     * @brief Identifies a page of account transactions
+     */
+    struct PageKey {
+        ripple::AccountID account;
+        bool forward = false;
+        std::uint32_t limit = 0;
+        std::optional<TransactionsCursor> cursor;
+
+        bool
+        operator<(PageKey const& other) const;
+    };
+
+private:
+    struct Entry {
+        TransactionsAndCursor page;
+        std::size_t bytes = 0;
+        std::uint32_t seq = 0;
+        std::list<PageKey>::iterator lruPosition;
+    };
+
+    std::size_t maxBytes_;
+
+    mutable std::mutex mtx_;
+    std::map<PageKey, Entry> pages_;
+    // most recently used page first
+    std::list<PageKey> lru_;
+    std::size_t numBytes_ = 0;
+
+    // accounts written for the ledger that is not committed yet
+    std::set<ripple::AccountID> pendingAccounts_;
+    // range of consecutive ledgers committed through this cache; zero if no ledger was committed
+    std::uint32_t trackedFrom_ = 0;
+    std::uint32_t trackedTo_ = 0;
+
+    std::reference_wrapper<util::prometheus::CounterInt> reqCounter_{PrometheusService::counterInt(
+        "account_tx_cache_counter_total_number",
+        util::prometheus::Labels{{{"type", "request"}}},
+        "AccountTxCache statistics"
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_{PrometheusService::counterInt(
+        "account_tx_cache_counter_total_number",
+        util::prometheus::Labels{{{"type", "cache_hit"}}}
+    )};
+
+public:
+    /**
+     * @brief Construct a new AccountTxCache
+     *
+     * @param maxBytes The maximum size of the transaction and metadata blobs held by all cached pages together
+     */
+    explicit AccountTxCache(std::size_t maxBytes);
+
+    /**
+     * @brief Get a cached page if it is still valid for the given latest validated ledger
+     *
+     * @param key The page to look for
+     * @param latestSeq The latest validated ledger sequence
+     * @return The page if cached and valid; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<TransactionsAndCursor>
+    get(PageKey const& key, std::uint32_t latestSeq);
+
+    /**
+     * @brief Cache a page read from the database
+     *
+     * @param key The page
+     * @param page The transactions and cursor of the page
+     * @param seq The latest validated ledger sequence at the time the page was read
+     */
+    void
+    put(PageKey const& key, TransactionsAndCursor page, std::uint32_t seq);
+
+    /**
+     * @brief Invalidate the pages of all accounts affected by the given account transactions
+     *
+     * The accounts are invalidated again when the ledger being written is committed.
+     *
+     * @param data The account transactions being written
+     */
+    void
+    invalidate(std::vector<AccountTransactionsData> const& data);
+
+    /**
+     * @brief Notify the cache that all writes of the given ledger are committed
+     *
+     * @param seq The sequence of the committed ledger
+     */
+    void
+    commit(std::uint32_t seq);
+
+    /**
+     * @return The number of cached pages
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * @return The size of the transaction and metadata blobs of all cached pages
+     */
+    [[nodiscard]] std::size_t
+    bytes() const;
+
+private:
+    [[nodiscard]] bool
+    isValid(PageKey const& key, Entry const& entry, std::uint32_t latestSeq) const;
+
+    void
+    erase(std::map<PageKey, Entry>::iterator it);
+
+    void
+    eraseAccount(ripple::AccountID const& account);
+};
+
+}  // namespace data
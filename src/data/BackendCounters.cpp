@@ -25,7 +25,9 @@
 
 #include <boost/json/object.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -38,6 +40,23 @@ namespace {
 
 std::vector<std::int64_t> const kHISTOGRAM_BUCKETS{1, 2, 5, 10, 20, 50, 100, 200, 500, 700, 1000};
 
+// weight of a new sample in the moving average of the read latency is 1 / kREAD_LATENCY_SMOOTHING
+constexpr std::int64_t kREAD_LATENCY_SMOOTHING = 8;
+
+// weight of a new sample in the moving average of the read latency deviation, as in TCP retransmission timers
+constexpr std::int64_t kREAD_LATENCY_DEVIATION_SMOOTHING = 4;
+
+// mean plus two mean deviations is close to the 95th percentile for roughly normal latencies
+constexpr std::int64_t kREAD_TAIL_LATENCY_DEVIATIONS = 2;
+
+void
+smooth(std::atomic_int64_t& average, std::int64_t const sample, std::int64_t const smoothing)
+{
+    auto current = average.load();
+    while (not average.compare_exchange_weak(current, current + ((sample - current) / smoothing))) {
+    }
+}
+
 std::int64_t
 durationInMillisecondsSince(std::chrono::steady_clock::time_point const startTime)
 {
@@ -64,6 +83,16 @@ BackendCounters::BackendCounters()
           Labels({Label{"operation", "write_sync_retry"}}),
           "The total number of times the backend had to retry a synchronous write"
       ))
+    , readHedgeFiredCounter_(PrometheusService::counterInt(
+          "backend_operations_total_number",
+          Labels({{"operation", "read_hedge"}, {"status", "fired"}}),
+          "The total number of reads sent a second time because the first attempt was slow"
+      ))
+    , readHedgeWonCounter_(PrometheusService::counterInt(
+          "backend_operations_total_number",
+          Labels({{"operation", "read_hedge"}, {"status", "won"}}),
+          "The total number of hedged reads answered first by the second attempt"
+      ))
     , asyncWriteCounters_{"write_async"}
     , asyncReadCounters_{"read_async"}
     , readDurationHistogram_(PrometheusService::histogramInt(
@@ -78,6 +107,12 @@ BackendCounters::BackendCounters()
           kHISTOGRAM_BUCKETS,
           "The duration of backend write operations including retries"
       ))
+    , writeBatchSizeHistogram_(PrometheusService::histogramInt(
+          "backend_write_batch_size_histogram",
+          Labels(),
+          kHISTOGRAM_BUCKETS,
+          "The number of statements sent in one partitioned write request"
+      ))
 {
 }
 
@@ -127,6 +162,12 @@ BackendCounters::registerWriteRetry()
     asyncWriteCounters_.registerRetry(1u);
 }
 
+void
+BackendCounters::registerWriteBatch(std::uint64_t const size)
+{
+    writeBatchSizeHistogram_.get().observe(static_cast<std::int64_t>(size));
+}
+
 void
 BackendCounters::registerReadStarted(std::uint64_t const count)
 {
@@ -140,6 +181,12 @@ BackendCounters::registerReadFinished(std::chrono::steady_clock::time_point cons
     auto const duration = durationInMillisecondsSince(startTime);
     for (std::uint64_t i = 0; i < count; ++i)
         readDurationHistogram_.get().observe(duration);
+
+    auto const sample =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+    auto const deviation = std::abs(sample - readLatencyUs_.load());
+    smooth(readLatencyDeviationUs_, deviation, kREAD_LATENCY_DEVIATION_SMOOTHING);
+    smooth(readLatencyUs_, sample, kREAD_LATENCY_SMOOTHING);
 }
 
 void
@@ -154,6 +201,32 @@ BackendCounters::registerReadError(std::uint64_t const count)
     asyncReadCounters_.registerError(count);
 }
 
+void
+BackendCounters::registerReadHedgeFired()
+{
+    ++readHedgeFiredCounter_.get();
+}
+
+void
+BackendCounters::registerReadHedgeWon()
+{
+    ++readHedgeWonCounter_.get();
+}
+
+std::chrono::microseconds
+BackendCounters::readLatency() const
+{
+    return std::chrono::microseconds{readLatencyUs_.load()};
+}
+
+std::chrono::microseconds
+BackendCounters::readTailLatency() const
+{
+    return std::chrono::microseconds{
+        readLatencyUs_.load() + (kREAD_TAIL_LATENCY_DEVIATIONS * readLatencyDeviationUs_.load())
+    };
+}
+
 boost::json::object
 BackendCounters::report() const
 {
@@ -165,6 +238,8 @@ BackendCounters::report() const
         result[key] = value;
     for (auto const& [key, value] : asyncReadCounters_.report())
         result[key] = value;
+    result["read_hedge_fired"] = readHedgeFiredCounter_.get().value();
+    result["read_hedge_won"] = readHedgeWonCounter_.get().value();
     return result;
 }
 
@@ -25,6 +25,7 @@
 
 #include <boost/json/object.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -45,10 +46,15 @@ concept SomeBackendCounters = requires(T a) {
     { a.registerWriteStarted() } -> std::same_as<void>;
     { a.registerWriteFinished(std::chrono::steady_clock::time_point{}) } -> std::same_as<void>;
     { a.registerWriteRetry() } -> std::same_as<void>;
+    { a.registerWriteBatch(std::uint64_t{}) } -> std::same_as<void>;
     { a.registerReadStarted(std::uint64_t{}) } -> std::same_as<void>;
     { a.registerReadFinished(std::chrono::steady_clock::time_point{}, std::uint64_t{}) } -> std::same_as<void>;
     { a.registerReadRetry(std::uint64_t{}) } -> std::same_as<void>;
     { a.registerReadError(std::uint64_t{}) } -> std::same_as<void>;
+    { a.registerReadHedgeFired() } -> std::same_as<void>;
+    { a.registerReadHedgeWon() } -> std::same_as<void>;
+    { a.readLatency() } -> std::same_as<std::chrono::microseconds>;
+    { a.readTailLatency() } -> std::same_as<std::chrono::microseconds>;
     { a.report() } -> std::same_as<boost::json::object>;
 };
 
@@ -109,6 +115,14 @@ public:
     void
     registerWriteRetry();
 
+    /**
+     * @brief Register the number of statements sent in one asynchronous write request
+     *
+     * @param size The number of statements; 1 for a write that is not batched
+     */
+    void
+    registerWriteBatch(std::uint64_t size);
+
     /**
      * @brief Register that one or more read operations were started
      *
@@ -142,6 +156,38 @@ public:
     void
     registerReadError(std::uint64_t count = 1u);
 
+    /**
+     * @brief Register that a read was sent a second time because the first attempt was slow
+     */
+    void
+    registerReadHedgeFired();
+
+    /**
+     * @brief Register that the second attempt of a hedged read answered first
+     */
+    void
+    registerReadHedgeWon();
+
+    /**
+     * @brief Get the recent latency of read operations
+     *
+     * This is an exponentially weighted moving average, so it follows changes in the latency within a few reads.
+     *
+     * @return The smoothed latency of read operations
+     */
+    std::chrono::microseconds
+    readLatency() const;
+
+    /**
+     * @brief Get an estimate of the 95th percentile of the recent latency of read operations
+     *
+     * The estimate is the smoothed latency plus twice its smoothed mean deviation.
+     *
+     * @return The estimated tail latency of read operations
+     */
+    std::chrono::microseconds
+    readTailLatency() const;
+
     /**
      * @brief Get a report of the backend counters
      *
@@ -185,11 +231,18 @@ private:
     std::reference_wrapper<util::prometheus::CounterInt> writeSyncCounter_;
     std::reference_wrapper<util::prometheus::CounterInt> writeSyncRetryCounter_;
 
+    std::reference_wrapper<util::prometheus::CounterInt> readHedgeFiredCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> readHedgeWonCounter_;
+
     AsyncOperationCounters asyncWriteCounters_{"write_async"};
     AsyncOperationCounters asyncReadCounters_{"read_async"};
 
     std::reference_wrapper<util::prometheus::HistogramInt> readDurationHistogram_;
     std::reference_wrapper<util::prometheus::HistogramInt> writeDurationHistogram_;
+    std::reference_wrapper<util::prometheus::HistogramInt> writeBatchSizeHistogram_;
+
+    std::atomic_int64_t readLatencyUs_{0};
+    std::atomic_int64_t readLatencyDeviationUs_{0};
 };
 
 }  // namespace data
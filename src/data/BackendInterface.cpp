@@ -21,31 +21,71 @@
 
 #include "data/Types.hpp"
 #include "util/Assert.hpp"
+#include "util/CoroutineGroup.hpp"
 #include "util/log/Logger.hpp"
 
 #include <boost/asio/spawn.hpp>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
 #include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/Protocol.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/STLedgerEntry.h>
 #include <xrpl/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <iterator>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 // local to compilation unit loggers
 namespace {
 util::Logger gLog{"Backend"};
+
+// number of successor keys collected before their objects are requested while fetching a ledger page
+constexpr std::size_t kLEDGER_PAGE_CHUNK_SIZE = 64;
+
+// the fields of a directory page needed to walk an order book
+struct DirectoryPage {
+    ripple::uint256 key;
+    std::vector<ripple::uint256> indexes;
+    std::uint64_t next = 0;
+    std::uint64_t prev = 0;
+
+    // number of the last page of a directory when called on its root page
+    [[nodiscard]] std::uint64_t
+    lastPage() const
+    {
+        return std::max(prev, next);
+    }
+};
+
+DirectoryPage
+parseDirectoryPage(ripple::uint256 const& key, data::Blob const& blob)
+{
+    ripple::STLedgerEntry const sle{ripple::SerialIter{blob.data(), blob.size()}, key};
+    auto const& indexes = sle.getFieldV256(ripple::sfIndexes);
+    return {
+        .key = key,
+        .indexes = {indexes.begin(), indexes.end()},
+        .next = sle.getFieldU64(ripple::sfIndexNext),
+        .prev = sle.getFieldU64(ripple::sfIndexPrevious)
+    };
+}
 }  // namespace
 
 /**
@@ -148,6 +188,48 @@ BackendInterface::fetchLedgerObjects(
     return results;
 }
 
+std::vector<std::optional<ripple::LedgerHeader>>
+BackendInterface::fetchLedgersBySequence(
+    std::vector<std::uint32_t> const& sequences,
+    boost::asio::yield_context yield
+) const
+{
+    std::vector<std::optional<ripple::LedgerHeader>> results;
+    results.reserve(sequences.size());
+
+    std::vector<std::uint32_t> misses;
+    std::unordered_set<std::uint32_t> seen;
+    for (auto const seq : sequences) {
+        results.push_back(ledgerHeaderCache_.get(seq));
+        if (not results.back().has_value() and seen.insert(seq).second)
+            misses.push_back(seq);
+    }
+    LOG(gLog.trace()) << "Ledger header cache misses = " << misses.size() << " of " << sequences.size();
+
+    if (misses.empty())
+        return results;
+
+    auto const headers = doFetchLedgersBySequence(misses, yield);
+    ASSERT(headers.size() == misses.size(), "Number of sequences and fetched headers must match");
+
+    std::unordered_map<std::uint32_t, ripple::LedgerHeader const*> fetched;
+    for (std::size_t i = 0; i < misses.size(); ++i) {
+        if (headers[i].has_value()) {
+            ledgerHeaderCache_.put(*headers[i]);
+            fetched.emplace(misses[i], &*headers[i]);
+        }
+    }
+
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        if (results[i].has_value())
+            continue;
+        if (auto const it = fetched.find(sequences[i]); it != fetched.end())
+            results[i] = *it->second;
+    }
+
+    return results;
+}
+
 // Fetches the successor to key/index
 std::optional<ripple::uint256>
 BackendInterface::fetchSuccessorKey(
@@ -191,59 +273,129 @@ BackendInterface::fetchBookOffers(
     boost::asio::yield_context yield
 ) const
 {
-    // TODO try to speed this up. This can take a few seconds. The goal is
-    // to get it down to a few hundred milliseconds.
-    BookOffersPage page;
+    auto getMillis = [](auto diff) { return std::chrono::duration_cast<std::chrono::milliseconds>(diff).count(); };
+    auto const begin = std::chrono::steady_clock::now();
+
+    // when the cache holds this ledger every lookup below is answered from memory, so nothing is read speculatively
+    bool const fromCache = cache_.containsSequence(ledgerSequence);
+
     ripple::uint256 const bookEnd = ripple::getQualityNext(book);
     ripple::uint256 uTipIndex = book;
     std::vector<ripple::uint256> keys;
-    auto getMillis = [](auto diff) { return std::chrono::duration_cast<std::chrono::milliseconds>(diff).count(); };
-    auto begin = std::chrono::system_clock::now();
+    std::unordered_map<ripple::uint256, Blob, ripple::hardened_hash<>> prefetched;
+    bool bookExhausted = false;
     std::uint32_t numSucc = 0;
     std::uint32_t numPages = 0;
-    long succMillis = 0;
-    long pageMillis = 0;
-    while (keys.size() < limit) {
-        auto mid1 = std::chrono::system_clock::now();
-        auto offerDir = fetchSuccessorObject(uTipIndex, ledgerSequence, yield);
-        auto mid2 = std::chrono::system_clock::now();
-        numSucc++;
-        succMillis += getMillis(mid2 - mid1);
-        if (!offerDir || offerDir->key >= bookEnd) {
-            LOG(gLog.trace()) << "offerDir.has_value() " << offerDir.has_value() << " breaking";
-            break;
-        }
-        uTipIndex = offerDir->key;
-        while (keys.size() < limit) {
-            ++numPages;
-            ripple::STLedgerEntry const sle{
-                ripple::SerialIter{offerDir->blob.data(), offerDir->blob.size()}, offerDir->key
-            };
-            auto indexes = sle.getFieldV256(ripple::sfIndexes);
-            keys.insert(keys.end(), indexes.begin(), indexes.end());
-            auto next = sle.getFieldU64(ripple::sfIndexNext);
-            if (next == 0u) {
-                LOG(gLog.trace()) << "Next is empty. breaking";
+    std::int64_t succMillis = 0;
+    std::int64_t pageMillis = 0;
+
+    while (keys.size() < limit and not bookExhausted) {
+        // discover the quality directories of the book until they may hold enough offers to fill the page
+        auto const succStart = std::chrono::steady_clock::now();
+        std::vector<DirectoryPage> rootDirs;
+        std::uint64_t maxOffers = keys.size();
+        while (maxOffers < limit) {
+            auto offerDir = fetchSuccessorObject(uTipIndex, ledgerSequence, yield);
+            ++numSucc;
+            if (!offerDir || offerDir->key >= bookEnd) {
+                LOG(gLog.trace()) << "offerDir.has_value() " << offerDir.has_value() << " breaking";
+                bookExhausted = true;
                 break;
             }
-            auto nextKey = ripple::keylet::page(uTipIndex, next);
-            auto nextDir = fetchLedgerObject(nextKey.key, ledgerSequence, yield);
-            ASSERT(nextDir.has_value(), "Next dir must exist");
-            offerDir->blob = *nextDir;
-            offerDir->key = nextKey.key;
+            uTipIndex = offerDir->key;
+            auto& root = rootDirs.emplace_back(parseDirectoryPage(offerDir->key, offerDir->blob));
+
+            // the root links back to the last page and page numbers only grow, so this is an upper bound
+            maxOffers +=
+                root.indexes.size() + (std::min<std::uint64_t>(root.lastPage(), limit) * ripple::dirNodeMaxEntries);
         }
-        auto mid3 = std::chrono::system_clock::now();
-        pageMillis += getMillis(mid3 - mid2);
+        auto const pageStart = std::chrono::steady_clock::now();
+        succMillis += getMillis(pageStart - succStart);
+
+        if (not fromCache) {
+            // read the pages of all discovered directories and the offers of their root pages in one go
+            std::vector<ripple::uint256> prefetchKeys;
+            std::uint64_t remaining = limit - keys.size();
+            for (auto const& root : rootDirs) {
+                if (remaining == 0)
+                    break;
+
+                auto const numRootOffers = std::min<std::uint64_t>(root.indexes.size(), remaining);
+                auto const rootOffersEnd = std::next(root.indexes.begin(), static_cast<std::ptrdiff_t>(numRootOffers));
+                prefetchKeys.insert(prefetchKeys.end(), root.indexes.begin(), rootOffersEnd);
+                remaining -= numRootOffers;
+
+                auto const numNextPages = std::min<std::uint64_t>(
+                    root.lastPage(), (remaining + ripple::dirNodeMaxEntries - 1) / ripple::dirNodeMaxEntries
+                );
+                for (std::uint64_t page = 1; page <= numNextPages; ++page)
+                    prefetchKeys.push_back(ripple::keylet::page(root.key, page).key);
+                remaining -= std::min<std::uint64_t>(remaining, numNextPages * ripple::dirNodeMaxEntries);
+            }
+
+            auto objs = fetchLedgerObjects(prefetchKeys, ledgerSequence, yield);
+            for (std::size_t i = 0; i < prefetchKeys.size(); ++i) {
+                if (not objs[i].empty())
+                    prefetched.emplace(prefetchKeys[i], std::move(objs[i]));
+            }
+        }
+
+        // follow the pages of each directory in order; pages that were not prefetched are read one by one
+        for (auto const& root : rootDirs) {
+            auto const* dir = &root;
+            DirectoryPage nextDir;
+            while (keys.size() < limit) {
+                ++numPages;
+                keys.insert(keys.end(), dir->indexes.begin(), dir->indexes.end());
+                if (dir->next == 0u) {
+                    LOG(gLog.trace()) << "Next is empty. breaking";
+                    break;
+                }
+
+                auto const nextKey = ripple::keylet::page(root.key, dir->next).key;
+                std::optional<Blob> nextBlob;
+                if (auto const it = prefetched.find(nextKey); it != prefetched.end()) {
+                    nextBlob = std::move(it->second);
+                    prefetched.erase(it);
+                } else {
+                    nextBlob = fetchLedgerObject(nextKey, ledgerSequence, yield);
+                }
+                ASSERT(nextBlob.has_value(), "Next dir must exist");
+                nextDir = parseDirectoryPage(nextKey, *nextBlob);
+                dir = &nextDir;
+            }
+        }
+        pageMillis += getMillis(std::chrono::steady_clock::now() - pageStart);
+    }
+
+    if (keys.size() > limit)
+        keys.resize(limit);
+
+    auto const mid = std::chrono::steady_clock::now();
+    std::vector<ripple::uint256> misses;
+    for (auto const& key : keys) {
+        if (not prefetched.contains(key))
+            misses.push_back(key);
     }
-    auto mid = std::chrono::system_clock::now();
-    auto objs = fetchLedgerObjects(keys, ledgerSequence, yield);
-    for (size_t i = 0; i < keys.size() && i < limit; ++i) {
-        LOG(gLog.trace()) << "Key = " << ripple::strHex(keys[i]) << " blob = " << ripple::strHex(objs[i])
+    auto objs = fetchLedgerObjects(misses, ledgerSequence, yield);
+
+    BookOffersPage page;
+    page.offers.reserve(keys.size());
+    for (std::size_t i = 0, j = 0; i < keys.size(); ++i) {
+        auto const it = prefetched.find(keys[i]);
+        auto const& blob = it != prefetched.end() ? it->second : objs[j++];
+        LOG(gLog.trace()) << "Key = " << ripple::strHex(keys[i]) << " blob = " << ripple::strHex(blob)
                           << " ledgerSequence = " << ledgerSequence;
-        ASSERT(!objs[i].empty(), "Ledger object can't be empty");
-        page.offers.push_back({keys[i], objs[i]});
+        ASSERT(!blob.empty(), "Ledger object can't be empty");
+        page.offers.push_back({keys[i], blob});
     }
-    auto end = std::chrono::system_clock::now();
+    auto const end = std::chrono::steady_clock::now();
+
+    bookOffersSuccessorHistogram_.get().observe(succMillis);
+    bookOffersPageHistogram_.get().observe(pageMillis);
+    bookOffersObjectsHistogram_.get().observe(getMillis(end - mid));
+    bookOffersTotalHistogram_.get().observe(getMillis(end - begin));
+
     LOG(gLog.debug()) << "Fetching " << std::to_string(keys.size()) << " offers took "
                       << std::to_string(getMillis(mid - begin)) << " milliseconds. Fetching next dir took "
                       << std::to_string(succMillis) << " milliseonds. Fetched next dir " << std::to_string(numSucc)
@@ -252,7 +404,7 @@ BackendInterface::fetchBookOffers(
                       << ". num pages = " << std::to_string(numPages) << ". Fetching all objects took "
                       << std::to_string(getMillis(end - mid))
                       << " milliseconds. total time = " << std::to_string(getMillis(end - begin)) << " milliseconds"
-                      << " book = " << ripple::strHex(book);
+                      << " book = " << ripple::strHex(book) << (fromCache ? " (from cache)" : "");
 
     return page;
 }
@@ -314,26 +466,72 @@ BackendInterface::fetchLedgerPage(
     LedgerPage page;
 
     std::vector<ripple::uint256> keys;
+    keys.reserve(limit);
     bool reachedEnd = false;
 
-    while (keys.size() < limit && !reachedEnd) {
-        ripple::uint256 const& curCursor = [&]() {
-            if (!keys.empty())
-                return keys.back();
-            return (cursor ? *cursor : kFIRST_KEY);
-        }();
+    // Objects are fetched in chunks while the successor walk is still in progress. Each chunk is fetched by its own
+    // coroutine so that the round-trips for objects overlap with the (inherently sequential) successor lookups.
+    auto const numChunks = (limit + kLEDGER_PAGE_CHUNK_SIZE - 1) / kLEDGER_PAGE_CHUNK_SIZE;
+    std::vector<std::vector<Blob>> chunks(numChunks);
+    std::vector<std::exception_ptr> chunkErrors(numChunks);
+    util::CoroutineGroup chunkFetchers{yield};
+
+    auto const fetchChunk = [&](std::size_t chunkIndex) {
+        auto const first = chunkIndex * kLEDGER_PAGE_CHUNK_SIZE;
+        auto const last = std::min(first + kLEDGER_PAGE_CHUNK_SIZE, keys.size());
+        std::vector<ripple::uint256> chunkKeys{
+            std::next(keys.begin(), static_cast<std::ptrdiff_t>(first)),
+            std::next(keys.begin(), static_cast<std::ptrdiff_t>(last))
+        };
+
+        chunkFetchers.spawn(yield, [&, chunkIndex, chunkKeys = std::move(chunkKeys)](boost::asio::yield_context yield) {
+            try {
+                chunks[chunkIndex] = fetchLedgerObjects(chunkKeys, ledgerSequence, yield);
+            } catch (...) {
+                chunkErrors[chunkIndex] = std::current_exception();
+            }
+        });
+    };
+
+    try {
+        while (keys.size() < limit && !reachedEnd) {
+            ripple::uint256 const& curCursor = [&]() {
+                if (!keys.empty())
+                    return keys.back();
+                return (cursor ? *cursor : kFIRST_KEY);
+            }();
+
+            std::uint32_t const seq = outOfOrder ? range_->maxSequence : ledgerSequence;
+            auto succ = fetchSuccessorKey(curCursor, seq, yield);
+
+            if (!succ) {
+                reachedEnd = true;
+            } else {
+                keys.push_back(*succ);
+                if (keys.size() % kLEDGER_PAGE_CHUNK_SIZE == 0)
+                    fetchChunk((keys.size() / kLEDGER_PAGE_CHUNK_SIZE) - 1);
+            }
+        }
+    } catch (...) {
+        // chunks in flight reference locals of this function
+        chunkFetchers.asyncWait(yield);
+        throw;
+    }
 
-        std::uint32_t const seq = outOfOrder ? range_->maxSequence : ledgerSequence;
-        auto succ = fetchSuccessorKey(curCursor, seq, yield);
+    if (keys.size() % kLEDGER_PAGE_CHUNK_SIZE != 0)
+        fetchChunk(keys.size() / kLEDGER_PAGE_CHUNK_SIZE);
 
-        if (!succ) {
-            reachedEnd = true;
-        } else {
-            keys.push_back(*succ);
-        }
+    chunkFetchers.asyncWait(yield);
+    for (auto const& error : chunkErrors) {
+        if (error)
+            std::rethrow_exception(error);
     }
 
-    auto objects = fetchLedgerObjects(keys, ledgerSequence, yield);
+    std::vector<Blob> objects;
+    objects.reserve(keys.size());
+    for (auto& chunk : chunks)
+        std::ranges::move(chunk, std::back_inserter(objects));
+
     for (size_t i = 0; i < objects.size(); ++i) {
         if (!objects[i].empty()) {
             page.objects.push_back({keys[i], std::move(objects[i])});
@@ -21,9 +21,13 @@
 
 #include "data/DBHelpers.hpp"
 #include "data/LedgerCache.hpp"
+#include "data/LedgerHeaderCache.hpp"
 #include "data/Types.hpp"
 #include "etl/CorruptionDetector.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Histogram.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 
 #include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/io_context.hpp>
@@ -36,10 +40,12 @@
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <functional>
 #include <optional>
 #include <shared_mutex>
 #include <string>
@@ -142,6 +148,33 @@ protected:
     LedgerCache cache_;
     std::optional<etl::CorruptionDetector<LedgerCache>> corruptionDetector_;
 
+private:
+    static constexpr std::array<std::int64_t, 12> kBOOK_OFFERS_HISTOGRAM_BUCKETS{
+        1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000
+    };
+
+    static util::prometheus::HistogramInt&
+    bookOffersHistogram(std::string stage, std::optional<std::string> description = std::nullopt)
+    {
+        return PrometheusService::histogramInt(
+            "book_offers_duration_milliseconds_histogram",
+            util::prometheus::Labels{{{"stage", std::move(stage)}}},
+            {kBOOK_OFFERS_HISTOGRAM_BUCKETS.begin(), kBOOK_OFFERS_HISTOGRAM_BUCKETS.end()},
+            std::move(description)
+        );
+    }
+
+    // time spent by fetchBookOffers looking up quality directories, walking directory pages and fetching offers
+    std::reference_wrapper<util::prometheus::HistogramInt> bookOffersSuccessorHistogram_{
+        bookOffersHistogram("successor", "The duration of the stages of fetching book offers")
+    };
+    std::reference_wrapper<util::prometheus::HistogramInt> bookOffersPageHistogram_{bookOffersHistogram("page")};
+    std::reference_wrapper<util::prometheus::HistogramInt> bookOffersObjectsHistogram_{bookOffersHistogram("objects")};
+    std::reference_wrapper<util::prometheus::HistogramInt> bookOffersTotalHistogram_{bookOffersHistogram("total")};
+
+    // headers of ledgers fetched by fetchLedgersBySequence, shared by all handlers using this backend
+    LedgerHeaderCache ledgerHeaderCache_;
+
 public:
     BackendInterface() = default;
     virtual ~BackendInterface() = default;
@@ -196,6 +229,19 @@ public:
     virtual std::optional<ripple::LedgerHeader>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context yield) const = 0;
 
+    /**
+     * @brief Fetches the headers of multiple ledgers by sequence number.
+     *
+     * Headers are looked up in an LRU cache first; the remaining distinct sequences are fetched from the database in a
+     * single batch by doFetchLedgersBySequence.
+     *
+     * @param sequences The sequences to fetch; may contain duplicates
+     * @param yield The coroutine context
+     * @return The headers in the same order as the sequences; nullopt for each ledger that was not found
+     */
+    std::vector<std::optional<ripple::LedgerHeader>>
+    fetchLedgersBySequence(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const;
+
     /**
      * @brief Fetches the latest ledger sequence.
      *
@@ -466,6 +512,16 @@ public:
         boost::asio::yield_context yield
     ) const = 0;
 
+    /**
+     * @brief The database-specific implementation for fetching the headers of multiple ledgers.
+     *
+     * @param sequences The distinct sequences to fetch
+     * @param yield The coroutine context
+     * @return The headers in the same order as the sequences; nullopt for each ledger that was not found
+     */
+    virtual std::vector<std::optional<ripple::LedgerHeader>>
+    doFetchLedgersBySequence(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const = 0;
+
     /**
      * @brief Returns the difference between ledgers.
      *
@@ -534,6 +590,10 @@ public:
     /**
      * @brief Fetches book offers.
      *
+     * Quality directories of the book are discovered first; their pages and the offers of their root pages are then
+     * read with a single batch instead of walking every directory page one by one. If the cache holds the requested
+     * ledger everything is served from memory and no speculative reads are made.
+     *
      * @param book Unsigned 256-bit integer.
      * @param ledgerSequence The ledger sequence to fetch for
      * @param limit Pagaing limit as to how many transactions returned per page.
@@ -704,6 +764,18 @@ public:
     virtual bool
     isTooBusy() const = 0;
 
+    /**
+     * @return The recent latency of database reads
+     */
+    virtual std::chrono::microseconds
+    readLatency() const = 0;
+
+    /**
+     * @return The share of the allowed outstanding writes that is in use, from 0 to 1
+     */
+    virtual double
+    writeLoad() const = 0;
+
     /**
      * @return A JSON object containing backend usage statistics
      */
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "data/AccountTxCache.hpp"
 #include "data/BackendInterface.hpp"
 #include "data/DBHelpers.hpp"
 #include "data/Types.hpp"
@@ -30,6 +31,7 @@
 #include "data/cassandra/impl/ExecutionStrategy.hpp"
 #include "util/Assert.hpp"
 #include "util/LedgerUtils.hpp"
+#include "util/Mutex.hpp"
 #include "util/Profiler.hpp"
 #include "util/log/Logger.hpp"
 
@@ -44,6 +46,7 @@
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/nft.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
@@ -76,6 +79,12 @@ class BasicCassandraBackend : public BackendInterface {
 
     std::atomic_uint32_t ledgerSequence_ = 0u;
 
+    // pages of account transactions of recently polled accounts; invalidated by writeAccountTransactions
+    mutable std::optional<AccountTxCache> accountTxCache_;
+
+    // diff rows of the ledger being written, keyed by sequence; written together by doFinishWrites
+    util::Mutex<std::vector<std::pair<std::uint32_t, Statement>>> pendingDiffs_;
+
 protected:
     Handle handle_;
 
@@ -117,6 +126,9 @@ public:
             throw;
         }
 
+        if (auto const maxBytes = settingsProvider_.getSettings().accountTxCacheMaxBytes; maxBytes.has_value())
+            accountTxCache_.emplace(*maxBytes);
+
         LOG(log_.info()) << "Created (revamped) CassandraBackend";
     }
 
@@ -129,63 +141,21 @@ public:
         boost::asio::yield_context yield
     ) const override
     {
-        auto rng = fetchLedgerRange();
+        auto const rng = fetchLedgerRange();
         if (!rng)
             return {.txns = {}, .cursor = {}};
 
-        Statement const statement = [this, forward, &account]() {
-            if (forward)
-                return schema_->selectAccountTxForward.bind(account);
-
-            return schema_->selectAccountTx.bind(account);
-        }();
-
-        auto cursor = cursorIn;
-        if (cursor) {
-            statement.bindAt(1, cursor->asTuple());
-            LOG(log_.debug()) << "account = " << ripple::strHex(account) << " tuple = " << cursor->ledgerSequence
-                              << cursor->transactionIndex;
-        } else {
-            auto const seq = forward ? rng->minSequence : rng->maxSequence;
-            auto const placeHolder = forward ? 0u : std::numeric_limits<std::uint32_t>::max();
-
-            statement.bindAt(1, std::make_tuple(placeHolder, placeHolder));
-            LOG(log_.debug()) << "account = " << ripple::strHex(account) << " idx = " << seq
-                              << " tuple = " << placeHolder;
-        }
-
-        // FIXME: Limit is a hack to support uint32_t properly for the time
-        // being. Should be removed later and schema updated to use proper
-        // types.
-        statement.bindAt(2, Limit{limit});
-        auto const res = executor_.read(yield, statement);
-        auto const& results = res.value();
-        if (not results.hasRows()) {
-            LOG(log_.debug()) << "No rows returned";
-            return {};
-        }
-
-        std::vector<ripple::uint256> hashes = {};
-        auto numRows = results.numRows();
-        LOG(log_.info()) << "num_rows = " << numRows;
-
-        for (auto [hash, data] : extract<ripple::uint256, std::tuple<uint32_t, uint32_t>>(results)) {
-            hashes.push_back(hash);
-            if (--numRows == 0) {
-                LOG(log_.debug()) << "Setting cursor";
-                cursor = data;
-            }
-        }
-
-        auto const txns = fetchTransactions(hashes, yield);
-        LOG(log_.debug()) << "Txns = " << txns.size();
+        if (not accountTxCache_.has_value())
+            return readAccountTransactions(account, limit, forward, cursorIn, *rng, yield);
 
-        if (txns.size() == limit) {
-            LOG(log_.debug()) << "Returning cursor";
-            return {txns, cursor};
-        }
+        auto const cacheKey =
+            AccountTxCache::PageKey{.account = account, .forward = forward, .limit = limit, .cursor = cursorIn};
+        if (auto page = accountTxCache_->get(cacheKey, rng->maxSequence); page.has_value())
+            return *std::move(page);
 
-        return {txns, {}};
+        auto page = readAccountTransactions(account, limit, forward, cursorIn, *rng, yield);
+        accountTxCache_->put(cacheKey, page, rng->maxSequence);
+        return page;
     }
 
     void
@@ -197,6 +167,8 @@ public:
     bool
     doFinishWrites() override
     {
+        auto diffs = std::exchange(*pendingDiffs_.lock(), {});
+        executor_.writePartitioned(std::move(diffs));
         waitForWritesToFinish();
 
         if (!range_) {
@@ -208,6 +180,9 @@ public:
             return false;
         }
 
+        if (accountTxCache_.has_value())
+            accountTxCache_->commit(ledgerSequence_);
+
         LOG(log_.info()) << "Committed ledger " << ledgerSequence_;
         return true;
     }
@@ -325,8 +300,22 @@ public:
     std::vector<TransactionAndMetadata>
     fetchAllTransactionsInLedger(std::uint32_t const ledgerSequence, boost::asio::yield_context yield) const override
     {
-        auto hashes = fetchAllTransactionHashesInLedger(ledgerSequence, yield);
-        return fetchTransactions(hashes, yield);
+        // transactions of one page of hashes are fetched while the next page of hashes is already on its way
+        std::vector<TransactionAndMetadata> txns;
+        executor_.readEachPage(
+            yield,
+            schema_->selectAllTransactionHashesInLedger.bind(ledgerSequence),
+            [this, &txns, yield](auto const& page) {
+                std::vector<ripple::uint256> hashes;
+                hashes.reserve(page.numRows());
+                for (auto [hash] : extract<ripple::uint256>(page))
+                    hashes.push_back(std::move(hash));
+
+                std::ranges::move(fetchTransactions(hashes, yield), std::back_inserter(txns));
+            }
+        );
+
+        return txns;
     }
 
     std::vector<ripple::uint256>
@@ -334,24 +323,23 @@ public:
         const override
     {
         auto start = std::chrono::system_clock::now();
-        auto const res = executor_.read(yield, schema_->selectAllTransactionHashesInLedger, ledgerSequence);
 
-        if (not res) {
-            LOG(log_.error()) << "Could not fetch all transaction hashes: " << res.error();
-            return {};
-        }
+        std::vector<ripple::uint256> hashes;
+        executor_.readEachPage(
+            yield,
+            schema_->selectAllTransactionHashesInLedger.bind(ledgerSequence),
+            [&hashes](auto const& page) {
+                for (auto [hash] : extract<ripple::uint256>(page))
+                    hashes.push_back(std::move(hash));
+            }
+        );
 
-        auto const& result = res.value();
-        if (not result.hasRows()) {
+        if (hashes.empty()) {
             LOG(log_.warn()) << "Could not fetch all transaction hashes - no rows; ledger = "
                              << std::to_string(ledgerSequence);
             return {};
         }
 
-        std::vector<ripple::uint256> hashes;
-        for (auto [hash] : extract<ripple::uint256>(result))
-            hashes.push_back(std::move(hash));
-
         auto end = std::chrono::system_clock::now();
         LOG(log_.debug()) << "Fetched " << hashes.size() << " transaction hashes from database in "
                           << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
@@ -753,6 +741,36 @@ public:
         return results;
     }
 
+    std::vector<std::optional<ripple::LedgerHeader>>
+    doFetchLedgersBySequence(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield)
+        const override
+    {
+        if (sequences.empty())
+            return {};
+
+        std::vector<Statement> statements;
+        statements.reserve(sequences.size());
+        std::ranges::transform(sequences, std::back_inserter(statements), [this](auto const sequence) {
+            return schema_->selectLedgerBySeq.bind(sequence);
+        });
+
+        std::vector<std::optional<ripple::LedgerHeader>> results;
+        results.reserve(sequences.size());
+
+        auto const entries = executor_.readEach(yield, statements);
+        std::ranges::transform(
+            entries, std::back_inserter(results), [](auto const& res) -> std::optional<ripple::LedgerHeader> {
+                if (auto const maybeValue = res.template get<std::vector<unsigned char>>(); maybeValue)
+                    return util::deserializeHeader(ripple::makeSlice(*maybeValue));
+
+                return std::nullopt;
+            }
+        );
+
+        LOG(log_.trace()) << "Fetched " << sequences.size() << " ledger headers";
+        return results;
+    }
+
     std::vector<ripple::uint256>
     fetchAccountRoots(std::uint32_t number, std::uint32_t pageSize, std::uint32_t seq, boost::asio::yield_context yield)
         const override
@@ -800,45 +818,38 @@ public:
     std::vector<LedgerObject>
     fetchLedgerDiff(std::uint32_t const ledgerSequence, boost::asio::yield_context yield) const override
     {
-        auto const [keys, timeDiff] = util::timed([this, &ledgerSequence, yield]() -> std::vector<ripple::uint256> {
-            auto const res = executor_.read(yield, schema_->selectDiff, ledgerSequence);
-            if (not res) {
-                LOG(log_.error()) << "Could not fetch ledger diff: " << res.error() << "; ledger = " << ledgerSequence;
-                return {};
-            }
-
-            auto const& results = res.value();
-            if (not results) {
-                LOG(log_.error()) << "Could not fetch ledger diff - no rows; ledger = " << ledgerSequence;
-                return {};
-            }
-
-            std::vector<ripple::uint256> resultKeys;
-            for (auto [key] : extract<ripple::uint256>(results))
-                resultKeys.push_back(key);
-
-            return resultKeys;
+        // objects of one page of keys are fetched while the next page of keys is already on its way
+        std::vector<LedgerObject> results;
+        auto const timeDiff = util::timed([this, &results, ledgerSequence, yield]() {
+            executor_.readEachPage(
+                yield,
+                schema_->selectDiff.bind(ledgerSequence),
+                [this, &results, ledgerSequence, yield](auto const& page) {
+                    std::vector<ripple::uint256> keys;
+                    keys.reserve(page.numRows());
+                    for (auto [key] : extract<ripple::uint256>(page))
+                        keys.push_back(key);
+
+                    auto const objs = fetchLedgerObjects(keys, ledgerSequence, yield);
+                    std::transform(
+                        std::cbegin(keys),
+                        std::cend(keys),
+                        std::cbegin(objs),
+                        std::back_inserter(results),
+                        [](auto const& key, auto const& obj) { return LedgerObject{key, obj}; }
+                    );
+                }
+            );
         });
 
-        // one of the above errors must have happened
-        if (keys.empty())
+        if (results.empty()) {
+            LOG(log_.error()) << "Could not fetch ledger diff - no rows; ledger = " << ledgerSequence;
             return {};
+        }
 
-        LOG(log_.debug()) << "Fetched " << keys.size() << " diff hashes from database in " << timeDiff
+        LOG(log_.debug()) << "Fetched " << results.size() << " diff objects from database in " << timeDiff
                           << " milliseconds";
 
-        auto const objs = fetchLedgerObjects(keys, ledgerSequence, yield);
-        std::vector<LedgerObject> results;
-        results.reserve(keys.size());
-
-        std::transform(
-            std::cbegin(keys),
-            std::cend(keys),
-            std::cbegin(objs),
-            std::back_inserter(results),
-            [](auto const& key, auto const& obj) { return LedgerObject{key, obj}; }
-        );
-
         return results;
     }
 
@@ -867,8 +878,9 @@ public:
     {
         LOG(log_.trace()) << " Writing ledger object " << key.size() << ":" << seq << " [" << blob.size() << " bytes]";
 
+        // diff is partitioned by ledger sequence; the rows of a ledger are batched when the ledger is finished
         if (range_)
-            executor_.write(schema_->insertDiff, seq, key);
+            pendingDiffs_.lock()->emplace_back(seq, schema_->insertDiff.bind(seq, key));
 
         executor_.write(schema_->insertObject, std::move(key), seq, std::move(blob));
     }
@@ -887,7 +899,11 @@ public:
     void
     writeAccountTransactions(std::vector<AccountTransactionsData> data) override
     {
-        std::vector<Statement> statements;
+        if (accountTxCache_.has_value())
+            accountTxCache_->invalidate(data);
+
+        // account_tx is partitioned by account
+        std::vector<std::pair<ripple::AccountID, Statement>> statements;
         statements.reserve(data.size() * 10);  // assume 10 transactions avg
 
         for (auto& record : data) {
@@ -895,32 +911,37 @@ public:
                 std::begin(record.accounts),
                 std::end(record.accounts),
                 std::back_inserter(statements),
-                [this, &record](auto&& account) {
-                    return schema_->insertAccountTx.bind(
-                        std::forward<decltype(account)>(account),
-                        std::make_tuple(record.ledgerSequence, record.transactionIndex),
-                        record.txHash
+                [this, &record](auto const& account) {
+                    return std::make_pair(
+                        account,
+                        schema_->insertAccountTx.bind(
+                            account, std::make_tuple(record.ledgerSequence, record.transactionIndex), record.txHash
+                        )
                     );
                 }
             );
         }
 
-        executor_.write(std::move(statements));
+        executor_.writePartitioned(std::move(statements));
     }
 
     void
     writeNFTTransactions(std::vector<NFTTransactionsData> const& data) override
     {
-        std::vector<Statement> statements;
+        // nf_token_transactions is partitioned by token
+        std::vector<std::pair<ripple::uint256, Statement>> statements;
         statements.reserve(data.size());
 
         std::transform(std::cbegin(data), std::cend(data), std::back_inserter(statements), [this](auto const& record) {
-            return schema_->insertNFTTx.bind(
-                record.tokenID, std::make_tuple(record.ledgerSequence, record.transactionIndex), record.txHash
+            return std::make_pair(
+                record.tokenID,
+                schema_->insertNFTTx.bind(
+                    record.tokenID, std::make_tuple(record.ledgerSequence, record.transactionIndex), record.txHash
+                )
             );
         });
 
-        executor_.write(std::move(statements));
+        executor_.writePartitioned(std::move(statements));
     }
 
     void
@@ -981,12 +1002,13 @@ public:
     void
     writeMPTHolders(std::vector<MPTHolderData> const& data) override
     {
-        std::vector<Statement> statements;
+        // mp_token_holders is partitioned by token
+        std::vector<std::pair<ripple::uint192, Statement>> statements;
         statements.reserve(data.size());
         for (auto [mptId, holder] : data)
-            statements.push_back(schema_->insertMPTHolder.bind(std::move(mptId), std::move(holder)));
+            statements.emplace_back(mptId, schema_->insertMPTHolder.bind(mptId, std::move(holder)));
 
-        executor_.write(std::move(statements));
+        executor_.writePartitioned(std::move(statements));
     }
 
     void
@@ -1010,6 +1032,18 @@ public:
         return executor_.isTooBusy();
     }
 
+    std::chrono::microseconds
+    readLatency() const override
+    {
+        return executor_.readLatency();
+    }
+
+    double
+    writeLoad() const override
+    {
+        return executor_.writeLoad();
+    }
+
     boost::json::object
     stats() const override
     {
@@ -1017,6 +1051,71 @@ public:
     }
 
 private:
+    TransactionsAndCursor
+    readAccountTransactions(
+        ripple::AccountID const& account,
+        std::uint32_t const limit,
+        bool forward,
+        std::optional<TransactionsCursor> const& cursorIn,
+        LedgerRange const& rng,
+        boost::asio::yield_context yield
+    ) const
+    {
+        Statement const statement = [this, forward, &account]() {
+            if (forward)
+                return schema_->selectAccountTxForward.bind(account);
+
+            return schema_->selectAccountTx.bind(account);
+        }();
+
+        auto cursor = cursorIn;
+        if (cursor) {
+            statement.bindAt(1, cursor->asTuple());
+            LOG(log_.debug()) << "account = " << ripple::strHex(account) << " tuple = " << cursor->ledgerSequence
+                              << cursor->transactionIndex;
+        } else {
+            auto const seq = forward ? rng.minSequence : rng.maxSequence;
+            auto const placeHolder = forward ? 0u : std::numeric_limits<std::uint32_t>::max();
+
+            statement.bindAt(1, std::make_tuple(placeHolder, placeHolder));
+            LOG(log_.debug()) << "account = " << ripple::strHex(account) << " idx = " << seq
+                              << " tuple = " << placeHolder;
+        }
+
+        // FIXME: Limit is a hack to support uint32_t properly for the time
+        // being. Should be removed later and schema updated to use proper
+        // types.
+        statement.bindAt(2, Limit{limit});
+        auto const res = executor_.read(yield, statement);
+        auto const& results = res.value();
+        if (not results.hasRows()) {
+            LOG(log_.debug()) << "No rows returned";
+            return {};
+        }
+
+        std::vector<ripple::uint256> hashes = {};
+        auto numRows = results.numRows();
+        LOG(log_.info()) << "num_rows = " << numRows;
+
+        for (auto [hash, data] : extract<ripple::uint256, std::tuple<uint32_t, uint32_t>>(results)) {
+            hashes.push_back(hash);
+            if (--numRows == 0) {
+                LOG(log_.debug()) << "Setting cursor";
+                cursor = data;
+            }
+        }
+
+        auto const txns = fetchTransactions(hashes, yield);
+        LOG(log_.debug()) << "Txns = " << txns.size();
+
+        if (txns.size() == limit) {
+            LOG(log_.debug()) << "Returning cursor";
+            return {txns, cursor};
+        }
+
+        return {txns, {}};
+    }
+
     bool
     executeSyncUpdate(Statement statement)
     {
@@ -19,24 +19,65 @@
 
 #include "data/LedgerCache.hpp"
 
+#include "data/DBHelpers.hpp"
+#include "data/OrderBookIndex.hpp"
 #include "data/Types.hpp"
 #include "util/Assert.hpp"
 
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace data {
 
+namespace {
+
+// the offers and book directories of a ledger, copied out of the cache to build the order book index
+using OrderBookSnapshot = std::unordered_map<ripple::uint256, Blob, ripple::hardened_hash<>>;
+
+bool
+isOrderBookObject(Blob const& blob)
+{
+    return blob.size() > 2 and (isOffer(blob) or isDirNode(blob));
+}
+
+void
+applyToSnapshot(OrderBookSnapshot& snapshot, std::vector<LedgerObject> const& objs)
+{
+    for (auto const& obj : objs) {
+        if (isOrderBookObject(obj.blob)) {
+            snapshot.insert_or_assign(obj.key, obj.blob);
+        } else {
+            snapshot.erase(obj.key);
+        }
+    }
+}
+
+std::vector<ripple::uint256>
+diffKeys(std::vector<LedgerObject> const& objs)
+{
+    std::vector<ripple::uint256> keys;
+    keys.reserve(objs.size());
+    for (auto const& obj : objs)
+        keys.push_back(obj.key);
+    return keys;
+}
+
+}  // namespace
+
 uint32_t
 LedgerCache::latestLedgerSequence() const
 {
-    std::shared_lock const lck{mtx_};
     return latestSeq_;
 }
 
@@ -46,7 +87,7 @@ LedgerCache::waitUntilCacheContainsSeq(uint32_t seq)
     if (disabled_)
         return;
 
-    std::unique_lock lock(mtx_);
+    std::unique_lock lock(seqMtx_);
     cv_.wait(lock, [this, seq] { return latestSeq_ >= seq; });
     return;
 }
@@ -57,34 +98,83 @@ LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool is
     if (disabled_)
         return;
 
-    {
-        std::scoped_lock const lck{mtx_};
-        if (seq > latestSeq_) {
-            ASSERT(
-                seq == latestSeq_ + 1 || latestSeq_ == 0,
-                "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
-                seq,
-                latestSeq_
-            );
-            latestSeq_ = seq;
-        }
-        for (auto const& obj : objs) {
-            if (!obj.blob.empty()) {
-                if (isBackground && deletes_.contains(obj.key))
+    std::array<std::vector<LedgerObject const*>, kNUM_SHARDS> perShard;
+    for (auto const& obj : objs)
+        perShard[shardIndex(obj.key)].push_back(&obj);
+
+    auto const applyToShard = [&](Shard& shard, std::vector<LedgerObject const*> const& shardObjs) {
+        for (auto const* obj : shardObjs) {
+            if (!obj->blob.empty()) {
+                if (isBackground && shard.deletes.contains(obj->key))
                     continue;
 
-                auto& e = map_[obj.key];
+                auto& e = shard.map[obj->key];
                 if (seq > e.seq) {
-                    e = {.seq = seq, .blob = obj.blob};
+                    e = {.seq = seq, .blob = obj->blob};
                 }
             } else {
-                map_.erase(obj.key);
+                shard.map.erase(obj->key);
                 if (!full_ && !isBackground)
-                    deletes_.insert(obj.key);
+                    shard.deletes.insert(obj->key);
             }
         }
-        cv_.notify_all();
+    };
+
+    if (isBackground) {
+        // old data written by the loader; no need for the update to be seen atomically across shards
+        for (std::size_t i = 0; i < kNUM_SHARDS; ++i) {
+            if (perShard[i].empty())
+                continue;
+
+            std::scoped_lock const lck{shards_[i].mtx};
+            applyToShard(shards_[i], perShard[i]);
+        }
+        advanceLatestSequence(seq);
+        return;
+    }
+
+    // a new ledger must become visible at once so that successor lookups never observe a half applied diff
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    locks.reserve(kNUM_SHARDS);
+    for (auto& shard : shards_)
+        locks.emplace_back(shard.mtx);
+
+    auto const numRetained = numRetainedLedgers_.load();
+    auto const retainHistory = full_ and numRetained > 0 and seq > latestSeq_;
+
+    for (std::size_t i = 0; i < kNUM_SHARDS; ++i) {
+        auto& shard = shards_[i];
+        if (not retainHistory) {
+            applyToShard(shard, perShard[i]);
+            continue;
+        }
+
+        std::vector<ripple::uint256> keys;
+        keys.reserve(perShard[i].size());
+        for (auto const* obj : perShard[i]) {
+            recordVersion(shard, obj->key, seq);
+            keys.push_back(obj->key);
+        }
+        applyToShard(shard, perShard[i]);
+
+        for (auto const* obj : perShard[i]) {
+            if (obj->blob.empty())
+                recordDeletion(shard, obj->key, seq);
+        }
+
+        if (not keys.empty())
+            shard.touched.emplace_back(seq, std::move(keys));
+
+        if (seq > numRetained)
+            pruneHistory(shard, seq - numRetained);
     }
+
+    advanceLatestSequence(seq);
+    locks.clear();
+
+    // parsing the changed offers can take a while, so it is done once readers can use the shards again
+    if (orderBookIndexEnabled_ and full_)
+        updateOrderBookIndex(objs, seq);
 }
 
 std::optional<LedgerObject>
@@ -93,15 +183,32 @@ LedgerCache::getSuccessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
     ++successorReqCounter_.get();
-    if (seq != latestSeq_)
-        return {};
-    auto e = map_.upper_bound(key);
-    if (e == map_.end())
-        return {};
-    ++successorHitCounter_.get();
-    return {{.key = e->first, .blob = e->second.blob}};
+
+    for (auto i = shardIndex(key); i < kNUM_SHARDS; ++i) {
+        auto const& shard = shards_[i];
+        std::shared_lock const lck{shard.mtx};
+
+        // checked under every shard lock as a new ledger may have been applied while moving between shards
+        if (seq == latestSeq_) {
+            auto const* e = shard.map.upperBound(key);
+            if (e == nullptr)
+                continue;
+
+            ++successorHitCounter_.get();
+            return {{.key = e->first, .blob = e->second.blob}};
+        }
+
+        if (not isInRetainedWindow(seq))
+            return {};
+
+        if (auto succ = shard.successorAt(key, seq); succ.has_value()) {
+            ++successorHitCounter_.get();
+            return succ;
+        }
+    }
+
+    return {};
 }
 
 std::optional<LedgerObject>
@@ -110,14 +217,26 @@ LedgerCache::getPredecessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
-    if (seq != latestSeq_)
-        return {};
-    auto e = map_.lower_bound(key);
-    if (e == map_.begin())
-        return {};
-    --e;
-    return {{.key = e->first, .blob = e->second.blob}};
+    for (auto i = shardIndex(key) + 1; i-- > 0;) {
+        auto const& shard = shards_[i];
+        std::shared_lock const lck{shard.mtx};
+
+        if (seq == latestSeq_) {
+            auto const* e = shard.map.lowerNeighbour(key);
+            if (e == nullptr)
+                continue;
+
+            return {{.key = e->first, .blob = e->second.blob}};
+        }
+
+        if (not isInRetainedWindow(seq))
+            return {};
+
+        if (auto pred = shard.predecessorAt(key, seq); pred.has_value())
+            return pred;
+    }
+
+    return {};
 }
 
 std::optional<Blob>
@@ -126,23 +245,55 @@ LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_)
         return {};
 
-    std::shared_lock const lck{mtx_};
+    auto const& shard = shards_[shardIndex(key)];
+    std::shared_lock const lck{shard.mtx};
     if (seq > latestSeq_)
         return {};
     ++objectReqCounter_.get();
-    auto e = map_.find(key);
-    if (e == map_.end())
+    auto const* e = shard.map.find(key);
+    if (e != nullptr and seq >= e->seq) {
+        ++objectHitCounter_.get();
+        return {e->blob};
+    }
+
+    if (not isInRetainedWindow(seq))
         return {};
-    if (seq < e->second.seq)
+
+    ++historyReqCounter_.get();
+    auto const* blob = shard.blobAt(key, seq);
+    if (blob == nullptr)
         return {};
+    ++historyHitCounter_.get();
     ++objectHitCounter_.get();
-    return {e->second.blob};
+    return {*blob};
+}
+
+void
+LedgerCache::setOrderBookIndexEnabled(bool enabled)
+{
+    orderBookIndexEnabled_ = enabled;
+}
+
+std::optional<std::vector<BookOfferPtr>>
+LedgerCache::getBookOffers(ripple::uint256 const& book, uint32_t seq, uint32_t limit) const
+{
+    if (disabled_ or not orderBookIndexEnabled_)
+        return std::nullopt;
+
+    return orderBooks_.getOffers(book, seq, limit);
+}
+
+void
+LedgerCache::setNumRetainedLedgers(uint32_t numLedgers)
+{
+    numRetainedLedgers_ = numLedgers;
 }
 
 void
 LedgerCache::setDisabled()
 {
     disabled_ = true;
+    orderBooks_.clear();
 }
 
 bool
@@ -157,9 +308,15 @@ LedgerCache::setFull()
     if (disabled_)
         return;
 
+    fullSeq_ = latestSeq_.load();
     full_ = true;
-    std::scoped_lock const lck{mtx_};
-    deletes_.clear();
+    for (auto& shard : shards_) {
+        std::scoped_lock const lck{shard.mtx};
+        shard.deletes.clear();
+    }
+
+    if (orderBookIndexEnabled_)
+        buildOrderBookIndex();
 }
 
 bool
@@ -168,11 +325,23 @@ LedgerCache::isFull() const
     return full_;
 }
 
+bool
+LedgerCache::containsSequence(uint32_t seq) const
+{
+    if (disabled_ or not full_)
+        return false;
+    return seq == latestSeq_ or isInRetainedWindow(seq);
+}
+
 size_t
 LedgerCache::size() const
 {
-    std::shared_lock const lck{mtx_};
-    return map_.size();
+    size_t total = 0;
+    for (auto const& shard : shards_) {
+        std::shared_lock const lck{shard.mtx};
+        total += shard.map.size();
+    }
+    return total;
 }
 
 float
@@ -191,4 +360,241 @@ LedgerCache::getSuccessorHitRate() const
     return static_cast<float>(successorHitCounter_.get().value()) / successorReqCounter_.get().value();
 }
 
+std::size_t
+LedgerCache::shardIndex(ripple::uint256 const& key)
+{
+    // keys compare as big endian byte strings so the first byte preserves the global order across shards
+    static_assert(kNUM_SHARDS == 256, "Shards are selected by exactly one byte of the key");
+    return *key.cbegin();
+}
+
+void
+LedgerCache::advanceLatestSequence(uint32_t seq)
+{
+    std::scoped_lock const lck{seqMtx_};
+    if (seq > latestSeq_) {
+        ASSERT(
+            seq == latestSeq_ + 1 || latestSeq_ == 0,
+            "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
+            seq,
+            latestSeq_.load()
+        );
+        latestSeq_ = seq;
+    }
+    cv_.notify_all();
+}
+
+void
+LedgerCache::buildOrderBookIndex()
+{
+    uint32_t seq = 0;
+    {
+        auto pending = pendingOrderBookDiffs_.lock();
+        pending->emplace();
+
+        // ledgers up to seq are fully applied to the shards; the ones applied from now on are buffered for the build
+        seq = latestSeq_;
+    }
+
+    // copy the offers and book directories one shard at a time so that readers and writers are never blocked for long
+    OrderBookSnapshot snapshot;
+    for (auto const& shard : shards_) {
+        std::shared_lock const lck{shard.mtx};
+        shard.map.forEach([&snapshot](ripple::uint256 const& key, CacheEntry const& entry) {
+            if (isOrderBookObject(entry.blob))
+                snapshot.emplace(key, entry.blob);
+        });
+    }
+
+    // a ledger applied during the copy may be only partly in it; replaying the buffered ledgers fixes that
+    auto const copiedDiffs = std::exchange(**pendingOrderBookDiffs_.lock(), {});
+    for (auto const& diff : copiedDiffs) {
+        applyToSnapshot(snapshot, diff.objs);
+        seq = diff.seq;
+    }
+
+    auto const lookup = [&snapshot](ripple::uint256 const& key) -> Blob const* {
+        auto const it = snapshot.find(key);
+        return it != snapshot.end() ? &it->second : nullptr;
+    };
+
+    std::vector<ripple::uint256> keys;
+    keys.reserve(snapshot.size());
+    for (auto const& [key, _] : snapshot)
+        keys.push_back(key);
+
+    orderBooks_.rebuild(keys, seq, lookup);
+
+    // catch up with the ledgers applied while parsing; once there are none left, writers update the index themselves
+    while (true) {
+        std::vector<LedgerDiff> diffs;
+        {
+            auto pending = pendingOrderBookDiffs_.lock();
+            if (disabled_) {
+                pending->reset();
+                orderBooks_.clear();
+                return;
+            }
+
+            if ((*pending)->empty()) {
+                pending->reset();
+                return;
+            }
+
+            diffs = std::exchange(**pending, {});
+        }
+
+        for (auto const& diff : diffs) {
+            applyToSnapshot(snapshot, diff.objs);
+            orderBooks_.update(diffKeys(diff.objs), diff.seq, lookup);
+        }
+    }
+}
+
+void
+LedgerCache::updateOrderBookIndex(std::vector<LedgerObject> const& objs, uint32_t seq)
+{
+    // held while updating so that a build can't start in between and miss this ledger
+    auto pending = pendingOrderBookDiffs_.lock();
+    if (pending->has_value()) {
+        (*pending)->push_back({.seq = seq, .objs = objs});
+        return;
+    }
+
+    // ledgers are applied one at a time, so the shards hold the objects of this ledger until it returns. The blobs are
+    // copied as the index looks them up after the shard lock is released
+    OrderBookSnapshot blobs;
+    orderBooks_.update(diffKeys(objs), seq, [this, &blobs](ripple::uint256 const& key) -> Blob const* {
+        auto const& shard = shards_[shardIndex(key)];
+        std::shared_lock const lck{shard.mtx};
+        auto const* e = shard.map.find(key);
+        return e != nullptr ? &blobs.insert_or_assign(key, e->blob).first->second : nullptr;
+    });
+}
+
+bool
+LedgerCache::isInRetainedWindow(uint32_t seq) const
+{
+    auto const latest = latestSeq_.load();
+    return full_ and seq < latest and seq + numRetainedLedgers_ >= latest and seq >= fullSeq_;
+}
+
+void
+LedgerCache::recordVersion(Shard& shard, ripple::uint256 const& key, uint32_t seq)
+{
+    auto& versions = shard.history[key];
+    if (auto const* e = shard.map.find(key); e != nullptr) {
+        if (e->seq < seq)
+            addVersion(versions, {.seq = e->seq, .blob = e->blob});
+    } else if (versions.empty()) {
+        // the object is created in this ledger; it did not exist before
+        addVersion(versions, {.seq = 0, .blob = {}});
+    }
+}
+
+void
+LedgerCache::recordDeletion(Shard& shard, ripple::uint256 const& key, uint32_t seq)
+{
+    addVersion(shard.history[key], {.seq = seq, .blob = {}});
+}
+
+void
+LedgerCache::addVersion(std::vector<Version>& versions, Version version)
+{
+    ++historyVersionsGauge_.get();
+    historyBytesGauge_.get() += static_cast<int64_t>(sizeof(Version) + version.blob.size());
+    versions.push_back(std::move(version));
+}
+
+void
+LedgerCache::pruneHistory(Shard& shard, uint32_t minSeq)
+{
+    // versions replaced at or before minSeq can't be the answer for any sequence in the window anymore
+    while (not shard.touched.empty() and shard.touched.front().first <= minSeq) {
+        auto const [replacedAt, keys] = std::move(shard.touched.front());
+        shard.touched.pop_front();
+
+        for (auto const& key : keys) {
+            auto* versions = shard.history.find(key);
+            if (versions == nullptr)
+                continue;
+
+            auto const obsolete =
+                std::ranges::find_if(*versions, [&](Version const& v) { return v.seq >= replacedAt; });
+            std::for_each(versions->begin(), obsolete, [this](Version const& v) {
+                --historyVersionsGauge_.get();
+                historyBytesGauge_.get() -= static_cast<int64_t>(sizeof(Version) + v.blob.size());
+            });
+            versions->erase(versions->begin(), obsolete);
+
+            auto const* current = shard.map.find(key);
+            auto const onlyDeletion =
+                versions->size() == 1 and versions->front().blob.empty() and versions->front().seq <= minSeq;
+            auto const currentCoversWindow = current != nullptr and current->seq <= minSeq;
+
+            if (versions->empty() or (onlyDeletion and current == nullptr) or currentCoversWindow) {
+                std::ranges::for_each(*versions, [this](Version const& v) {
+                    --historyVersionsGauge_.get();
+                    historyBytesGauge_.get() -= static_cast<int64_t>(sizeof(Version) + v.blob.size());
+                });
+                shard.history.erase(key);
+            }
+        }
+    }
+}
+
+Blob const*
+LedgerCache::Shard::blobAt(ripple::uint256 const& key, uint32_t seq) const
+{
+    if (auto const* e = map.find(key); e != nullptr and e->seq <= seq)
+        return &e->blob;
+
+    auto const* versions = history.find(key);
+    if (versions == nullptr)
+        return nullptr;
+
+    auto const version = std::find_if(versions->rbegin(), versions->rend(), [seq](Version const& v) {
+        return v.seq <= seq;
+    });
+    if (version == versions->rend() or version->blob.empty())
+        return nullptr;
+
+    return &version->blob;
+}
+
+std::optional<LedgerObject>
+LedgerCache::Shard::successorAt(ripple::uint256 const& key, uint32_t seq) const
+{
+    // objects created after seq are skipped and objects deleted since are found in the history
+    auto cursor = key;
+    while (true) {
+        auto const* current = map.upperBound(cursor);
+        auto const* previous = history.upperBound(cursor);
+        if (current == nullptr and previous == nullptr)
+            return std::nullopt;
+
+        cursor = (previous == nullptr or (current != nullptr and current->first < previous->first)) ? current->first
+                                                                                                    : previous->first;
+        if (auto const* blob = blobAt(cursor, seq); blob != nullptr)
+            return LedgerObject{.key = cursor, .blob = *blob};
+    }
+}
+
+std::optional<LedgerObject>
+LedgerCache::Shard::predecessorAt(ripple::uint256 const& key, uint32_t seq) const
+{
+    auto cursor = key;
+    while (true) {
+        auto const* current = map.lowerNeighbour(cursor);
+        auto const* previous = history.lowerNeighbour(cursor);
+        if (current == nullptr and previous == nullptr)
+            return std::nullopt;
+
+        cursor = (previous == nullptr or (current != nullptr and previous->first < current->first)) ? current->first
+                                                                                                    : previous->first;
+        if (auto const* blob = blobAt(cursor, seq); blob != nullptr)
+            return LedgerObject{.key = cursor, .blob = *blob};
+    }
+}
+
 }  // namespace data
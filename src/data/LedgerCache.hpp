@@ -19,29 +19,43 @@
 
 #pragma once
 
+#include "data/OrderBookIndex.hpp"
 #include "data/Types.hpp"
+#include "data/impl/PagedOrderedMap.hpp"
+#include "util/Mutex.hpp"
 #include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/basics/hardened_hash.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
-#include <map>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace data {
 
 /**
  * @brief Cache for an entire ledger.
+ *
+ * Objects are spread over a fixed number of shards by the most significant byte of their key. Each shard keeps its
+ * objects in a paged ordered map guarded by its own lock, so lookups on different keys don't contend with each other
+ * while iterating the shards in order still gives the global key order needed for successor and predecessor lookups.
+ *
+ * Optionally the cache retains the versions replaced during the last few ledgers (see @ref setNumRetainedLedgers) so
+ * that lookups for a sequence slightly behind the latest one are also served from memory.
  */
 class LedgerCache {
     struct CacheEntry {
@@ -49,6 +63,44 @@ class LedgerCache {
         Blob blob;
     };
 
+    static constexpr std::size_t kNUM_SHARDS = 256;
+    static constexpr std::size_t kCACHE_LINE_SIZE = 64;
+
+    // a previous version of an object, valid from seq until the seq of the next version. empty blob means deleted
+    struct Version {
+        uint32_t seq = 0;
+        Blob blob;
+    };
+
+    struct alignas(kCACHE_LINE_SIZE) Shard {
+        mutable std::shared_mutex mtx;
+        impl::PagedOrderedMap<ripple::uint256, CacheEntry> map;
+
+        // temporary set to prevent background thread from writing already deleted data. not used when cache is full
+        std::unordered_set<ripple::uint256, ripple::hardened_hash<>> deletes;
+
+        // versions replaced within the retained window, oldest first; includes objects deleted since
+        impl::PagedOrderedMap<ripple::uint256, std::vector<Version>> history;
+
+        // keys that got a new version in each retained ledger, oldest ledger first; used to prune the history
+        std::deque<std::pair<uint32_t, std::vector<ripple::uint256>>> touched;
+
+        Blob const*
+        blobAt(ripple::uint256 const& key, uint32_t seq) const;
+
+        std::optional<LedgerObject>
+        successorAt(ripple::uint256 const& key, uint32_t seq) const;
+
+        std::optional<LedgerObject>
+        predecessorAt(ripple::uint256 const& key, uint32_t seq) const;
+    };
+
+    // the objects changed by a ledger
+    struct LedgerDiff {
+        uint32_t seq = 0;
+        std::vector<LedgerObject> objs;
+    };
+
     // counters for fetchLedgerObject(s) hit rate
     std::reference_wrapper<util::prometheus::CounterInt> objectReqCounter_{PrometheusService::counterInt(
         "ledger_cache_counter_total_number",
@@ -71,16 +123,45 @@ class LedgerCache {
         util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "successor_key"}})
     )};
 
-    std::map<ripple::uint256, CacheEntry> map_;
+    // counters for lookups of sequences older than the latest one
+    std::reference_wrapper<util::prometheus::CounterInt> historyReqCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}, {"fetch", "history"}})
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> historyHitCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "history"}})
+    )};
+
+    // memory held by the retained versions
+    std::reference_wrapper<util::prometheus::GaugeInt> historyVersionsGauge_{PrometheusService::gaugeInt(
+        "ledger_cache_history_total_number",
+        util::prometheus::Labels{{{"type", "versions"}}},
+        "Number of previous object versions and bytes retained by LedgerCache"
+    )};
+    std::reference_wrapper<util::prometheus::GaugeInt> historyBytesGauge_{PrometheusService::gaugeInt(
+        "ledger_cache_history_total_number",
+        util::prometheus::Labels{{{"type", "bytes"}}}
+    )};
+
+    std::array<Shard, kNUM_SHARDS> shards_;
 
-    mutable std::shared_mutex mtx_;
-    std::condition_variable_any cv_;
-    uint32_t latestSeq_ = 0;
+    // latestSeq_ is only advanced while all shards affected by the update are locked exclusively
+    std::atomic_uint32_t latestSeq_ = 0;
+    std::mutex seqMtx_;
+    std::condition_variable cv_;
     std::atomic_bool full_ = false;
     std::atomic_bool disabled_ = false;
 
-    // temporary set to prevent background thread from writing already deleted data. not used when cache is full
-    std::unordered_set<ripple::uint256, ripple::hardened_hash<>> deletes_;
+    std::atomic_bool orderBookIndexEnabled_ = false;
+    OrderBookIndex orderBooks_;
+
+    // set while the order book index is being built; ledgers applied meanwhile are replayed by the build
+    util::Mutex<std::optional<std::vector<LedgerDiff>>> pendingOrderBookDiffs_;
+
+    std::atomic_uint32_t numRetainedLedgers_ = 0;
+    // history is only complete for sequences from the one the cache became full at
+    std::atomic_uint32_t fullSeq_ = 0;
 
 public:
     /**
@@ -127,6 +208,41 @@ public:
     std::optional<LedgerObject>
     getPredecessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Sets how many ledgers before the latest one can be served from the cache.
+     *
+     * Versions of objects replaced or deleted during that many most recent ledgers are retained, so that
+     * @ref get, @ref getSuccessor and @ref getPredecessor can answer for any sequence in the window. Zero (the
+     * default) only retains the latest version of each object. Should be set before the cache is populated.
+     *
+     * @param numLedgers The number of previous ledgers to retain
+     */
+    void
+    setNumRetainedLedgers(uint32_t numLedgers);
+
+    /**
+     * @brief Sets whether an index of all order books is maintained together with the cache.
+     *
+     * The index is built once the cache becomes full and then follows every new ledger, allowing
+     * @ref getBookOffers to answer without parsing ledger entries. Should be set before the cache is populated.
+     *
+     * @param enabled Whether the order book index should be maintained
+     */
+    void
+    setOrderBookIndexEnabled(bool enabled);
+
+    /**
+     * @brief Get the best offers of a book from the order book index.
+     *
+     * @param book The book base as returned by ripple::getBookBase
+     * @param seq The ledger sequence to get the offers for
+     * @param limit The maximum number of offers to return
+     * @return The offers ordered by quality; nullopt if the index is disabled, not built yet or the sequence is not
+     * the latest one
+     */
+    std::optional<std::vector<BookOfferPtr>>
+    getBookOffers(ripple::uint256 const& book, uint32_t seq, uint32_t limit) const;
+
     /**
      * @brief Disables the cache.
      */
@@ -161,6 +277,15 @@ public:
     bool
     isFull() const;
 
+    /**
+     * @brief Check whether every object and successor of the given ledger can be served from the cache.
+     *
+     * @param seq The ledger sequence to check
+     * @return true if the cache is full and holds the latest ledger or a retained older one; false otherwise
+     */
+    bool
+    containsSequence(uint32_t seq) const;
+
     /**
      * @return The total size of the cache.
      */
@@ -186,6 +311,34 @@ public:
      */
     void
     waitUntilCacheContainsSeq(uint32_t seq);
+
+private:
+    static std::size_t
+    shardIndex(ripple::uint256 const& key);
+
+    void
+    advanceLatestSequence(uint32_t seq);
+
+    void
+    buildOrderBookIndex();
+
+    void
+    updateOrderBookIndex(std::vector<LedgerObject> const& objs, uint32_t seq);
+
+    bool
+    isInRetainedWindow(uint32_t seq) const;
+
+    void
+    recordVersion(Shard& shard, ripple::uint256 const& key, uint32_t seq);
+
+    void
+    recordDeletion(Shard& shard, ripple::uint256 const& key, uint32_t seq);
+
+    void
+    addVersion(std::vector<Version>& versions, Version version);
+
+    void
+    pruneHistory(Shard& shard, uint32_t minSeq);
 };
 
 }  // namespace data
@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.hpp"
+
+#include "util/Assert.hpp"
+
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace data {
+
+LedgerHeaderCache::LedgerHeaderCache(std::size_t capacity) : capacity_(capacity)
+{
+    ASSERT(capacity_ > 0, "Ledger header cache capacity must be positive");
+}
+
+std::optional<ripple::LedgerHeader>
+LedgerHeaderCache::get(std::uint32_t sequence) const
+{
+    std::scoped_lock const lck{mtx_};
+
+    auto const it = index_.find(sequence);
+    if (it == index_.end())
+        return std::nullopt;
+
+    headers_.splice(headers_.begin(), headers_, it->second);
+    return *it->second;
+}
+
+void
+LedgerHeaderCache::put(ripple::LedgerHeader const& header)
+{
+    std::scoped_lock const lck{mtx_};
+
+    if (auto const it = index_.find(header.seq); it != index_.end()) {
+        *it->second = header;
+        headers_.splice(headers_.begin(), headers_, it->second);
+        return;
+    }
+
+    if (headers_.size() == capacity_) {
+        index_.erase(headers_.back().seq);
+        headers_.pop_back();
+    }
+
+    headers_.push_front(header);
+    index_.emplace(header.seq, headers_.begin());
+}
+
+std::size_t
+LedgerHeaderCache::size() const
+{
+    std::scoped_lock const lck{mtx_};
+    return headers_.size();
+}
+
+}  // namespace data
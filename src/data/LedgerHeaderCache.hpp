@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace data {
+
+/**
+ * @brief A thread-safe LRU cache of ledger headers keyed by ledger sequence.
+ *
+ * Headers of validated ledgers never change once written, so entries never need to be invalidated; the least recently
+ * used header is evicted when the cache is full.
+ */
+class LedgerHeaderCache {
+    std::size_t capacity_;
+
+    mutable std::mutex mtx_;
+    // most recently used header first
+    mutable std::list<ripple::LedgerHeader> headers_;
+    std::unordered_map<std::uint32_t, std::list<ripple::LedgerHeader>::iterator> index_;
+
+public:
+    static constexpr std::size_t kDEFAULT_CAPACITY = 4096;
+
+    /**
+     * @brief Construct a new LedgerHeaderCache
+     *
+     * @param capacity The maximum number of headers to keep
+     */
+    explicit LedgerHeaderCache(std::size_t capacity = kDEFAULT_CAPACITY);
+
+    /**
+     * @brief Get the header of the ledger with the given sequence and mark it as recently used
+     *
+     * @param sequence The ledger sequence
+     * @return The header if cached; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<ripple::LedgerHeader>
+    get(std::uint32_t sequence) const;
+
+    /**
+     * @brief Put a header into the cache, evicting the least recently used one if the cache is full
+     *
+     * @param header The header to store
+     */
+    void
+    put(ripple::LedgerHeader const& header);
+
+    /**
+     * @return The number of cached headers
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+};
+
+}  // namespace data
@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/OrderBookIndex.hpp"
+
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+#include "util/log/Logger.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+#include <xrpl/basics/strHex.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/LedgerFormats.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+namespace {
+
+util::Logger gLog{"Backend"};
+
+// the smallest blob that can hold the ledger entry type checked by isOffer and isDirNode
+constexpr std::size_t kMIN_OBJECT_SIZE = 3;
+
+}  // namespace
+
+BookOffer::BookOffer(ripple::uint256 const& offerKey, Blob const& blob)
+    : key{offerKey}
+    , sle{ripple::SerialIter{blob.data(), blob.size()}, offerKey}
+    , bookDirectory{sle.getFieldH256(ripple::sfBookDirectory)}
+    , owner{sle.getAccountID(ripple::sfAccount)}
+    , takerGets{sle.getFieldAmount(ripple::sfTakerGets)}
+    , takerPays{sle.getFieldAmount(ripple::sfTakerPays)}
+{
+}
+
+void
+OrderBookIndex::rebuild(std::vector<ripple::uint256> const& keys, uint32_t seq, LookupType const& lookup)
+{
+    // parsed without holding the lock so that readers are not blocked meanwhile
+    OrderBookIndex built;
+    std::unordered_set<ripple::uint256, ripple::hardened_hash<>> qualities;
+    built.apply(keys, lookup, qualities);
+    for (auto const& quality : qualities)
+        built.rebuildQuality(quality, lookup);
+
+    std::unique_lock const lck{mtx_};
+
+    books_ = std::move(built.books_);
+    offers_ = std::move(built.offers_);
+    pageRoots_ = std::move(built.pageRoots_);
+    seq_ = seq;
+    ready_ = true;
+
+    LOG(gLog.info()) << "Order book index built for ledger " << seq << ". books = " << books_.size()
+                     << ", offers = " << offers_.size();
+}
+
+void
+OrderBookIndex::update(std::vector<ripple::uint256> const& keys, uint32_t seq, LookupType const& lookup)
+{
+    std::unique_lock const lck{mtx_};
+    if (not ready_)
+        return;
+
+    // a ledger applied while the index was being built was missed; it must be built again
+    if (seq != seq_ + 1) {
+        LOG(gLog.warn()) << "Order book index at ledger " << seq_ << " can't be updated to ledger " << seq;
+        ready_ = false;
+        books_.clear();
+        offers_.clear();
+        pageRoots_.clear();
+        return;
+    }
+
+    std::unordered_set<ripple::uint256, ripple::hardened_hash<>> dirtyQualities;
+    apply(keys, lookup, dirtyQualities);
+    for (auto const& quality : dirtyQualities)
+        rebuildQuality(quality, lookup);
+
+    seq_ = seq;
+}
+
+void
+OrderBookIndex::clear()
+{
+    std::unique_lock const lck{mtx_};
+
+    ready_ = false;
+    books_.clear();
+    offers_.clear();
+    pageRoots_.clear();
+}
+
+bool
+OrderBookIndex::isReady() const
+{
+    std::shared_lock const lck{mtx_};
+    return ready_;
+}
+
+std::optional<std::vector<BookOfferPtr>>
+OrderBookIndex::getOffers(ripple::uint256 const& book, uint32_t seq, uint32_t limit) const
+{
+    std::shared_lock const lck{mtx_};
+    if (not ready_ or seq != seq_)
+        return std::nullopt;
+
+    std::vector<BookOfferPtr> result;
+    auto const it = books_.find(book);
+    if (it == books_.end())
+        return result;
+
+    for (auto const& [_, offers] : it->second) {
+        auto const count = std::min<std::size_t>(offers.size(), limit - result.size());
+        result.insert(result.end(), offers.begin(), offers.begin() + static_cast<std::ptrdiff_t>(count));
+        if (result.size() == limit)
+            break;
+    }
+
+    return result;
+}
+
+std::size_t
+OrderBookIndex::numOffers() const
+{
+    std::shared_lock const lck{mtx_};
+    return offers_.size();
+}
+
+void
+OrderBookIndex::apply(
+    std::vector<ripple::uint256> const& keys,
+    LookupType const& lookup,
+    std::unordered_set<ripple::uint256, ripple::hardened_hash<>>& dirtyQualities
+)
+{
+    for (auto const& key : keys) {
+        // whatever the object was before, the quality it belonged to has to be looked at again
+        if (auto const it = offers_.find(key); it != offers_.end()) {
+            dirtyQualities.insert(it->second->bookDirectory);
+            offers_.erase(it);
+        }
+        if (auto const it = pageRoots_.find(key); it != pageRoots_.end()) {
+            dirtyQualities.insert(it->second);
+            pageRoots_.erase(it);
+        }
+
+        auto const* blob = lookup(key);
+        if (blob == nullptr or blob->size() < kMIN_OBJECT_SIZE)
+            continue;
+
+        try {
+            if (isOffer(*blob)) {
+                auto offer = std::make_shared<BookOffer const>(key, *blob);
+                dirtyQualities.insert(offer->bookDirectory);
+                offers_.emplace(key, std::move(offer));
+            } else if (isBookDir(key, *blob)) {
+                ripple::STLedgerEntry const sle{ripple::SerialIter{blob->data(), blob->size()}, key};
+                auto const quality = sle.getFieldH256(ripple::sfRootIndex);
+                dirtyQualities.insert(quality);
+                pageRoots_.emplace(key, quality);
+            }
+        } catch (std::exception const& e) {
+            LOG(gLog.error()) << "Failed to index object " << ripple::strHex(key) << ": " << e.what();
+        }
+    }
+}
+
+void
+OrderBookIndex::rebuildQuality(ripple::uint256 const& quality, LookupType const& lookup)
+{
+    auto const book = getBookBase(quality);
+    auto& qualities = books_[book];
+
+    std::vector<BookOfferPtr> offers;
+    try {
+        auto pageKey = quality;
+        auto const* page = lookup(pageKey);
+        while (page != nullptr) {
+            ripple::STLedgerEntry const sle{ripple::SerialIter{page->data(), page->size()}, pageKey};
+            for (auto const& offerKey : sle.getFieldV256(ripple::sfIndexes)) {
+                if (auto const it = offers_.find(offerKey); it != offers_.end())
+                    offers.push_back(it->second);
+            }
+
+            auto const next = sle.getFieldU64(ripple::sfIndexNext);
+            if (next == 0u)
+                break;
+
+            pageKey = ripple::keylet::page(quality, next).key;
+            page = lookup(pageKey);
+            if (page == nullptr)
+                LOG(gLog.error()) << "Missing page " << next << " of book directory " << ripple::strHex(quality);
+        }
+    } catch (std::exception const& e) {
+        LOG(gLog.error()) << "Failed to index book directory " << ripple::strHex(quality) << ": " << e.what();
+        offers.clear();
+    }
+
+    if (offers.empty()) {
+        qualities.erase(quality);
+    } else {
+        qualities[quality] = std::move(offers);
+    }
+
+    if (qualities.empty())
+        books_.erase(book);
+}
+
+}  // namespace data
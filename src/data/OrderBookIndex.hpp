@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+#include <xrpl/protocol/AccountID.h>
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief An offer of an order book with the fields needed to serve it already parsed.
+ */
+struct BookOffer {
+    ripple::uint256 key;
+    ripple::STLedgerEntry sle;
+    ripple::uint256 bookDirectory;
+    ripple::AccountID owner;
+    ripple::STAmount takerGets;
+    ripple::STAmount takerPays;
+
+    /**
+     * @brief Parse an offer from its serialized ledger entry.
+     *
+     * @param offerKey The key of the offer
+     * @param blob The serialized offer
+     * @throw std::exception if the blob is not a valid offer
+     */
+    BookOffer(ripple::uint256 const& offerKey, Blob const& blob);
+};
+
+using BookOfferPtr = std::shared_ptr<BookOffer const>;
+
+/**
+ * @brief In-memory index of all order books of the latest ledger.
+ *
+ * For every book the offers are kept grouped by quality directory in the order a walk of the book directories would
+ * return them, so that the top of a book is read in O(limit) without touching the database or parsing ledger entries.
+ *
+ * The index does not store ledger objects itself; it is kept up to date by the owner (see LedgerCache) passing the keys
+ * changed by each ledger together with a way to look up the current state of any object.
+ *
+ * @note Updates must be serialised by the owner; reads may happen concurrently with updates.
+ */
+class OrderBookIndex {
+    // offers of each quality directory of a book in directory order, by quality directory key
+    using QualityLevels = std::map<ripple::uint256, std::vector<BookOfferPtr>>;
+
+    mutable std::shared_mutex mtx_;
+    bool ready_ = false;
+    uint32_t seq_ = 0;
+
+    std::unordered_map<ripple::uint256, QualityLevels, ripple::hardened_hash<>> books_;
+    std::unordered_map<ripple::uint256, BookOfferPtr, ripple::hardened_hash<>> offers_;
+
+    // quality directory each book directory page belongs to, by page key
+    std::unordered_map<ripple::uint256, ripple::uint256, ripple::hardened_hash<>> pageRoots_;
+
+public:
+    /**
+     * @brief Returns the current state of an object; nullptr if it does not exist.
+     */
+    using LookupType = std::function<Blob const*(ripple::uint256 const&)>;
+
+    /**
+     * @brief Build the index from scratch.
+     *
+     * @param keys The keys of all offers and book directory pages of the ledger; other keys are ignored
+     * @param seq The sequence of the ledger
+     * @param lookup Returns the current state of an object
+     */
+    void
+    rebuild(std::vector<ripple::uint256> const& keys, uint32_t seq, LookupType const& lookup);
+
+    /**
+     * @brief Apply the changes of a new ledger to the index. Does nothing until the index was built.
+     *
+     * If the ledger does not directly follow the one held by the index, a ledger was missed while the index was built
+     * and the index is dropped until it is built again.
+     *
+     * @param keys The keys of all objects created, modified or deleted by the ledger
+     * @param seq The sequence of the ledger
+     * @param lookup Returns the state of an object after the ledger was applied
+     */
+    void
+    update(std::vector<ripple::uint256> const& keys, uint32_t seq, LookupType const& lookup);
+
+    /**
+     * @brief Drop all data and stop serving requests until the index is built again.
+     */
+    void
+    clear();
+
+    /**
+     * @return true if the index was built and follows new ledgers; false otherwise
+     */
+    bool
+    isReady() const;
+
+    /**
+     * @brief Get the best offers of a book.
+     *
+     * @param book The book base as returned by ripple::getBookBase
+     * @param seq The ledger sequence to get the offers for
+     * @param limit The maximum number of offers to return
+     * @return The offers ordered by quality; nullopt if the index does not hold the requested ledger
+     */
+    std::optional<std::vector<BookOfferPtr>>
+    getOffers(ripple::uint256 const& book, uint32_t seq, uint32_t limit) const;
+
+    /**
+     * @return The number of offers in the index
+     */
+    std::size_t
+    numOffers() const;
+
+private:
+    void
+    apply(
+        std::vector<ripple::uint256> const& keys,
+        LookupType const& lookup,
+        std::unordered_set<ripple::uint256, ripple::hardened_hash<>>& dirtyQualities
+    );
+
+    void
+    rebuildQuality(ripple::uint256 const& quality, LookupType const& lookup);
+};
+
+}  // namespace data
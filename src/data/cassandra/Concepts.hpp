@@ -57,20 +57,27 @@ concept SomeExecutionStrategy = requires(
     Handle handle,
     Statement statement,
     std::vector<Statement> statements,
+    std::vector<std::pair<std::uint32_t, Statement>> partitionedStatements,
     PreparedStatement prepared,
     boost::asio::yield_context token
 ) {
     { T(settings, handle) };
     { a.sync() } -> std::same_as<void>;
     { a.isTooBusy() } -> std::same_as<bool>;
+    { a.readLatency() } -> std::same_as<std::chrono::microseconds>;
+    { a.writeLoad() } -> std::same_as<double>;
     { a.writeSync(statement) } -> std::same_as<ResultOrError>;
     { a.writeSync(prepared) } -> std::same_as<ResultOrError>;
     { a.write(prepared) } -> std::same_as<void>;
     { a.write(std::move(statements)) } -> std::same_as<void>;
+    { a.writePartitioned(std::move(partitionedStatements)) } -> std::same_as<void>;
     { a.read(token, prepared) } -> std::same_as<ResultOrError>;
     { a.read(token, statement) } -> std::same_as<ResultOrError>;
     { a.read(token, statements) } -> std::same_as<ResultOrError>;
     { a.readEach(token, statements) } -> std::same_as<std::vector<Result>>;
+    {
+        a.readEachPage(token, statement, [](Result const&) {})
+    } -> std::same_as<void>;
     { a.stats() } -> std::same_as<boost::json::object>;
 };
 
@@ -302,6 +302,16 @@ public:
     [[nodiscard]] FutureWithCallbackType
     asyncExecute(std::vector<StatementType> const& statements, std::function<void(ResultOrErrorType)>&& cb) const;
 
+    /**
+     * @brief Execute an unlogged batch of (bound or simple) statements asynchronously with a completion callback.
+     *
+     * @param batch The statements to execute; they must all write to the same partition
+     * @param cb The callback to execute when data is ready
+     * @return A future that holds onto the callback provided
+     */
+    [[nodiscard]] FutureWithCallbackType
+    asyncExecute(UnloggedBatch<StatementType> const& batch, std::function<void(ResultOrErrorType)>&& cb) const;
+
     /**
      * @brief Prepare a statement.
      *
@@ -532,8 +532,9 @@ public:
             ));
         }();
 
+        // transactions and ledger headers never change once written, so they may be read at a weaker consistency
         PreparedStatement selectTransaction = [this]() {
-            return handle_.get().prepare(fmt::format(
+            auto statement = handle_.get().prepare(fmt::format(
                 R"(
                 SELECT transaction, metadata, ledger_sequence, date 
                   FROM {}
@@ -541,10 +542,12 @@ public:
                 )",
                 qualifiedTableName(settingsProvider_.get(), "transactions")
             ));
+            statement.setConsistency(settingsProvider_.get().getSettings().immutableReadConsistency);
+            return statement;
         }();
 
         PreparedStatement selectAllTransactionHashesInLedger = [this]() {
-            return handle_.get().prepare(fmt::format(
+            auto statement = handle_.get().prepare(fmt::format(
                 R"(
                 SELECT hash 
                   FROM {}               
@@ -552,6 +555,8 @@ public:
                 )",
                 qualifiedTableName(settingsProvider_.get(), "ledger_transactions")
             ));
+            statement.setConsistency(settingsProvider_.get().getSettings().immutableReadConsistency);
+            return statement;
         }();
 
         PreparedStatement selectLedgerPageKeys = [this]() {
@@ -749,7 +754,7 @@ public:
         }();
 
         PreparedStatement selectLedgerByHash = [this]() {
-            return handle_.get().prepare(fmt::format(
+            auto statement = handle_.get().prepare(fmt::format(
                 R"(
                 SELECT sequence
                   FROM {}
@@ -758,10 +763,12 @@ public:
                 )",
                 qualifiedTableName(settingsProvider_.get(), "ledger_hashes")
             ));
+            statement.setConsistency(settingsProvider_.get().getSettings().immutableReadConsistency);
+            return statement;
         }();
 
         PreparedStatement selectLedgerBySeq = [this]() {
-            return handle_.get().prepare(fmt::format(
+            auto statement = handle_.get().prepare(fmt::format(
                 R"(
                 SELECT header
                   FROM {}
@@ -769,6 +776,8 @@ public:
                 )",
                 qualifiedTableName(settingsProvider_.get(), "ledgers")
             ));
+            statement.setConsistency(settingsProvider_.get().getSettings().immutableReadConsistency);
+            return statement;
         }();
 
         PreparedStatement selectLatestLedger = [this]() {
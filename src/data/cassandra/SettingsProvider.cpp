@@ -24,6 +24,8 @@
 #include "util/Constants.hpp"
 #include "util/newconfig/ObjectView.hpp"
 
+#include <cassandra.h>
+
 #include <cerrno>
 #include <chrono>
 #include <cstddef>
@@ -39,6 +41,22 @@
 
 namespace data::cassandra {
 
+namespace {
+
+CassConsistency
+parseConsistency(std::string_view name)
+{
+    if (name == "one")
+        return CASS_CONSISTENCY_ONE;
+    if (name == "local_one")
+        return CASS_CONSISTENCY_LOCAL_ONE;
+    if (name == "local_quorum")
+        return CASS_CONSISTENCY_LOCAL_QUORUM;
+    return CASS_CONSISTENCY_QUORUM;
+}
+
+}  // namespace
+
 SettingsProvider::SettingsProvider(util::config::ObjectView const& cfg)
     : config_{cfg}
     , keyspace_{cfg.get<std::string>("keyspace")}
@@ -97,6 +115,18 @@ SettingsProvider::parseSettings() const
     settings.coreConnectionsPerHost = config_.get<uint32_t>("core_connections_per_host");
     settings.queueSizeIO = config_.maybeValue<uint32_t>("queue_size_io");
     settings.writeBatchSize = config_.get<std::size_t>("write_batch_size");
+    settings.readPageSize = config_.get<uint32_t>("read_page_size");
+    settings.immutableReadConsistency = parseConsistency(config_.get<std::string>("immutable_read_consistency"));
+    settings.maxSpeculativeExecutions = config_.get<uint32_t>("max_speculative_executions");
+    settings.hedgeReads = config_.get<bool>("hedge_reads");
+
+    if (config_.get<bool>("account_tx_cache.enabled"))
+        settings.accountTxCacheMaxBytes = config_.get<std::size_t>("account_tx_cache.max_bytes");
+
+    if (config_.getValueView("speculative_execution_delay").hasValue()) {
+        settings.speculativeExecutionDelay =
+            std::chrono::milliseconds{config_.get<uint32_t>("speculative_execution_delay")};
+    }
 
     if (config_.getValueView("connect_timeout").hasValue()) {
         auto const connectTimeoutSecond = config_.get<uint32_t>("connect_timeout");
@@ -23,6 +23,7 @@
 #include <expected>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace data::cassandra {
 
@@ -77,6 +78,19 @@ struct Text {
     }
 };
 
+/**
+ * @brief Statements that write to the same partition, to be executed as one unlogged batch
+ *
+ * An unlogged batch skips the batch log, which is only cheap when all statements belong to a single partition: the
+ * coordinator can then hand the whole batch to one set of replicas.
+ *
+ * @tparam StatementType The type of the statements
+ */
+template <typename StatementType>
+struct UnloggedBatch {
+    std::vector<StatementType> statements;
+};
+
 class Handle;
 class CassandraError;
 
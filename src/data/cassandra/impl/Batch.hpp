@@ -29,7 +29,7 @@
 namespace data::cassandra::impl {
 
 struct Batch : public ManagedObject<CassBatch> {
-    Batch(std::vector<Statement> const& statements);
+    Batch(std::vector<Statement> const& statements, CassBatchType type = CASS_BATCH_TYPE_LOGGED);
 
     MaybeError
     add(Statement const& statement);
@@ -70,6 +70,13 @@ Cluster::Cluster(Settings const& settings) : ManagedObject{cass_cluster_new(), k
         throw std::runtime_error(fmt::format("Could not set queue size for IO per host: {}", cass_error_desc(rc)));
     }
 
+    if (auto const delay = settings.speculativeExecutionDelay; delay.has_value()) {
+        auto const maxExecutions = static_cast<int>(settings.maxSpeculativeExecutions);
+        auto const rc = cass_cluster_set_constant_speculative_execution_policy(*this, delay->count(), maxExecutions);
+        if (rc != CASS_OK)
+            throw std::runtime_error(fmt::format("Could not set speculative executions: {}", cass_error_desc(rc)));
+    }
+
     setupConnection(settings);
     setupCertificate(settings);
     setupCredentials(settings);
@@ -78,6 +85,12 @@ Cluster::Cluster(Settings const& settings) : ManagedObject{cass_cluster_new(), k
     LOG(log_.info()) << "Core connections per host: " << settings.coreConnectionsPerHost;
     LOG(log_.info()) << "IO queue size: " << queueSize;
     LOG(log_.info()) << "Batched writes auto-chunk size: " << settings.writeBatchSize;
+    LOG(log_.info()) << "Paged reads page size: " << settings.readPageSize;
+    if (settings.speculativeExecutionDelay.has_value()) {
+        LOG(log_.info()) << "Speculative executions: up to " << settings.maxSpeculativeExecutions << " after "
+                         << settings.speculativeExecutionDelay->count() << " milliseconds";
+    }
+    LOG(log_.info()) << "Hedged reads: " << (settings.hedgeReads ? "enabled" : "disabled");
 }
 
 void
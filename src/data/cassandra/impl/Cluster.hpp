@@ -45,6 +45,7 @@ struct Settings {
     static constexpr uint32_t kDEFAULT_MAX_WRITE_REQUESTS_OUTSTANDING = 10'000;
     static constexpr uint32_t kDEFAULT_MAX_READ_REQUESTS_OUTSTANDING = 100'000;
     static constexpr std::size_t kDEFAULT_BATCH_SIZE = 20;
+    static constexpr uint32_t kDEFAULT_READ_PAGE_SIZE = 5000;
 
     /**
      * @brief Represents the configuration of contact points for cassandra.
@@ -88,6 +89,24 @@ struct Settings {
     /** @brief Size of batches when writing */
     std::size_t writeBatchSize = kDEFAULT_BATCH_SIZE;
 
+    /** @brief The maximum number of rows fetched at once by paged reads */
+    uint32_t readPageSize = kDEFAULT_READ_PAGE_SIZE;
+
+    /** @brief Consistency of reads of data that never changes once written, such as transactions */
+    CassConsistency immutableReadConsistency = CASS_CONSISTENCY_QUORUM;
+
+    /** @brief Delay after which the driver also sends a request to another node; disabled if not set */
+    std::optional<std::chrono::milliseconds> speculativeExecutionDelay;
+
+    /** @brief The maximum number of additional nodes the driver sends one request to */
+    uint32_t maxSpeculativeExecutions = 1u;
+
+    /** @brief Whether single reads slower than the recent tail latency are sent a second time */
+    bool hedgeReads = false;
+
+    /** @brief Size in bytes of the blobs kept by the cache of account transactions pages; disabled if not set */
+    std::optional<std::size_t> accountTxCacheMaxBytes = std::nullopt;  // NOLINT(readability-redundant-member-init)
+
     /** @brief Size of the IO queue */
     std::optional<uint32_t> queueSizeIO = std::nullopt;  // NOLINT(readability-redundant-member-init)
 
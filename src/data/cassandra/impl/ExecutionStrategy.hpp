@@ -24,6 +24,7 @@
 #include "data/cassandra/Handle.hpp"
 #include "data/cassandra/Types.hpp"
 #include "data/cassandra/impl/AsyncExecutor.hpp"
+#include "data/cassandra/impl/RequestCredits.hpp"
 #include "util/Assert.hpp"
 #include "util/Batching.hpp"
 #include "util/log/Logger.hpp"
@@ -33,21 +34,26 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/json/object.hpp>
 
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <thread>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace data::cassandra::impl {
@@ -64,19 +70,12 @@ template <typename HandleType = Handle, SomeBackendCounters BackendCountersType
 class DefaultExecutionStrategy {
     util::Logger log_{"Backend"};
 
-    std::uint32_t maxWriteRequestsOutstanding_;
-    std::atomic_uint32_t numWriteRequestsOutstanding_ = 0;
-
-    std::uint32_t maxReadRequestsOutstanding_;
-    std::atomic_uint32_t numReadRequestsOutstanding_ = 0;
+    RequestCredits writeCredits_;
+    RequestCredits readCredits_;
 
     std::size_t writeBatchSize_;
-
-    std::mutex throttleMutex_;
-    std::condition_variable throttleCv_;
-
-    std::mutex syncMutex_;
-    std::condition_variable syncCv_;
+    std::uint32_t readPageSize_;
+    bool hedgeReads_;
 
     boost::asio::io_context ioc_;
     std::optional<boost::asio::io_service::work> work_;
@@ -104,16 +103,18 @@ public:
         HandleType const& handle,
         typename BackendCountersType::PtrType counters = BackendCountersType::make()
     )
-        : maxWriteRequestsOutstanding_{settings.maxWriteRequestsOutstanding}
-        , maxReadRequestsOutstanding_{settings.maxReadRequestsOutstanding}
+        : writeCredits_{settings.maxWriteRequestsOutstanding}
+        , readCredits_{settings.maxReadRequestsOutstanding}
         , writeBatchSize_{settings.writeBatchSize}
+        , readPageSize_{settings.readPageSize}
+        , hedgeReads_{settings.hedgeReads}
         , work_{ioc_}
         , handle_{std::cref(handle)}
         , thread_{[this]() { ioc_.run(); }}
         , counters_{std::move(counters)}
     {
-        LOG(log_.info()) << "Max write requests outstanding is " << maxWriteRequestsOutstanding_
-                         << "; Max read requests outstanding is " << maxReadRequestsOutstanding_;
+        LOG(log_.info()) << "Max write requests outstanding is " << writeCredits_.max()
+                         << "; Max read requests outstanding is " << readCredits_.max();
     }
 
     ~DefaultExecutionStrategy()
@@ -130,8 +131,7 @@ public:
     sync()
     {
         LOG(log_.debug()) << "Waiting to sync all writes...";
-        std::unique_lock<std::mutex> lck(syncMutex_);
-        syncCv_.wait(lck, [this]() { return finishedAllWriteRequests(); });
+        writeCredits_.waitUntilIdle();
         LOG(log_.debug()) << "Sync done.";
     }
 
@@ -141,12 +141,32 @@ public:
     bool
     isTooBusy() const
     {
-        bool const result = numReadRequestsOutstanding_ >= maxReadRequestsOutstanding_;
+        bool const result = readCredits_.exhausted();
         if (result)
             counters_->registerTooBusy();
         return result;
     }
 
+    /**
+     * @return The recent latency of read operations
+     */
+    std::chrono::microseconds
+    readLatency() const
+    {
+        return counters_->readLatency();
+    }
+
+    /**
+     * @return The share of the allowed outstanding write requests that is in use, from 0 to 1
+     */
+    double
+    writeLoad() const
+    {
+        if (writeCredits_.max() == 0)
+            return 0.0;
+        return static_cast<double>(writeCredits_.outstanding()) / writeCredits_.max();
+    }
+
     /**
      * @brief Blocking query execution used for writing data.
      *
@@ -209,23 +229,7 @@ public:
     void
     write(StatementType&& statement)
     {
-        auto const startTime = std::chrono::steady_clock::now();
-
-        incrementOutstandingRequestCount();
-
-        counters_->registerWriteStarted();
-        // Note: lifetime is controlled by std::shared_from_this internally
-        AsyncExecutor<std::decay_t<decltype(statement)>, HandleType>::run(
-            ioc_,
-            handle_,
-            std::move(statement),
-            [this, startTime](auto const&) {
-                decrementOutstandingRequestCount();
-
-                counters_->registerWriteFinished(startTime);
-            },
-            [this]() { counters_->registerWriteRetry(); }
-        );
+        writeAsync(std::move(statement));
     }
 
     /**
@@ -243,29 +247,54 @@ public:
             return;
 
         util::forEachBatch(std::move(statements), writeBatchSize_, [this](auto begin, auto end) {
-            auto const startTime = std::chrono::steady_clock::now();
             auto chunk = std::vector<StatementType>{};
 
             chunk.reserve(std::distance(begin, end));
             std::move(begin, end, std::back_inserter(chunk));
 
-            incrementOutstandingRequestCount();
-            counters_->registerWriteStarted();
-
-            // Note: lifetime is controlled by std::shared_from_this internally
-            AsyncExecutor<std::decay_t<decltype(chunk)>, HandleType>::run(
-                ioc_,
-                handle_,
-                std::move(chunk),
-                [this, startTime](auto const&) {
-                    decrementOutstandingRequestCount();
-                    counters_->registerWriteFinished(startTime);
-                },
-                [this]() { counters_->registerWriteRetry(); }
-            );
+            writeAsync(std::move(chunk));
         });
     }
 
+    /**
+     * @brief Non-blocking query execution used for writing statements that may belong to different partitions.
+     *
+     * Statements are grouped by their partition key. A partition with several statements is written with unlogged
+     * batches of up to writeBatchSize statements, which skip the batch log because all their rows live on the same
+     * replicas. A statement that is alone in its partition is written individually.
+     *
+     * Retries forever with retry policy specified by @ref AsyncExecutor.
+     *
+     * @tparam KeyType The type of the partition key; must be ordered
+     * @param statements Pairs of partition key and the statement writing to that partition
+     * @throw DatabaseTimeout on timeout
+     */
+    template <typename KeyType>
+    void
+    writePartitioned(std::vector<std::pair<KeyType, StatementType>>&& statements)
+    {
+        std::map<KeyType, std::vector<StatementType>> partitions;
+        for (auto& [key, statement] : statements)
+            partitions[std::move(key)].push_back(std::move(statement));
+
+        for (auto& [_, partition] : partitions) {
+            util::forEachBatch(std::move(partition), writeBatchSize_, [this](auto begin, auto end) {
+                auto const size = static_cast<std::size_t>(std::distance(begin, end));
+                counters_->registerWriteBatch(size);
+
+                if (size == 1) {
+                    write(std::move(*begin));
+                    return;
+                }
+
+                auto batch = UnloggedBatch<StatementType>{};
+                batch.statements.reserve(size);
+                std::move(begin, end, std::back_inserter(batch.statements));
+                writeAsync(std::move(batch));
+            });
+        }
+    }
+
     /**
      * @brief Non-blocking  query execution used for writing data. Constrast with write, this method does not execute
      * the statements in a batch.
@@ -320,7 +349,7 @@ public:
 
         // todo: perhaps use policy instead
         while (true) {
-            numReadRequestsOutstanding_ += numStatements;
+            readCredits_.add(numStatements);
 
             auto init = [this, &statements, &future]<typename Self>(Self& self) {
                 auto sself = std::make_shared<Self>(std::move(self));
@@ -336,7 +365,7 @@ public:
             auto res = boost::asio::async_compose<CompletionTokenType, void(ResultOrErrorType)>(
                 init, token, boost::asio::get_associated_executor(token)
             );
-            numReadRequestsOutstanding_ -= numStatements;
+            readCredits_.release(numStatements);
 
             if (res) {
                 counters_->registerReadFinished(startTime, numStatements);
@@ -358,6 +387,8 @@ public:
      * @brief Coroutine-based query execution used for reading data.
      *
      * Retries forever until successful or throws an exception on timeout.
+     * With hedged reads enabled, a statement that did not answer within the recent tail latency of reads is sent a
+     * second time and the first answer wins.
      *
      * @param token Completion token (yield_context)
      * @param statement Statement to execute
@@ -374,7 +405,8 @@ public:
 
         // todo: perhaps use policy instead
         while (true) {
-            ++numReadRequestsOutstanding_;
+            readCredits_.add();
+            auto const hedgeDelay = hedgeReads_ ? counters_->readTailLatency() : std::chrono::microseconds::zero();
             auto init = [this, &statement, &future]<typename Self>(Self& self) {
                 auto sself = std::make_shared<Self>(std::move(self));
 
@@ -386,10 +418,12 @@ public:
                 }));
             };
 
-            auto res = boost::asio::async_compose<CompletionTokenType, void(ResultOrErrorType)>(
-                init, token, boost::asio::get_associated_executor(token)
-            );
-            --numReadRequestsOutstanding_;
+            auto res = hedgeDelay > std::chrono::microseconds::zero()
+                ? readHedged(token, statement, hedgeDelay)
+                : boost::asio::async_compose<CompletionTokenType, void(ResultOrErrorType)>(
+                      init, token, boost::asio::get_associated_executor(token)
+                  );
+            readCredits_.release();
 
             if (res) {
                 counters_->registerReadFinished(startTime);
@@ -425,7 +459,7 @@ public:
 
         std::atomic_uint64_t errorsCount = 0u;
         std::atomic_int numOutstanding = statements.size();
-        numReadRequestsOutstanding_ += statements.size();
+        readCredits_.add(statements.size());
 
         auto futures = std::vector<FutureWithCallbackType>{};
         futures.reserve(numOutstanding);
@@ -458,7 +492,7 @@ public:
         boost::asio::async_compose<CompletionTokenType, void()>(
             init, token, boost::asio::get_associated_executor(token)
         );
-        numReadRequestsOutstanding_ -= statements.size();
+        readCredits_.release(statements.size());
 
         if (errorsCount > 0) {
             ASSERT(errorsCount <= statements.size(), "Errors number cannot exceed statements number");
@@ -498,6 +532,70 @@ public:
         return results;
     }
 
+    /**
+     * @brief Coroutine-based paged query execution used for reading large result sets.
+     *
+     * Rows are fetched in pages of the configured size. The next page is requested before the current one is handed
+     * to the callback, so fetching and processing overlap while at most two pages are held in memory.
+     * A failed page is retried until successful or an exception is thrown on timeout.
+     *
+     * @param token Completion token (yield_context)
+     * @param statement Statement to execute
+     * @param onPage Invoked with each page of results in order
+     * @throw DatabaseTimeout on timeout
+     */
+    template <typename FnType>
+    void
+    readEachPage(CompletionTokenType token, StatementType statement, FnType&& onPage)
+    {
+        statement.setPageSize(readPageSize_);
+        auto pending = fetchPage(statement);
+
+        while (true) {
+            auto const current = std::exchange(pending, nullptr);
+            auto res = awaitPage(token, current);
+
+            if (not res) {
+                LOG(log_.error()) << "Failed paged read in coroutine: " << res.error();
+                try {
+                    throwErrorIfNeeded(res.error());
+                } catch (...) {
+                    counters_->registerReadError();
+                    throw;
+                }
+                counters_->registerReadRetry();
+                pending = fetchPage(statement);
+                continue;
+            }
+            counters_->registerReadFinished(current->startTime);
+
+            auto const& page = res.value();
+            auto const hasMorePages = page.hasMorePages();
+            if (hasMorePages) {
+                statement.setPagingState(page);
+                pending = fetchPage(statement);
+            }
+
+            // the prefetched request must complete before its callback is destroyed; not awaited inside the catch
+            // block as the coroutine may be resumed on another thread
+            std::exception_ptr error;
+            try {
+                onPage(page);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            if (error) {
+                if (pending)
+                    std::ignore = awaitPage(token, pending);
+                std::rethrow_exception(error);
+            }
+
+            if (not hasMorePages)
+                return;
+        }
+    }
+
     /**
      * @brief Get statistics about the backend.
      */
@@ -508,50 +606,178 @@ public:
     }
 
 private:
+    template <typename DataType>
     void
-    incrementOutstandingRequestCount()
+    writeAsync(DataType&& data)
     {
-        {
-            std::unique_lock<std::mutex> lck(throttleMutex_);
-            if (!canAddWriteRequest()) {
-                LOG(log_.trace()) << "Max outstanding requests reached. "
-                                  << "Waiting for other requests to finish";
-                throttleCv_.wait(lck, [this]() { return canAddWriteRequest(); });
-            }
-        }
-        ++numWriteRequestsOutstanding_;
+        auto const startTime = std::chrono::steady_clock::now();
+
+        incrementOutstandingRequestCount();
+        counters_->registerWriteStarted();
+
+        // Note: lifetime is controlled by std::shared_from_this internally
+        AsyncExecutor<std::decay_t<DataType>, HandleType>::run(
+            ioc_,
+            handle_,
+            std::forward<DataType>(data),
+            [this, startTime](auto const&) {
+                decrementOutstandingRequestCount();
+                counters_->registerWriteFinished(startTime);
+            },
+            [this]() { counters_->registerWriteRetry(); }
+        );
     }
 
+    /**
+     * @brief A read that was requested but possibly not yet awaited; the first attempt to answer provides the result.
+     */
+    struct PendingRead {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        std::vector<FutureWithCallbackType> futures;
+
+        std::mutex mutex;
+        std::optional<ResultOrErrorType> result;
+        std::size_t winner = 0;
+        std::function<void()> resume;
+    };
+
     void
-    decrementOutstandingRequestCount()
+    startAttempt(std::shared_ptr<PendingRead> const& read, StatementType const& statement)
     {
-        // sanity check
-        ASSERT(numWriteRequestsOutstanding_ > 0, "Decrementing num outstanding below 0");
-        size_t const cur = (--numWriteRequestsOutstanding_);
-        {
-            // mutex lock required to prevent race condition around spurious
-            // wakeup
-            std::lock_guard const lck(throttleMutex_);
-            throttleCv_.notify_one();
-        }
-        if (cur == 0) {
-            // mutex lock required to prevent race condition around spurious
-            // wakeup
-            std::lock_guard const lck(syncMutex_);
-            syncCv_.notify_one();
-        }
+        auto const attempt = read->futures.size();
+        read->futures.push_back(handle_.get().asyncExecute(statement, [read, attempt](auto&& res) {
+            std::function<void()> resume;
+            {
+                std::lock_guard const lck(read->mutex);
+                if (read->result.has_value())
+                    return;
+
+                read->result.emplace(std::forward<decltype(res)>(res));
+                read->winner = attempt;
+                resume = std::exchange(read->resume, nullptr);
+            }
+
+            if (resume)
+                resume();
+        }));
     }
 
+    /**
+     * @return true if the read has its result; false if the timeout expired first
+     */
     bool
-    canAddWriteRequest() const
+    awaitRead(
+        CompletionTokenType token,
+        std::shared_ptr<PendingRead> const& read,
+        std::optional<std::chrono::microseconds> timeout = std::nullopt
+    )
     {
-        return numWriteRequestsOutstanding_ < maxWriteRequestsOutstanding_;
+        std::optional<boost::asio::steady_timer> timer;
+        auto init = [&read, &timer, &timeout]<typename Self>(Self& self) {
+            auto sself = std::make_shared<Self>(std::move(self));
+            auto resume = [sself]() mutable {
+                boost::asio::post(boost::asio::get_associated_executor(*sself), [sself]() mutable {
+                    sself->complete();
+                });
+            };
+
+            {
+                std::lock_guard const lck(read->mutex);
+                if (not read->result.has_value()) {
+                    read->resume = std::move(resume);
+                    if (timeout.has_value()) {
+                        timer.emplace(boost::asio::get_associated_executor(*sself), *timeout);
+                        timer->async_wait([read](auto const& /* ec */) {
+                            std::function<void()> resume;
+                            {
+                                std::lock_guard const lck(read->mutex);
+                                resume = std::exchange(read->resume, nullptr);
+                            }
+
+                            if (resume)
+                                resume();
+                        });
+                    }
+                    return;
+                }
+            }
+            resume();
+        };
+
+        boost::asio::async_compose<CompletionTokenType, void()>(
+            init, token, boost::asio::get_associated_executor(token)
+        );
+
+        if (timer.has_value())
+            timer->cancel();
+
+        std::lock_guard const lck(read->mutex);
+        return read->result.has_value();
     }
 
-    bool
-    finishedAllWriteRequests() const
+    ResultOrErrorType
+    takeResult(std::shared_ptr<PendingRead> const& read)
+    {
+        std::lock_guard const lck(read->mutex);
+        return std::move(read->result).value();
+    }
+
+    std::shared_ptr<PendingRead>
+    fetchPage(StatementType const& statement)
+    {
+        auto page = std::make_shared<PendingRead>();
+        readCredits_.add();
+        counters_->registerReadStarted();
+        startAttempt(page, statement);
+        return page;
+    }
+
+    ResultOrErrorType
+    awaitPage(CompletionTokenType token, std::shared_ptr<PendingRead> const& page)
+    {
+        std::ignore = awaitRead(token, page);
+        readCredits_.release();
+        return takeResult(page);
+    }
+
+    /**
+     * @brief Executes the statement and sends it a second time if no answer came within the given delay.
+     */
+    ResultOrErrorType
+    readHedged(CompletionTokenType token, StatementType const& statement, std::chrono::microseconds delay)
+    {
+        auto read = std::make_shared<PendingRead>();
+        startAttempt(read, statement);
+
+        if (not awaitRead(token, read, delay)) {
+            counters_->registerReadHedgeFired();
+            readCredits_.add();
+            startAttempt(read, statement);
+            std::ignore = awaitRead(token, read);
+            readCredits_.release();
+        }
+
+        std::lock_guard const lck(read->mutex);
+        if (read->winner > 0)
+            counters_->registerReadHedgeWon();
+        return std::move(read->result).value();
+    }
+
+    void
+    incrementOutstandingRequestCount()
+    {
+        if (writeCredits_.tryAcquire())
+            return;
+
+        LOG(log_.trace()) << "Max outstanding requests reached. "
+                          << "Waiting for other requests to finish";
+        writeCredits_.acquire();
+    }
+
+    void
+    decrementOutstandingRequestCount()
     {
-        return numWriteRequestsOutstanding_ == 0;
+        writeCredits_.release();
     }
 
     void
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Assert.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace data::cassandra::impl {
+
+/**
+ * @brief Counts the outstanding requests of one kind and admits new ones while fewer than the maximum are in flight.
+ *
+ * Taking and returning credits is a single atomic operation. Returning a credit only wakes blocked threads when some
+ * exist and the count drops below the maximum or to zero, so completions that run on many driver threads do not
+ * contend on a mutex nor wake anybody needlessly.
+ *
+ * @note This class is thread-safe.
+ */
+class RequestCredits {
+    std::uint32_t max_;
+    std::atomic_uint32_t outstanding_ = 0;
+    std::atomic_uint32_t waiters_ = 0;
+
+public:
+    /**
+     * @brief Construct a new RequestCredits object
+     *
+     * @param max The maximum number of outstanding requests
+     */
+    explicit RequestCredits(std::uint32_t max) : max_{max}
+    {
+    }
+
+    /**
+     * @brief Take a credit if fewer than the maximum requests are outstanding
+     *
+     * @return true if the credit was taken; false otherwise
+     */
+    [[nodiscard]] bool
+    tryAcquire()
+    {
+        auto current = outstanding_.load();
+        while (current < max_) {
+            if (outstanding_.compare_exchange_weak(current, current + 1))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Take a credit, blocking until fewer than the maximum requests are outstanding
+     */
+    void
+    acquire()
+    {
+        if (tryAcquire())
+            return;
+
+        ++waiters_;
+        while (true) {
+            auto current = outstanding_.load();
+            if (current < max_) {
+                if (outstanding_.compare_exchange_weak(current, current + 1))
+                    break;
+                continue;
+            }
+            outstanding_.wait(current);
+        }
+        --waiters_;
+    }
+
+    /**
+     * @brief Take credits without checking the maximum
+     *
+     * @param count The number of credits to take
+     */
+    void
+    add(std::uint32_t count = 1u)
+    {
+        outstanding_ += count;
+    }
+
+    /**
+     * @brief Return credits taken by acquire, tryAcquire or add
+     *
+     * @param count The number of credits to return
+     */
+    void
+    release(std::uint32_t count = 1u)
+    {
+        auto const previous = outstanding_.fetch_sub(count);
+        ASSERT(previous >= count, "Releasing more credits than outstanding");
+
+        auto const current = previous - count;
+        if (((previous >= max_ and current < max_) or current == 0) and waiters_.load() > 0)
+            outstanding_.notify_all();
+    }
+
+    /**
+     * @brief Block until all credits are returned
+     */
+    void
+    waitUntilIdle()
+    {
+        ++waiters_;
+        for (auto current = outstanding_.load(); current != 0; current = outstanding_.load())
+            outstanding_.wait(current);
+        --waiters_;
+    }
+
+    /**
+     * @return The number of outstanding requests
+     */
+    [[nodiscard]] std::uint32_t
+    outstanding() const
+    {
+        return outstanding_.load();
+    }
+
+    /**
+     * @return The maximum number of outstanding requests
+     */
+    [[nodiscard]] std::uint32_t
+    max() const
+    {
+        return max_;
+    }
+
+    /**
+     * @return true if no credit is left; false otherwise
+     */
+    [[nodiscard]] bool
+    exhausted() const
+    {
+        return outstanding_.load() >= max_;
+    }
+};
+
+}  // namespace data::cassandra::impl
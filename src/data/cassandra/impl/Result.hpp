@@ -116,6 +116,9 @@ struct Result : public ManagedObject<CassResult const> {
     [[nodiscard]] bool
     hasRows() const;
 
+    [[nodiscard]] bool
+    hasMorePages() const;
+
     template <typename... RowTypes>
     std::optional<std::tuple<RowTypes...>>
     get() const
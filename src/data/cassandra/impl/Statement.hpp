@@ -22,6 +22,7 @@
 #include "data/cassandra/Types.hpp"
 #include "data/cassandra/impl/Collection.hpp"
 #include "data/cassandra/impl/ManagedObject.hpp"
+#include "data/cassandra/impl/Result.hpp"
 #include "data/cassandra/impl/Tuple.hpp"
 #include "util/UnsupportedType.hpp"
 
@@ -145,6 +146,40 @@ public:
             static_assert(util::Unsupported<DecayedType>);
         }
     }
+
+    /**
+     * @brief Sets the consistency level the statement is executed with.
+     *
+     * @param consistency The consistency level
+     */
+    void
+    setConsistency(CassConsistency consistency) const
+    {
+        cass_statement_set_consistency(*this, consistency);
+    }
+
+    /**
+     * @brief Makes the statement return its rows in pages of the given size.
+     *
+     * @param pageSize The maximum number of rows per page
+     */
+    void
+    setPageSize(std::uint32_t pageSize) const
+    {
+        cass_statement_set_paging_size(*this, static_cast<int>(pageSize));
+    }
+
+    /**
+     * @brief Makes the next execution of the statement return the page following the given result.
+     *
+     * @param result The previously fetched page
+     */
+    void
+    setPagingState(Result const& result) const
+    {
+        if (auto const rc = cass_statement_set_paging_state(*this, result); rc != CASS_OK)
+            throw std::logic_error(fmt::format("[Set paging state]: {}", cass_error_desc(rc)));
+    }
 };
 
 /**
@@ -155,11 +190,24 @@ public:
 class PreparedStatement : public ManagedObject<CassPrepared const> {
     static constexpr auto kDELETER = [](CassPrepared const* ptr) { cass_prepared_free(ptr); };
 
+    CassConsistency consistency_ = CASS_CONSISTENCY_QUORUM;
+
 public:
     /* implicit */ PreparedStatement(CassPrepared const* ptr) : ManagedObject{ptr, kDELETER}
     {
     }
 
+    /**
+     * @brief Sets the consistency level of the statements produced by bind.
+     *
+     * @param consistency The consistency level
+     */
+    void
+    setConsistency(CassConsistency consistency)
+    {
+        consistency_ = consistency;
+    }
+
     /**
      * @brief Bind the given arguments and produce a ready to execute Statement.
      *
@@ -171,6 +219,7 @@ public:
     bind(Args&&... args) const
     {
         Statement statement = cass_prepared_bind(*this);
+        statement.setConsistency(consistency_);
         statement.bind<Args...>(std::forward<Args>(args)...);
         return statement;
     }
@@ -0,0 +1,304 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief An ordered map stored as a sorted sequence of sorted pages (a two level B+-tree).
+ *
+ * Compared to std::map this keeps entries contiguous in memory: lookups are two binary searches over arrays instead of
+ * a pointer chase through a red-black tree and there is no per-node allocation overhead. Inserting or erasing shifts at
+ * most one page worth of entries.
+ *
+ * @note This class is not thread-safe; synchronisation is the responsibility of the owner.
+ *
+ * @tparam KeyType The key type; must be totally ordered by operator<
+ * @tparam ValueType The mapped type; must be default constructible
+ * @tparam PageCapacity Maximum number of entries in a single page before it is split in two
+ */
+template <typename KeyType, typename ValueType, std::size_t PageCapacity = 256uz>
+class PagedOrderedMap {
+    static_assert(PageCapacity >= 2uz, "A page must be able to hold at least two entries to be split");
+
+public:
+    using EntryType = std::pair<KeyType, ValueType>;
+
+private:
+    using PageType = std::vector<EntryType>;
+
+    // invariant: no page is empty and the last key of a page is less than the first key of the next one
+    std::vector<PageType> pages_;
+    std::size_t size_ = 0uz;
+
+    struct Position {
+        std::size_t page;
+        std::size_t offset;
+    };
+
+public:
+    /**
+     * @brief Find the value stored for the given key
+     *
+     * @param key The key to look for
+     * @return Pointer to the value if found; nullptr otherwise
+     */
+    [[nodiscard]] ValueType const*
+    find(KeyType const& key) const
+    {
+        if (auto const pos = lowerBound(key); isAt(pos, key))
+            return &pages_[pos.page][pos.offset].second;
+        return nullptr;
+    }
+
+    /**
+     * @brief Find the value stored for the given key
+     *
+     * @param key The key to look for
+     * @return Pointer to the value if found; nullptr otherwise
+     */
+    [[nodiscard]] ValueType*
+    find(KeyType const& key)
+    {
+        if (auto const pos = lowerBound(key); isAt(pos, key))
+            return &pages_[pos.page][pos.offset].second;
+        return nullptr;
+    }
+
+    /**
+     * @brief Get the value for the given key, inserting a default constructed value if the key is not present
+     *
+     * @param key The key to look for
+     * @return Reference to the value; only valid until the next modification of the map
+     */
+    ValueType&
+    operator[](KeyType const& key)
+    {
+        if (pages_.empty()) {
+            pages_.emplace_back().emplace_back(key, ValueType{});
+            ++size_;
+            return pages_.front().front().second;
+        }
+
+        auto pos = lowerBound(key);
+        if (isAt(pos, key))
+            return pages_[pos.page][pos.offset].second;
+
+        // a key past the end of the map is appended to the last page
+        if (pos.page == pages_.size()) {
+            pos.page = pages_.size() - 1;
+            pos.offset = pages_.back().size();
+        }
+
+        if (pages_[pos.page].size() >= PageCapacity)
+            pos = split(pos);
+
+        auto& page = pages_[pos.page];
+        page.emplace(std::next(page.begin(), static_cast<std::ptrdiff_t>(pos.offset)), key, ValueType{});
+        ++size_;
+        return page[pos.offset].second;
+    }
+
+    /**
+     * @brief Erase the entry for the given key
+     *
+     * @param key The key to erase
+     * @return true if an entry was erased; false if the key was not present
+     */
+    bool
+    erase(KeyType const& key)
+    {
+        auto const pos = lowerBound(key);
+        if (not isAt(pos, key))
+            return false;
+
+        auto& page = pages_[pos.page];
+        page.erase(std::next(page.begin(), static_cast<std::ptrdiff_t>(pos.offset)));
+        if (page.empty())
+            pages_.erase(std::next(pages_.begin(), static_cast<std::ptrdiff_t>(pos.page)));
+
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Find the first entry with a key strictly greater than the given key
+     *
+     * @param key The key to search from
+     * @return Pointer to the entry if found; nullptr otherwise
+     */
+    [[nodiscard]] EntryType const*
+    upperBound(KeyType const& key) const
+    {
+        auto pos = lowerBound(key);
+        if (isAt(pos, key))
+            pos = next(pos);
+        return at(pos);
+    }
+
+    /**
+     * @brief Find the last entry with a key strictly less than the given key
+     *
+     * @param key The key to search from
+     * @return Pointer to the entry if found; nullptr otherwise
+     */
+    [[nodiscard]] EntryType const*
+    lowerNeighbour(KeyType const& key) const
+    {
+        auto const pos = lowerBound(key);
+        if (pos.page == pages_.size())
+            return last();
+
+        if (pos.offset > 0uz)
+            return &pages_[pos.page][pos.offset - 1];
+
+        if (pos.page > 0uz)
+            return &pages_[pos.page - 1].back();
+
+        return nullptr;
+    }
+
+    /**
+     * @return Pointer to the entry with the smallest key; nullptr if the map is empty
+     */
+    [[nodiscard]] EntryType const*
+    first() const
+    {
+        return pages_.empty() ? nullptr : &pages_.front().front();
+    }
+
+    /**
+     * @return Pointer to the entry with the largest key; nullptr if the map is empty
+     */
+    [[nodiscard]] EntryType const*
+    last() const
+    {
+        return pages_.empty() ? nullptr : &pages_.back().back();
+    }
+
+    /**
+     * @brief Call the given function for every entry of the map in key order
+     *
+     * @param fn The function to call with the key and the value of each entry
+     */
+    template <typename FnType>
+    void
+    forEach(FnType&& fn) const
+    {
+        for (auto const& page : pages_) {
+            for (auto const& [key, value] : page)
+                fn(key, value);
+        }
+    }
+
+    /**
+     * @return The number of entries in the map
+     */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @return true if the map holds no entries; false otherwise
+     */
+    [[nodiscard]] bool
+    empty() const
+    {
+        return size_ == 0uz;
+    }
+
+private:
+    // position of the first entry with key not less than the given one; {pages_.size(), 0} if there is none
+    [[nodiscard]] Position
+    lowerBound(KeyType const& key) const
+    {
+        // first page whose last key is not less than the key is the only one that may hold the key
+        auto const page = std::ranges::lower_bound(pages_, key, std::less<>{}, [](PageType const& p) -> auto const& {
+            return p.back().first;
+        });
+        if (page == pages_.end())
+            return {.page = pages_.size(), .offset = 0uz};
+
+        auto const entry = std::ranges::lower_bound(*page, key, std::less<>{}, &EntryType::first);
+        return {
+            .page = static_cast<std::size_t>(std::distance(pages_.begin(), page)),
+            .offset = static_cast<std::size_t>(std::distance(page->begin(), entry))
+        };
+    }
+
+    [[nodiscard]] bool
+    isAt(Position pos, KeyType const& key) const
+    {
+        if (pos.page == pages_.size())
+            return false;
+        auto const& entryKey = pages_[pos.page][pos.offset].first;
+        return not(key < entryKey) and not(entryKey < key);
+    }
+
+    [[nodiscard]] Position
+    next(Position pos) const
+    {
+        if (pos.page == pages_.size())
+            return pos;
+        if (++pos.offset == pages_[pos.page].size())
+            return {.page = pos.page + 1, .offset = 0uz};
+        return pos;
+    }
+
+    [[nodiscard]] EntryType const*
+    at(Position pos) const
+    {
+        if (pos.page == pages_.size())
+            return nullptr;
+        return &pages_[pos.page][pos.offset];
+    }
+
+    // splits the page at the given position in two halves and returns where the position ended up
+    Position
+    split(Position pos)
+    {
+        auto& page = pages_[pos.page];
+        auto const half = page.size() / 2;
+
+        PageType upper;
+        upper.reserve(PageCapacity);
+        std::move(
+            std::next(page.begin(), static_cast<std::ptrdiff_t>(half)), page.end(), std::back_inserter(upper)
+        );
+        page.resize(half);
+
+        pages_.insert(std::next(pages_.begin(), static_cast<std::ptrdiff_t>(pos.page + 1)), std::move(upper));
+
+        if (pos.offset > half)
+            return {.page = pos.page + 1, .offset = pos.offset - half};
+        return pos;
+    }
+};
+
+}  // namespace data::impl
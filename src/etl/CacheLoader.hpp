@@ -71,6 +71,8 @@ public:
     )
         : backend_{backend}, cache_{cache}, settings_{makeCacheLoaderSettings(config)}, ctx_{settings_.numThreads}
     {
+        cache_.get().setNumRetainedLedgers(settings_.numRetainedLedgers);
+        cache_.get().setOrderBookIndexEnabled(settings_.orderBookIndex);
     }
 
     /**
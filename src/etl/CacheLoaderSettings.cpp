@@ -62,6 +62,8 @@ makeCacheLoaderSettings(util::config::ClioConfigDefinition const& config)
 
     settings.numCacheMarkers = cache.get<std::size_t>("num_markers");
     settings.cachePageFetchSize = cache.get<std::size_t>("page_fetch_size");
+    settings.numRetainedLedgers = cache.get<uint32_t>("num_retained_ledgers");
+    settings.orderBookIndex = cache.get<bool>("order_book_index");
 
     auto const entry = cache.get<std::string>("load");
     if (boost::iequals(entry, "sync"))
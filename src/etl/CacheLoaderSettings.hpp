@@ -22,6 +22,7 @@
 #include "util/newconfig/ConfigDefinition.hpp"
 
 #include <cstddef>
+#include <cstdint>
 
 namespace etl {
 
@@ -38,6 +39,8 @@ struct CacheLoaderSettings {
     size_t numThreads = 2;                 /**< number of threads to use for loading cache */
     size_t numCacheCursorsFromDiff = 0;    /**< number of cursors to fetch from diff */
     size_t numCacheCursorsFromAccount = 0; /**< number of cursors to fetch from account_tx */
+    uint32_t numRetainedLedgers = 0;       /**< number of ledgers before the latest one to keep versions for */
+    bool orderBookIndex = false;           /**< whether to maintain an index of all order books */
 
     LoadStyle loadStyle = LoadStyle::ASYNC; /**< how to load the cache */
 
@@ -22,6 +22,8 @@
 
 #include <xrpl/basics/base_uint.h>
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
@@ -29,16 +31,16 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace etl {
 
-// TODO: does the note make sense? lockfree queues provide the same blocking behaviour just without mutex, don't they?
 /**
  * @brief Generic thread-safe queue with a max capacity.
  *
- * @note (original note) We can't use a lockfree queue here, since we need the ability to wait for an element to be
- * added or removed from the queue. These waits are blocking calls.
+ * @note LockFreeQueue provides the same blocking interface without a mutex and is preferred on hot paths.
  */
 template <typename T>
 class ThreadSafeQueue {
@@ -142,6 +144,221 @@ public:
     }
 };
 
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue.
+ *
+ * A ring buffer where every cell carries a sequence number telling whether it is ready to be written or read in the
+ * current lap (D. Vyukov's bounded MPMC queue). Producers and consumers only contend on their own position counter,
+ * so an uncontended push or pop is a single compare-and-swap.
+ *
+ * The blocking push and pop yield for a few attempts and then sleep on an atomic wait until the other side makes
+ * progress, so idle threads don't spin. Pushes and pops only touch the wait counters while somebody is blocked.
+ */
+template <typename T>
+class LockFreeQueue {
+    static constexpr auto kCACHE_LINE_SIZE = 64uz;
+    static constexpr auto kYIELD_ATTEMPTS = 16u;
+
+    struct alignas(kCACHE_LINE_SIZE) Cell {
+        std::atomic_size_t sequence;
+        std::optional<T> value;
+    };
+
+    std::size_t capacity_;
+    std::vector<Cell> cells_;
+
+    alignas(kCACHE_LINE_SIZE) std::atomic_size_t enqueuePos_ = 0;
+    alignas(kCACHE_LINE_SIZE) std::atomic_size_t dequeuePos_ = 0;
+
+    // a blocked consumer waits for pushes_ to change and a blocked producer for pops_
+    struct alignas(kCACHE_LINE_SIZE) WaitPoint {
+        std::atomic_uint32_t progress = 0;
+        std::atomic_uint32_t waiters = 0;
+
+        void
+        notify()
+        {
+            // pairs with the fence in waitFor(): either the waiter sees the new element or we see the waiter
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) == 0)
+                return;
+
+            progress.fetch_add(1, std::memory_order_release);
+            progress.notify_all();
+        }
+    };
+
+    WaitPoint pushes_;
+    WaitPoint pops_;
+
+public:
+    /**
+     * @brief Create an instance of the queue.
+     *
+     * @param maxSize maximum size of the queue. Calls that would cause the queue to exceed this size will block until
+     * free space is available. At least 2 elements are always allowed.
+     */
+    LockFreeQueue(std::size_t maxSize) : capacity_(std::max(maxSize, 2uz)), cells_(capacity_)
+    {
+        for (auto i = 0uz; i < capacity_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    LockFreeQueue(LockFreeQueue const&) = delete;
+    LockFreeQueue&
+    operator=(LockFreeQueue const&) = delete;
+
+    /**
+     * @brief Push element onto the queue.
+     *
+     * Note: This method will block until free space is available.
+     *
+     * @param elt Element to push onto queue
+     */
+    void
+    push(T const& elt)
+    {
+        waitFor(pops_, [&] { return tryEmplace(elt); });
+    }
+
+    /**
+     * @brief Push element onto the queue.
+     *
+     * Note: This method will block until free space is available
+     *
+     * @param elt Element to push onto queue. Ownership is transferred
+     */
+    void
+    push(T&& elt)
+    {
+        waitFor(pops_, [&] { return tryEmplace(std::move(elt)); });
+    }
+
+    /**
+     * @brief Attempt to push an element.
+     *
+     * @param elt Element to push onto queue. Only moved from if it was pushed
+     * @return true if the element was pushed; false if the queue was full
+     */
+    bool
+    tryPush(T&& elt)
+    {
+        return tryEmplace(std::move(elt));
+    }
+
+    /**
+     * @brief Pop element from the queue.
+     *
+     * Note: Will block until queue is non-empty.
+     *
+     * @return Element popped from queue
+     */
+    T
+    pop()
+    {
+        std::optional<T> ret;
+        waitFor(pushes_, [&] {
+            ret = tryPop();
+            return ret.has_value();
+        });
+
+        return std::move(ret).value();
+    }
+
+    /**
+     * @brief Attempt to pop an element.
+     *
+     * @return Element popped from queue or empty optional if queue was empty
+     */
+    std::optional<T>
+    tryPop()
+    {
+        auto pos = dequeuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells_[pos % capacity_];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+
+            if (sequence == pos + 1) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    std::optional<T> ret = std::move(cell.value);
+                    cell.value.reset();
+                    cell.sequence.store(pos + capacity_, std::memory_order_release);
+
+                    pops_.notify();
+                    return ret;
+                }
+            } else if (sequence < pos + 1) {
+                return std::nullopt;  // the cell was not written in this lap yet
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);  // another consumer took it
+            }
+        }
+    }
+
+    /**
+     * @brief Get the size of the queue
+     *
+     * @return The size of the queue; only approximate while other threads push or pop
+     */
+    std::size_t
+    size() const
+    {
+        auto const dequeuePos = dequeuePos_.load(std::memory_order_relaxed);
+        auto const enqueuePos = enqueuePos_.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+private:
+    template <typename U>
+    bool
+    tryEmplace(U&& elt)
+    {
+        auto pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells_[pos % capacity_];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+
+            if (sequence == pos) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value.emplace(std::forward<U>(elt));
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+
+                    pushes_.notify();
+                    return true;
+                }
+            } else if (sequence < pos) {
+                return false;  // the cell was not read in the previous lap yet
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);  // another producer took it
+            }
+        }
+    }
+
+    template <typename FnType>
+    static void
+    waitFor(WaitPoint& waitPoint, FnType&& tryOnce)
+    {
+        for (auto attempt = 0u; attempt < kYIELD_ATTEMPTS; ++attempt) {
+            if (tryOnce())
+                return;
+            std::this_thread::yield();
+        }
+
+        waitPoint.waiters.fetch_add(1, std::memory_order_relaxed);
+        while (true) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // read before trying so that progress made after a failed attempt wakes the wait below
+            auto const observed = waitPoint.progress.load(std::memory_order_acquire);
+            if (tryOnce())
+                break;
+
+            waitPoint.progress.wait(observed, std::memory_order_acquire);
+        }
+        waitPoint.waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
 /**
  * @brief Parititions the uint256 keyspace into numMarkers partitions, each of equal size.
  *
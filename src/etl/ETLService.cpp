@@ -23,6 +23,7 @@
 #include "data/LedgerCache.hpp"
 #include "etl/CorruptionDetector.hpp"
 #include "etl/NetworkValidatedLedgersInterface.hpp"
+#include "etl/impl/ExtractionController.hpp"
 #include "feed/SubscriptionManagerInterface.hpp"
 #include "util/Assert.hpp"
 #include "util/Constants.hpp"
@@ -69,7 +70,13 @@ ETLService::runETLPipeline(uint32_t startSequence, uint32_t numExtractors)
 
     auto const begin = std::chrono::system_clock::now();
     auto extractors = std::vector<std::unique_ptr<ExtractorType>>{};
-    auto pipe = DataPipeType{numExtractors, startSequence};
+    auto controllerSettings = std::optional<impl::ExtractionController::Settings>{};
+    if (adaptiveExtractorThreads_) {
+        controllerSettings = impl::ExtractionController::Settings{
+            .maxConcurrency = numExtractors, .writeLoad = [this] { return backend_->writeLoad(); }
+        };
+    }
+    auto pipe = DataPipeType{numExtractors, startSequence, std::move(controllerSettings)};
 
     for (auto i = 0u; i < numExtractors; ++i) {
         extractors.push_back(std::make_unique<ExtractorType>(
@@ -282,6 +289,7 @@ ETLService::ETLService(
     finishSequence_ = config.maybeValue<uint32_t>("finish_sequence");
     state_.isReadOnly = config.get<bool>("read_only");
     extractorThreads_ = config.get<uint32_t>("extractor_threads");
+    adaptiveExtractorThreads_ = config.get<bool>("adaptive_extractor_threads");
     txnThreshold_ = config.get<std::size_t>("txn_threshold");
 
     // This should probably be done in the backend factory but we don't have state available until here
@@ -27,6 +27,7 @@
 #include "etl/NetworkValidatedLedgersInterface.hpp"
 #include "etl/SystemState.hpp"
 #include "etl/impl/AmendmentBlockHandler.hpp"
+#include "etl/impl/ExtractionController.hpp"
 #include "etl/impl/ExtractionDataPipe.hpp"
 #include "etl/impl/Extractor.hpp"
 #include "etl/impl/LedgerFetcher.hpp"
@@ -103,6 +104,7 @@ class ETLService : public ETLServiceTag {
     std::shared_ptr<NetworkValidatedLedgersInterface> networkValidatedLedgers_;
 
     std::uint32_t extractorThreads_ = 1;
+    bool adaptiveExtractorThreads_ = false;
     std::thread worker_;
 
     CacheLoaderType cacheLoader_;
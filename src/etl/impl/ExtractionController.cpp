@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/ExtractionController.hpp"
+
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace etl::impl {
+
+namespace {
+
+// a step up must bring at least this share of the throughput it would bring if extraction scaled linearly
+constexpr double kMIN_STEP_GAIN = 0.5;
+
+constexpr std::array<std::string_view, 5> kBOTTLENECK_NAMES{"none", "extraction", "sources", "transformer", "database"};
+
+}  // namespace
+
+ExtractionController::ExtractionController(Settings settings, ClockType::time_point now)
+    : settings_{std::move(settings)}
+    , concurrency_{std::max(settings_.maxConcurrency, 1u)}
+    , nextUpdate_{now + settings_.interval}
+    , concurrencyGauge_{PrometheusService::gaugeInt(
+          "etl_extraction_concurrency",
+          util::prometheus::Labels{},
+          "Number of extractors allowed to fetch ledgers at the same time"
+      )}
+{
+    for (auto const name : kBOTTLENECK_NAMES) {
+        bottleneckGauges_.emplace_back(PrometheusService::gaugeInt(
+            "etl_extraction_bottleneck",
+            util::prometheus::Labels({{"stage", std::string{name}}}),
+            "1 for the pipeline stage that currently limits the ETL throughput; 0 otherwise"
+        ));
+    }
+
+    concurrencyGauge_.get().set(concurrency_);
+    setBottleneck(Bottleneck::None);
+}
+
+bool
+ExtractionController::shouldUpdate(ClockType::time_point now) const
+{
+    return now >= nextUpdate_;
+}
+
+std::uint32_t
+ExtractionController::update(Sample const& sample, ClockType::time_point now)
+{
+    nextUpdate_ = now + settings_.interval;
+
+    if (settings_.writeLoad and settings_.writeLoad() >= settings_.maxWriteLoad) {
+        stepDown(Bottleneck::Database);
+    } else if (sample.capacity > 0 and sample.queued >= sample.capacity / 4) {
+        stepDown(Bottleneck::Transformer);
+    } else if (sample.fetchLatency.count() == 0 or sample.queued >= concurrency_) {
+        // nothing was fetched to learn from, or extraction keeps up with the transformer
+        throughputBeforeStep_.reset();
+        setBottleneck(Bottleneck::None);
+    } else {
+        auto const throughput =
+            concurrency_ / std::chrono::duration_cast<std::chrono::duration<double>>(sample.fetchLatency).count();
+
+        if (throughputBeforeStep_.has_value() and
+            throughput < *throughputBeforeStep_ * (1.0 + (kMIN_STEP_GAIN / (concurrency_ - 1)))) {
+            --concurrency_;
+            throughputBeforeStep_.reset();
+            holdUntil_ = now + (kHOLD_INTERVALS * settings_.interval);
+            setBottleneck(Bottleneck::Sources);
+        } else if (now < holdUntil_) {
+            setBottleneck(Bottleneck::Sources);
+        } else if (concurrency_ < settings_.maxConcurrency) {
+            throughputBeforeStep_ = throughput;
+            ++concurrency_;
+            setBottleneck(Bottleneck::Extraction);
+        } else {
+            throughputBeforeStep_.reset();
+            setBottleneck(Bottleneck::Extraction);
+        }
+    }
+
+    concurrencyGauge_.get().set(concurrency_);
+    return concurrency_;
+}
+
+std::uint32_t
+ExtractionController::concurrency() const
+{
+    return concurrency_;
+}
+
+ExtractionController::Bottleneck
+ExtractionController::bottleneck() const
+{
+    return bottleneck_;
+}
+
+void
+ExtractionController::stepDown(Bottleneck bottleneck)
+{
+    throughputBeforeStep_.reset();
+    if (concurrency_ > 1)
+        --concurrency_;
+
+    setBottleneck(bottleneck);
+}
+
+void
+ExtractionController::setBottleneck(Bottleneck bottleneck)
+{
+    bottleneckGauges_[static_cast<std::size_t>(bottleneck_)].get().set(0);
+    bottleneck_ = bottleneck;
+    bottleneckGauges_[static_cast<std::size_t>(bottleneck_)].get().set(1);
+}
+
+}  // namespace etl::impl
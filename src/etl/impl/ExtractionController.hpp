@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Gauge.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace etl::impl {
+
+/**
+ * @brief Decides how many extractors may fetch ledgers from the ETL sources at the same time.
+ *
+ * Once per interval the controller looks at where ledgers pile up and moves the concurrency by one step:
+ * - The database is the bottleneck while most of its allowed outstanding writes are in use: step down.
+ * - The transformer is the bottleneck while many fetched ledgers wait in the pipe: step down.
+ * - The extraction is the bottleneck while the pipe is almost empty: step up. If the previous step up did not make
+ *   extraction noticeably faster the sources are the bottleneck instead; the step is undone and no new step up is
+ *   tried for a while.
+ *
+ * Extraction throughput is estimated from the fetch latency using Little's law: concurrency / latency.
+ *
+ * @note This class is not thread-safe; synchronisation is the responsibility of the owner.
+ */
+class ExtractionController {
+public:
+    using ClockType = std::chrono::steady_clock;
+
+    /**
+     * @brief The pipeline stage that limits the throughput
+     */
+    enum class Bottleneck : std::uint8_t { None, Extraction, Sources, Transformer, Database };
+
+    /**
+     * @brief The settings of the controller
+     */
+    struct Settings {
+        std::uint32_t maxConcurrency;
+        std::chrono::milliseconds interval{1000};
+        double maxWriteLoad = 0.9;                    ///< Write load above which the database is the bottleneck
+        std::function<double()> writeLoad = nullptr;  ///< Provides the share of allowed outstanding DB writes in use
+    };
+
+    /**
+     * @brief The state of the pipeline observed during the last interval
+     */
+    struct Sample {
+        std::size_t queued;                      ///< Number of fetched ledgers waiting for the transformer
+        std::size_t capacity;                    ///< Number of ledgers the pipe can hold
+        std::chrono::microseconds fetchLatency;  ///< Average time to fetch a ledger; 0 if nothing was fetched
+    };
+
+private:
+    static constexpr auto kHOLD_INTERVALS = 10;
+
+    Settings settings_;
+    std::uint32_t concurrency_;
+    Bottleneck bottleneck_ = Bottleneck::None;
+
+    ClockType::time_point nextUpdate_;
+    ClockType::time_point holdUntil_;
+    std::optional<double> throughputBeforeStep_;
+
+    std::reference_wrapper<util::prometheus::GaugeInt> concurrencyGauge_;
+    std::vector<std::reference_wrapper<util::prometheus::GaugeInt>> bottleneckGauges_;  // indexed by Bottleneck
+
+public:
+    /**
+     * @brief Construct a new controller, starting at the maximum concurrency
+     *
+     * @param settings The settings to use
+     * @param now The current time
+     */
+    explicit ExtractionController(Settings settings, ClockType::time_point now = ClockType::now());
+
+    /**
+     * @brief Check whether an interval has passed since the last update
+     *
+     * @param now The current time
+     * @return true if update should be called; false otherwise
+     */
+    [[nodiscard]] bool
+    shouldUpdate(ClockType::time_point now = ClockType::now()) const;
+
+    /**
+     * @brief Find the bottleneck in the given sample and adjust the concurrency
+     *
+     * @param sample The state of the pipeline during the last interval
+     * @param now The current time
+     * @return The new concurrency
+     */
+    std::uint32_t
+    update(Sample const& sample, ClockType::time_point now = ClockType::now());
+
+    /**
+     * @return The number of extractors that may fetch at the same time
+     */
+    [[nodiscard]] std::uint32_t
+    concurrency() const;
+
+    /**
+     * @return The bottleneck found by the last update
+     */
+    [[nodiscard]] Bottleneck
+    bottleneck() const;
+
+private:
+    void
+    stepDown(Bottleneck bottleneck);
+
+    void
+    setBottleneck(Bottleneck bottleneck);
+};
+
+}  // namespace etl::impl
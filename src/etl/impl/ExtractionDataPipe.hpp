@@ -20,24 +20,30 @@
 #pragma once
 
 #include "etl/ETLHelpers.hpp"
+#include "etl/impl/ExtractionController.hpp"
 #include "util/log/Logger.hpp"
 
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace etl::impl {
 
 /**
- * @brief A collection of thread safe async queues used by Extractor and Transformer to communicate
+ * @brief A collection of lock-free queues used by Extractor and Transformer to communicate
  */
 template <typename RawDataType>
 class ExtractionDataPipe {
 public:
     using DataType = std::optional<RawDataType>;
-    using QueueType = ThreadSafeQueue<DataType>;  // TODO: probably should use boost::lockfree::queue instead?
+    using QueueType = LockFreeQueue<DataType>;
 
     static constexpr auto kTOTAL_MAX_IN_QUEUE = 1000u;
 
@@ -48,19 +54,103 @@ private:
     uint32_t startSequence_;
 
     std::vector<std::shared_ptr<QueueType>> queues_;
+    std::size_t capacity_ = 0;
+
+    // limits the number of extractors fetching at the same time; only used with an adaptive concurrency
+    std::optional<ExtractionController> controller_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::set<uint32_t> waiting_;
+    uint32_t fetching_ = 0;
+    bool stopped_ = false;
+    std::chrono::microseconds fetchTime_{0};
+    std::size_t fetched_ = 0;
 
 public:
     /**
      * @brief Create a new instance of the extraction data pipe
      *
-     * @param stride
-     * @param startSequence
+     * @param stride The number of extractors; each one fetches every stride'th ledger
+     * @param startSequence The first sequence to extract
+     * @param controllerSettings If set, the number of extractors that fetch at the same time is adjusted to the load
      */
-    ExtractionDataPipe(uint32_t stride, uint32_t startSequence) : stride_{stride}, startSequence_{startSequence}
+    ExtractionDataPipe(
+        uint32_t stride,
+        uint32_t startSequence,
+        std::optional<ExtractionController::Settings> controllerSettings = std::nullopt
+    )
+        : stride_{stride}, startSequence_{startSequence}
     {
-        auto const maxQueueSize = kTOTAL_MAX_IN_QUEUE / stride;
+        // one more slot than the share of each queue so that the finish marker always fits
+        auto const maxQueueSize = (kTOTAL_MAX_IN_QUEUE / stride) + 1;
         for (size_t i = 0; i < stride_; ++i)
             queues_.push_back(std::make_unique<QueueType>(maxQueueSize));
+        capacity_ = maxQueueSize * stride_;
+
+        if (controllerSettings.has_value()) {
+            controllerSettings->maxConcurrency = stride_;
+            controller_.emplace(std::move(*controllerSettings));
+        }
+    }
+
+    /**
+     * @brief Wait until the extractor of the given sequence may fetch it from the sources.
+     *
+     * Without an adaptive concurrency this returns immediately. Otherwise, at most the current concurrency of
+     * extractors are fetching at the same time and the lowest waiting sequence goes first, because the transformer
+     * needs the ledgers in order. Every call must be followed by releaseFetchSlot once the fetch is done.
+     *
+     * @param sequence The sequence the extractor is about to fetch
+     */
+    void
+    waitForFetchSlot(uint32_t sequence)
+    {
+        if (not controller_.has_value())
+            return;
+
+        std::unique_lock lock{mutex_};
+        waiting_.insert(sequence);
+        cv_.wait(lock, [this, sequence] {
+            return stopped_ or (fetching_ < controller_->concurrency() and *waiting_.begin() == sequence);
+        });
+
+        waiting_.erase(sequence);
+        ++fetching_;
+        if (not waiting_.empty() and fetching_ < controller_->concurrency())
+            cv_.notify_all();
+    }
+
+    /**
+     * @brief Release the slot taken by waitForFetchSlot and let the controller adjust the concurrency if it is due
+     *
+     * @param fetchTime How long the fetch took
+     */
+    void
+    releaseFetchSlot(std::chrono::microseconds fetchTime)
+    {
+        if (not controller_.has_value())
+            return;
+
+        std::scoped_lock const lock{mutex_};
+        --fetching_;
+        fetchTime_ += fetchTime;
+        ++fetched_;
+
+        if (controller_->shouldUpdate()) {
+            auto const avgFetchTime = fetchTime_ / fetched_;
+            auto const before = controller_->concurrency();
+            auto const after =
+                controller_->update({.queued = size(), .capacity = capacity_, .fetchLatency = avgFetchTime});
+            if (before != after) {
+                LOG(log_.info()) << "Extraction concurrency changed from " << before << " to " << after
+                                 << "; avg fetch time = " << avgFetchTime.count() << "us";
+            }
+
+            fetchTime_ = std::chrono::microseconds{0};
+            fetched_ = 0;
+        }
+
+        cv_.notify_all();
     }
 
     /**
@@ -91,6 +181,18 @@ public:
         return getQueue(sequence)->pop();
     }
 
+    /**
+     * @return The approximate number of fetched ledgers waiting for the transformer
+     */
+    std::size_t
+    size() const
+    {
+        std::size_t total = 0;
+        for (auto const& queue : queues_)
+            total += queue->size();
+        return total;
+    }
+
     /**
      * @return Get the stride
      */
@@ -122,6 +224,12 @@ public:
         // TODO: this should not have to be called by hand. it should be done via RAII
         for (auto i = 0u; i < stride_; ++i)
             getQueue(i)->tryPop();  // pop from each queue that might be blocked on a push
+
+        if (controller_.has_value()) {
+            std::scoped_lock const lock{mutex_};
+            stopped_ = true;
+            cv_.notify_all();
+        }
     }
 
 private:
@@ -96,9 +96,13 @@ private:
 
         while (!shouldFinish(currentSequence) && networkValidatedLedgers_->waitUntilValidatedByNetwork(currentSequence)
         ) {
+            pipe_.get().waitForFetchSlot(currentSequence);
             auto [fetchResponse, time] = ::util::timed<std::chrono::duration<double>>([this, currentSequence]() {
                 return ledgerFetcher_.get().fetchDataAndDiff(currentSequence);
             });
+            pipe_.get().releaseFetchSlot(
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double>{time})
+            );
             totalTime += time;
 
             // if the fetch is unsuccessful, stop. fetchLedger only returns false if the server is shutting down, or
@@ -214,8 +214,7 @@ public:
                         object2.getFieldU32(ripple::sfTransactionIndex);
                 });
 
-                for (auto& txAndMeta : transactions)
-                    subscriptions_->pubTransaction(txAndMeta, lgrInfo);
+                subscriptions_->pubTransactions(transactions, lgrInfo);
 
                 subscriptions_->pubBookChanges(lgrInfo, transactions);
 
@@ -21,12 +21,28 @@
 
 #include "etlng/Models.hpp"
 #include "etlng/RegistryInterface.hpp"
+#include "util/Profiler.hpp"
+#include "util/async/AnyExecutionContext.hpp"
+#include "util/async/AnyOperation.hpp"
+#include "util/prometheus/Histogram.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 
 #include <xrpl/protocol/TxFormats.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -87,9 +103,84 @@ concept NoTwoOfKind = not(HasLedgerDataHook<T> and HasTransactionHook<T>) and
 template <typename T>
 concept SomeExtension = NoTwoOfKind<T> and ContainsValidHook<T>;
 
+/** @brief The extension lists the extensions that must be done before its hooks run, as a `std::tuple` of them */
+template <typename T>
+concept HasDependencies = requires { typename std::decay_t<T>::dependencies; };
+
+/** @brief The per-transaction and per-object hooks of the extension may be called concurrently */
+template <typename T>
+concept HasConcurrentHooks = std::decay_t<T>::kCONCURRENT_HOOKS;
+
+/** @brief The extension has a name used to label its metrics */
+template <typename T>
+concept HasName = requires {
+    { std::decay_t<T>::kNAME } -> std::convertible_to<std::string_view>;
+};
+
+/**
+ * @brief The length of the longest chain of dependencies of an extension.
+ *
+ * @note A circular dependency does not compile.
+ * @return 0 for an extension without dependencies; one more than the level of its deepest dependency otherwise
+ */
+template <typename T>
+constexpr std::size_t
+dependencyLevel()
+{
+    if constexpr (HasDependencies<T>) {
+        return []<typename... Ds>(std::type_identity<std::tuple<Ds...>>) {
+            return std::max({0uz, (dependencyLevel<Ds>() + 1)...});
+        }(std::type_identity<typename std::decay_t<T>::dependencies>{});
+    } else {
+        return 0uz;
+    }
+}
+
+template <typename T, typename... Rs>
+constexpr bool kIS_ONE_OF = (std::is_same_v<std::decay_t<T>, std::decay_t<Rs>> or ...);
+
+/**
+ * @brief Check that all dependencies of an extension are among the registered extensions.
+ *
+ * @return true if every dependency of T is one of Rs; false otherwise
+ */
+template <typename T, typename... Rs>
+constexpr bool
+dependenciesRegistered()
+{
+    if constexpr (HasDependencies<T>) {
+        return []<typename... Ds>(std::type_identity<std::tuple<Ds...>>) {
+            return (kIS_ONE_OF<Ds, Rs...> and ...);
+        }(std::type_identity<typename std::decay_t<T>::dependencies>{});
+    } else {
+        return true;
+    }
+}
+
+/**
+ * @brief Dispatches ledger data to a set of extensions.
+ *
+ * Without an execution context all hooks run on the calling thread: every kind of hook is called for all extensions
+ * before the next kind, in the order of registration.
+ *
+ * With an execution context the extensions are grouped by their dependency level. The groups run one after another
+ * and the extensions of a group run concurrently, each calling all of its hooks in the usual order. An extension
+ * that declares `kCONCURRENT_HOOKS` and runs alone in its group also gets its per-transaction and per-object hooks
+ * sharded across the workers for large ledgers. The calling thread takes part in the work, so it must not be a thread
+ * of the execution context.
+ *
+ * The time every extension spends in its hooks for each dispatch is reported to prometheus.
+ */
 template <SomeExtension... Ps>
 class Registry : public RegistryInterface {
+    static constexpr auto kMIN_SHARD_SIZE = 256uz;
+    static constexpr std::array<std::size_t, sizeof...(Ps)> kLEVELS{dependencyLevel<Ps>()...};
+    static constexpr auto kMAX_LEVEL = std::max({0uz, dependencyLevel<Ps>()...});
+
     std::tuple<Ps...> store_;
+    std::optional<util::async::AnyExecutionContext> ctx_;
+    std::size_t numWorkers_ = 1;
+    std::array<std::reference_wrapper<util::prometheus::HistogramInt>, sizeof...(Ps)> durations_;
 
     static_assert(
         (((not HasTransactionHook<std::decay_t<Ps>>) or ContainsSpec<std::decay_t<Ps>>) and ...),
@@ -101,10 +192,31 @@ class Registry : public RegistryInterface {
         "Spec must be specified when 'onInitialTransaction' function exists."
     );
 
+    static_assert(
+        (dependenciesRegistered<Ps, Ps...>() and ...),
+        "Dependencies of an extension must be registered too."
+    );
+
 public:
-    explicit constexpr Registry(SomeExtension auto&&... exts)
+    explicit Registry(SomeExtension auto&&... exts)
+        requires(std::is_same_v<std::decay_t<decltype(exts)>, std::decay_t<Ps>> and ...)
+        : store_(std::forward<Ps>(exts)...), durations_(makeDurationHistograms())
+    {
+    }
+
+    /**
+     * @brief Construct a registry that runs independent extensions concurrently.
+     *
+     * @param ctx The execution context to run the hooks on
+     * @param numWorkers The number of workers of the context; limits how many shards the hooks are split into
+     * @param exts The extensions
+     */
+    Registry(util::async::AnyExecutionContext ctx, std::size_t numWorkers, SomeExtension auto&&... exts)
         requires(std::is_same_v<std::decay_t<decltype(exts)>, std::decay_t<Ps>> and ...)
         : store_(std::forward<Ps>(exts)...)
+        , ctx_(std::move(ctx))
+        , numWorkers_(std::max(numWorkers, 1uz))
+        , durations_(makeDurationHistograms())
     {
     }
 
@@ -116,103 +228,203 @@ public:
     Registry&
     operator=(Registry&&) = default;
 
-    constexpr void
+    void
     dispatch(model::LedgerData const& data) override
     {
-        // send entire batch of data at once
-        {
-            auto const expand = [&](auto& p) {
+        run(
+            // send entire batch of data at once
+            [&](auto& p, bool) {
                 if constexpr (requires { p.onLedgerData(data); }) {
                     p.onLedgerData(data);
                 }
-            };
-
-            std::apply([&expand](auto&&... xs) { (expand(xs), ...); }, store_);
-        }
-
-        // send filtered transactions
-        {
-            auto const expand = [&]<typename P>(P& p, model::Transaction const& t) {
-                if constexpr (requires { p.onTransaction(data.seq, t); }) {
-                    if (std::decay_t<P>::spec::wants(t.type))
-                        p.onTransaction(data.seq, t);
+            },
+            // send filtered transactions
+            [&]<typename P>(P& p, bool canShard) {
+                if constexpr (requires(model::Transaction const& t) { p.onTransaction(data.seq, t); }) {
+                    forEachItem<P>(std::span{data.transactions}, canShard, [&](model::Transaction const& t) {
+                        if (std::decay_t<P>::spec::wants(t.type))
+                            p.onTransaction(data.seq, t);
+                    });
                 }
-            };
-
-            for (auto const& t : data.transactions) {
-                std::apply([&expand, &t](auto&&... xs) { (expand(xs, t), ...); }, store_);
-            }
-        }
-
-        // send per object path
-        {
-            auto const expand = [&]<typename P>(P&& p, model::Object const& o) {
-                if constexpr (requires { p.onObject(data.seq, o); }) {
-                    p.onObject(data.seq, o);
+            },
+            // send per object path
+            [&]<typename P>(P& p, bool canShard) {
+                if constexpr (requires(model::Object const& o) { p.onObject(data.seq, o); }) {
+                    forEachItem<P>(std::span{data.objects}, canShard, [&](model::Object const& o) {
+                        p.onObject(data.seq, o);
+                    });
                 }
-            };
-
-            for (auto const& obj : data.objects) {
-                std::apply([&expand, &obj](auto&&... xs) { (expand(xs, obj), ...); }, store_);
             }
-        }
+        );
     }
 
-    constexpr void
+    void
     dispatchInitialObjects(uint32_t seq, std::vector<model::Object> const& data, std::string lastKey) override
     {
-        // send entire vector path
-        {
-            auto const expand = [&](auto&& p) {
+        run(
+            // send entire vector path
+            [&](auto& p, bool) {
                 if constexpr (requires { p.onInitialObjects(seq, data, lastKey); }) {
                     p.onInitialObjects(seq, data, lastKey);
                 }
-            };
-
-            std::apply([&expand](auto&&... xs) { (expand(xs), ...); }, store_);
-        }
-
-        // send per object path
-        {
-            auto const expand = [&]<typename P>(P&& p, model::Object const& o) {
-                if constexpr (requires { p.onInitialObject(seq, o); }) {
-                    p.onInitialObject(seq, o);
+            },
+            // send per object path
+            [&]<typename P>(P& p, bool canShard) {
+                if constexpr (requires(model::Object const& o) { p.onInitialObject(seq, o); }) {
+                    forEachItem<P>(std::span{data}, canShard, [&](model::Object const& o) {
+                        p.onInitialObject(seq, o);
+                    });
                 }
-            };
-
-            for (auto const& obj : data) {
-                std::apply([&expand, &obj](auto&&... xs) { (expand(xs, obj), ...); }, store_);
             }
-        }
+        );
     }
 
-    constexpr void
+    void
     dispatchInitialData(model::LedgerData const& data) override
     {
-        // send entire batch path
-        {
-            auto const expand = [&](auto&& p) {
+        run(
+            // send entire batch path
+            [&](auto& p, bool) {
                 if constexpr (requires { p.onInitialData(data); }) {
                     p.onInitialData(data);
                 }
+            },
+            // send per tx path
+            [&]<typename P>(P& p, bool canShard) {
+                if constexpr (requires(model::Transaction const& t) { p.onInitialTransaction(data.seq, t); }) {
+                    forEachItem<P>(std::span{data.transactions}, canShard, [&](model::Transaction const& tx) {
+                        if (std::decay_t<P>::spec::wants(tx.type))
+                            p.onInitialTransaction(data.seq, tx);
+                    });
+                }
+            }
+        );
+    }
+
+private:
+    static std::array<std::reference_wrapper<util::prometheus::HistogramInt>, sizeof...(Ps)>
+    makeDurationHistograms()
+    {
+        static std::vector<std::int64_t> const kHISTOGRAM_BUCKETS{10, 100, 1'000, 10'000, 100'000, 1'000'000};
+
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::array<std::reference_wrapper<util::prometheus::HistogramInt>, sizeof...(Ps)>{
+                std::ref(PrometheusService::histogramInt(
+                    "etl_extension_duration_microseconds_histogram",
+                    util::prometheus::Labels({util::prometheus::Label{"extension", extensionName<Ps>(Is)}}),
+                    kHISTOGRAM_BUCKETS,
+                    "The time an ETL extension spends in its hooks for one ledger"
+                ))...
             };
+        }(std::index_sequence_for<Ps...>{});
+    }
 
-            std::apply([&expand](auto&&... xs) { (expand(xs), ...); }, store_);
+    template <typename P>
+    static std::string
+    extensionName(std::size_t index)
+    {
+        if constexpr (HasName<P>) {
+            return std::string{std::decay_t<P>::kNAME};
+        } else {
+            return "extension_" + std::to_string(index);
         }
+    }
 
-        // send per tx path
-        {
-            auto const expand = [&]<typename P>(P&& p, model::Transaction const& tx) {
-                if constexpr (requires { p.onInitialTransaction(data.seq, tx); }) {
-                    if (std::decay_t<P>::spec::wants(tx.type))
-                        p.onInitialTransaction(data.seq, tx);
-                }
+    template <typename FnType>
+    void
+    forEachExtension(FnType const& fn)
+    {
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (fn(std::get<Is>(store_), Is), ...);
+        }(std::index_sequence_for<Ps...>{});
+    }
+
+    void
+    run(auto const&... hooks)
+    {
+        std::array<std::int64_t, sizeof...(Ps)> durations{};
+
+        if (not ctx_.has_value()) {
+            auto const runForAll = [&](auto const& hook) {
+                forEachExtension([&](auto& p, std::size_t index) {
+                    durations[index] += util::timed<std::chrono::microseconds>([&] { hook(p, false); });
+                });
             };
+            (runForAll(hooks), ...);
+        } else {
+            for (auto level = 0uz; level <= kMAX_LEVEL; ++level) {
+                std::vector<std::function<void(bool)>> jobs;
+                forEachExtension([&](auto& p, std::size_t index) {
+                    if (kLEVELS[index] != level)
+                        return;
+
+                    jobs.emplace_back([&p, &durations, &hooks..., index](bool canShard) {
+                        durations[index] +=
+                            util::timed<std::chrono::microseconds>([&] { (hooks(p, canShard), ...); });
+                    });
+                });
+
+                // sharding the hooks of an extension that runs next to others could leave the workers waiting on
+                // each other, so only an extension that has its level to itself is sharded
+                auto const canShard = jobs.size() == 1;
+                runConcurrently(jobs.size(), [&](std::size_t i) { jobs[i](canShard); });
+            }
+        }
 
-            for (auto const& tx : data.transactions) {
-                std::apply([&expand, &tx](auto&&... xs) { (expand(xs, tx), ...); }, store_);
+        for (auto i = 0uz; i < durations.size(); ++i)
+            durations_[i].get().observe(durations[i]);
+    }
+
+    template <typename P>
+    void
+    forEachItem(auto items, bool canShard, auto const& fn)
+    {
+        if constexpr (HasConcurrentHooks<P>) {
+            if (canShard and ctx_.has_value() and items.size() >= 2 * kMIN_SHARD_SIZE) {
+                auto const numShards = std::min(numWorkers_, items.size() / kMIN_SHARD_SIZE);
+                auto const shardSize = (items.size() + numShards - 1) / numShards;
+
+                runConcurrently(numShards, [&](std::size_t shard) {
+                    auto const first = shard * shardSize;
+                    std::ranges::for_each(items.subspan(first, std::min(shardSize, items.size() - first)), fn);
+                });
+                return;
             }
         }
+
+        std::ranges::for_each(items, fn);
+    }
+
+    // Runs the first job on the calling thread and the rest on the execution context
+    void
+    runConcurrently(std::size_t numJobs, auto const& job)
+    {
+        if (numJobs == 0)
+            return;
+
+        std::vector<util::async::AnyOperation<void>> operations;
+        operations.reserve(numJobs - 1);
+        for (auto i = 1uz; i < numJobs; ++i)
+            operations.push_back(ctx_->execute([&job, i] { job(i); }));
+
+        std::exception_ptr error;
+        try {
+            job(0);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        // the jobs refer to the caller's data so all of them have to finish before anything is rethrown
+        for (auto& operation : operations)
+            operation.wait();
+
+        if (error)
+            std::rethrow_exception(error);
+
+        for (auto& operation : operations) {
+            if (auto const res = operation.get(); not res.has_value())
+                throw std::runtime_error(res.error().message);
+        }
     }
 };
 
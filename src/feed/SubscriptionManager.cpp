@@ -194,6 +194,15 @@ SubscriptionManager::pubTransaction(data::TransactionAndMetadata const& txMeta,
     transactionFeed_.pub(txMeta, lgrInfo, backend_);
 }
 
+void
+SubscriptionManager::pubTransactions(
+    std::vector<data::TransactionAndMetadata> const& transactions,
+    ripple::LedgerHeader const& lgrInfo
+)
+{
+    transactionFeed_.pub(transactions, lgrInfo, backend_);
+}
+
 boost::json::object
 SubscriptionManager::report() const
 {
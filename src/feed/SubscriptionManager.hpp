@@ -42,6 +42,7 @@
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -87,7 +88,9 @@ public:
         util::Logger const logger{"Subscriptions"};
         LOG(logger.info()) << "Starting subscription manager with " << workersNum << " workers";
 
-        return std::make_shared<feed::SubscriptionManager>(util::async::PoolExecutionContext(workersNum), backend);
+        return std::make_shared<feed::SubscriptionManager>(
+            util::async::PoolExecutionContext(workersNum), backend, workersNum
+        );
     }
 
     /**
@@ -95,10 +98,12 @@ public:
      *
      * @param executor The executor to use to publish the feeds
      * @param backend The backend to use
+     * @param numPublishShards The number of strands the transactions feed fans out to its subscribers on
      */
     SubscriptionManager(
         util::async::AnyExecutionContext&& executor,
-        std::shared_ptr<data::BackendInterface const> const& backend
+        std::shared_ptr<data::BackendInterface const> const& backend,
+        std::size_t numPublishShards = 1
     )
         : backend_(backend)
         , ctx_(std::move(executor))
@@ -106,7 +111,7 @@ public:
         , validationsFeed_(ctx_, "validations")
         , ledgerFeed_(ctx_)
         , bookChangesFeed_(ctx_)
-        , transactionFeed_(ctx_)
+        , transactionFeed_(ctx_, numPublishShards)
         , proposedTransactionFeed_(ctx_)
     {
     }
@@ -316,6 +321,20 @@ public:
     void
     pubTransaction(data::TransactionAndMetadata const& txMeta, ripple::LedgerHeader const& lgrInfo) final;
 
+    /**
+     * @brief Forward all the transactions of a ledger to the transactions feed.
+     *
+     * The owner funds of the OfferCreate transactions are fetched in one batch for the whole ledger.
+     *
+     * @param transactions The transactions and metadata, in the order they should be published.
+     * @param lgrInfo The ledger header.
+     */
+    void
+    pubTransactions(
+        std::vector<data::TransactionAndMetadata> const& transactions,
+        ripple::LedgerHeader const& lgrInfo
+    ) final;
+
     /**
      * @brief Get the number of subscribers.
      *
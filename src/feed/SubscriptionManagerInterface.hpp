@@ -241,6 +241,17 @@ public:
     virtual void
     pubTransaction(data::TransactionAndMetadata const& txMeta, ripple::LedgerHeader const& lgrInfo) = 0;
 
+    /**
+     * @brief Forward all the transactions of a ledger to the transactions feed.
+     * @param transactions The transactions and metadata, in the order they should be published.
+     * @param lgrInfo The ledger header.
+     */
+    virtual void
+    pubTransactions(
+        std::vector<data::TransactionAndMetadata> const& transactions,
+        ripple::LedgerHeader const& lgrInfo
+    ) = 0;
+
     /**
      * @brief Get the number of subscribers.
      *
@@ -106,5 +106,19 @@ public:
         if (map->contains(key))
             map->operator[](key).emit(args...);
     }
+
+    /**
+     * @brief Check whether any slot is connected to the signal with the given key.
+     *
+     * @param key The key to the signal.
+     * @return true if at least one slot is connected, false otherwise.
+     */
+    bool
+    hasSlots(Key const& key) const
+    {
+        auto map = signalsMap_.template lock<std::scoped_lock>();
+        auto const it = map->find(key);
+        return it != map->end() and it->second.count() > 0;
+    }
 };
 }  // namespace feed::impl
@@ -36,42 +36,147 @@
 #include <xrpl/protocol/LedgerFormats.h>
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STAmount.h>
 #include <xrpl/protocol/STObject.h>
+#include <xrpl/protocol/STTx.h>
 #include <xrpl/protocol/TER.h>
 #include <xrpl/protocol/TxFormats.h>
+#include <xrpl/protocol/TxMeta.h>
 #include <xrpl/protocol/jss.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace feed::impl {
 
+namespace {
+
+std::unordered_set<ripple::Book>
+getAffectedBooks(ripple::TxMeta const& meta)
+{
+    std::unordered_set<ripple::Book> affectedBooks;
+
+    for (auto const& node : meta.getNodes()) {
+        if (node.getFieldU16(ripple::sfLedgerEntryType) == ripple::ltOFFER) {
+            ripple::SField const* field = nullptr;
+
+            // We need a field that contains the TakerGets and TakerPays
+            // parameters.
+            if (node.getFName() == ripple::sfModifiedNode) {
+                field = &ripple::sfPreviousFields;
+            } else if (node.getFName() == ripple::sfCreatedNode) {
+                field = &ripple::sfNewFields;
+            } else if (node.getFName() == ripple::sfDeletedNode) {
+                field = &ripple::sfFinalFields;
+            }
+
+            if (field != nullptr) {
+                auto const data = dynamic_cast<ripple::STObject const*>(node.peekAtPField(*field));
+
+                if ((data != nullptr) && data->isFieldPresent(ripple::sfTakerPays) &&
+                    data->isFieldPresent(ripple::sfTakerGets)) {
+                    // determine the OrderBook
+                    ripple::Book const book{
+                        data->getFieldAmount(ripple::sfTakerGets).issue(),
+                        data->getFieldAmount(ripple::sfTakerPays).issue()
+                    };
+                    if (affectedBooks.find(book) == affectedBooks.end()) {
+                        affectedBooks.insert(book);
+                    }
+                }
+            }
+        }
+    }
+
+    return affectedBooks;
+}
+
+}  // namespace
+
+std::shared_ptr<std::string> const&
+TransactionFeed::TransactionMessages::get(std::uint32_t apiVersion) const
+{
+    auto const version = apiVersion < 2u ? 1u : 2u;
+    auto& message = messages_[version - 1];
+    std::call_once(generated_[version - 1], [&] {
+        message = std::make_shared<std::string>(boost::json::serialize(generate_(version)));
+    });
+    return message;
+}
+
 void
 TransactionFeed::TransactionSlot::operator()(AllVersionTransactionsType const& allVersionMsgs) const
 {
     if (auto connection = subscriptionContextWeakPtr.lock(); connection) {
         // Check if this connection already sent
-        if (feed.get().notified_.contains(connection.get()))
+        if (shard.get().notified.contains(connection.get()))
             return;
 
-        feed.get().notified_.insert(connection.get());
+        shard.get().notified.insert(connection.get());
+        connection->send(allVersionMsgs.get(connection->apiSubversion()));
+    }
+}
 
-        if (connection->apiSubversion() < 2u) {
-            connection->send(allVersionMsgs[0]);
-            return;
-        }
-        connection->send(allVersionMsgs[1]);
+bool
+TransactionFeed::Shard::hasSubscribers(
+    std::unordered_set<ripple::AccountID> const& affectedAccounts,
+    std::unordered_set<ripple::Book> const& affectedBooks
+) const
+{
+    if (signal.count() > 0 or txProposedSignal.count() > 0)
+        return true;
+
+    auto const accountHasSubscribers = [this](ripple::AccountID const& account) {
+        return accountSignal.hasSlots(account) or accountProposedSignal.hasSlots(account);
+    };
+    auto const bookHasSubscribers = [this](ripple::Book const& book) { return bookSignal.hasSlots(book); };
+
+    return std::ranges::any_of(affectedAccounts, accountHasSubscribers) or
+        std::ranges::any_of(affectedBooks, bookHasSubscribers);
+}
+
+void
+TransactionFeed::Shard::emit(
+    AllVersionTransactionsType const& allVersionMsgs,
+    std::unordered_set<ripple::AccountID> const& affectedAccounts,
+    std::unordered_set<ripple::Book> const& affectedBooks
+)
+{
+    notified.clear();
+    signal.emit(allVersionMsgs);
+    // clear the notified set. If the same connection subscribes both transactions + proposed_transactions,
+    // rippled SENDS the same message twice
+    notified.clear();
+    txProposedSignal.emit(allVersionMsgs);
+    notified.clear();
+    // check duplicate for account and proposed_account, this prevents sending the same message multiple times
+    // if it affects multiple accounts watched by the same connection
+    for (auto const& account : affectedAccounts) {
+        accountSignal.emit(account, allVersionMsgs);
+        accountProposedSignal.emit(account, allVersionMsgs);
+    }
+    notified.clear();
+    // check duplicate for books, this prevents sending the same message multiple times if it affects multiple
+    // books watched by the same connection
+    for (auto const& book : affectedBooks) {
+        bookSignal.emit(book, allVersionMsgs);
     }
 }
 
 void
 TransactionFeed::sub(SubscriberSharedPtr const& subscriber)
 {
-    auto const added = signal_.connectTrackableSlot(subscriber, TransactionSlot(*this, subscriber));
+    auto& shard = shardFor(subscriber.get());
+    auto const added = shard.signal.connectTrackableSlot(subscriber, TransactionSlot(shard, subscriber));
     if (added) {
         LOG(logger_.info()) << subscriber->tag() << "Subscribed transactions";
         ++subAllCount_.get();
@@ -82,7 +187,9 @@ TransactionFeed::sub(SubscriberSharedPtr const& subscriber)
 void
 TransactionFeed::sub(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
-    auto const added = accountSignal_.connectTrackableSlot(subscriber, account, TransactionSlot(*this, subscriber));
+    auto& shard = shardFor(subscriber.get());
+    auto const added =
+        shard.accountSignal.connectTrackableSlot(subscriber, account, TransactionSlot(shard, subscriber));
     if (added) {
         LOG(logger_.info()) << subscriber->tag() << "Subscribed account " << account;
         ++subAccountCount_.get();
@@ -93,7 +200,8 @@ TransactionFeed::sub(ripple::AccountID const& account, SubscriberSharedPtr const
 void
 TransactionFeed::subProposed(SubscriberSharedPtr const& subscriber)
 {
-    auto const added = txProposedSignal_.connectTrackableSlot(subscriber, TransactionSlot(*this, subscriber));
+    auto& shard = shardFor(subscriber.get());
+    auto const added = shard.txProposedSignal.connectTrackableSlot(subscriber, TransactionSlot(shard, subscriber));
     if (added) {
         subscriber->onDisconnect([this](SubscriberPtr connection) { unsubProposedInternal(connection); });
     }
@@ -102,8 +210,9 @@ TransactionFeed::subProposed(SubscriberSharedPtr const& subscriber)
 void
 TransactionFeed::subProposed(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
+    auto& shard = shardFor(subscriber.get());
     auto const added =
-        accountProposedSignal_.connectTrackableSlot(subscriber, account, TransactionSlot(*this, subscriber));
+        shard.accountProposedSignal.connectTrackableSlot(subscriber, account, TransactionSlot(shard, subscriber));
     if (added) {
         subscriber->onDisconnect([this, account](SubscriberPtr connection) {
             unsubProposedInternal(account, connection);
@@ -114,7 +223,8 @@ TransactionFeed::subProposed(ripple::AccountID const& account, SubscriberSharedP
 void
 TransactionFeed::sub(ripple::Book const& book, SubscriberSharedPtr const& subscriber)
 {
-    auto const added = bookSignal_.connectTrackableSlot(subscriber, book, TransactionSlot(*this, subscriber));
+    auto& shard = shardFor(subscriber.get());
+    auto const added = shard.bookSignal.connectTrackableSlot(subscriber, book, TransactionSlot(shard, subscriber));
     if (added) {
         LOG(logger_.info()) << subscriber->tag() << "Subscribed book " << book;
         ++subBookCount_.get();
@@ -177,46 +287,102 @@ TransactionFeed::pub(
     std::shared_ptr<data::BackendInterface const> const& backend
 )
 {
-    auto [tx, meta] = rpc::deserializeTxPlusMeta(txMeta, lgrInfo.seq);
-
-    std::optional<ripple::STAmount> ownerFunds;
-
-    if (tx->getTxnType() == ripple::ttOFFER_CREATE) {
-        auto const account = tx->getAccountID(ripple::sfAccount);
-        auto const amount = tx->getFieldAmount(ripple::sfTakerGets);
-        if (account != amount.issue().account) {
-            auto fetchFundsSynchronous = [&]() {
-                data::synchronous([&](boost::asio::yield_context yield) {
-                    ownerFunds = rpc::accountFunds(*backend, lgrInfo.seq, amount, account, yield);
-                });
-            };
-            data::retryOnTimeout(fetchFundsSynchronous);
+    pub(std::span{&txMeta, 1uz}, lgrInfo, backend);
+}
+
+void
+TransactionFeed::pub(
+    std::span<data::TransactionAndMetadata const> transactions,
+    ripple::LedgerHeader const& lgrInfo,
+    std::shared_ptr<data::BackendInterface const> const& backend
+)
+{
+    std::vector<PendingTransaction> pending;
+    pending.reserve(transactions.size());
+
+    // offers whose owner funds are needed and the index of their transaction in pending
+    std::vector<std::pair<ripple::AccountID, ripple::STAmount>> offerOwners;
+    std::vector<std::size_t> offerIndexes;
+
+    for (auto const& txMeta : transactions) {
+        auto [tx, meta] = rpc::deserializeTxPlusMeta(txMeta, lgrInfo.seq);
+
+        auto const affectedAccountsFlat = meta->getAffectedAccounts();
+        auto affectedAccounts =
+            std::unordered_set<ripple::AccountID>(affectedAccountsFlat.cbegin(), affectedAccountsFlat.cend());
+        auto affectedBooks = getAffectedBooks(*meta);
+
+        // nothing below is needed if no one listens to this transaction
+        if (not hasSubscribers(affectedAccounts, affectedBooks))
+            continue;
+
+        if (tx->getTxnType() == ripple::ttOFFER_CREATE) {
+            auto const account = tx->getAccountID(ripple::sfAccount);
+            auto const amount = tx->getFieldAmount(ripple::sfTakerGets);
+            if (account != amount.issue().account) {
+                offerOwners.emplace_back(account, amount);
+                offerIndexes.push_back(pending.size());
+            }
         }
+
+        pending.push_back(
+            PendingTransaction{
+                .tx = std::move(tx),
+                .meta = std::move(meta),
+                .date = txMeta.date,
+                .affectedAccounts = std::move(affectedAccounts),
+                .affectedBooks = std::move(affectedBooks),
+                .ownerFunds = std::nullopt
+            }
+        );
     }
 
-    auto const genJsonByVersion = [&, tx, meta](std::uint32_t version) {
+    if (not offerOwners.empty()) {
+        auto const funds = data::synchronousAndRetryOnTimeout([&](boost::asio::yield_context yield) {
+            return rpc::accountFunds(*backend, lgrInfo.seq, offerOwners, yield);
+        });
+
+        for (auto i = 0uz; i < offerIndexes.size(); ++i)
+            pending[offerIndexes[i]].ownerFunds = funds[i];
+    }
+
+    for (auto& transaction : pending)
+        pubInternal(std::move(transaction), lgrInfo);
+}
+
+void
+TransactionFeed::pubInternal(PendingTransaction pending, ripple::LedgerHeader const& lgrInfo)
+{
+    // the messages are generated later on the strand of the feed, so everything is captured by value
+    auto genJsonByVersion = [tx = pending.tx,
+                             meta = pending.meta,
+                             date = pending.date,
+                             seq = lgrInfo.seq,
+                             hash = lgrInfo.hash,
+                             closeTime = lgrInfo.closeTime,
+                             ownerFunds = std::move(pending.ownerFunds)](std::uint32_t version) {
         boost::json::object pubObj;
         auto const txKey = version < 2u ? JS(transaction) : JS(tx_json);
         pubObj[txKey] = rpc::toJson(*tx);
         pubObj[JS(meta)] = rpc::toJson(*meta);
-        rpc::insertDeliveredAmount(pubObj[JS(meta)].as_object(), tx, meta, txMeta.date);
+        rpc::insertDeliveredAmount(pubObj[JS(meta)].as_object(), tx, meta, date);
         rpc::insertDeliverMaxAlias(pubObj[txKey].as_object(), version);
         rpc::insertMPTIssuanceID(pubObj[JS(meta)].as_object(), tx, meta);
 
         pubObj[JS(type)] = "transaction";
         pubObj[JS(validated)] = true;
         pubObj[JS(status)] = "closed";
-        pubObj[JS(close_time_iso)] = ripple::to_string_iso(lgrInfo.closeTime);
+        pubObj[JS(close_time_iso)] = ripple::to_string_iso(closeTime);
 
-        pubObj[JS(ledger_index)] = lgrInfo.seq;
-        pubObj[JS(ledger_hash)] = ripple::strHex(lgrInfo.hash);
+        pubObj[JS(ledger_index)] = seq;
+        pubObj[JS(ledger_hash)] = ripple::strHex(hash);
         if (version >= 2u) {
             if (pubObj[txKey].as_object().contains(JS(hash))) {
                 pubObj[JS(hash)] = pubObj[txKey].as_object()[JS(hash)];
                 pubObj[txKey].as_object().erase(JS(hash));
             }
         }
-        pubObj[txKey].as_object()[JS(date)] = lgrInfo.closeTime.time_since_epoch().count();
+        pubObj[txKey].as_object()[JS(date)] = closeTime.time_since_epoch().count();
 
         pubObj[JS(engine_result_code)] = meta->getResult();
         std::string token;
@@ -231,79 +397,42 @@ TransactionFeed::pub(
         return pubObj;
     };
 
-    AllVersionTransactionsType allVersionsMsgs{
-        std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(1u))),
-        std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(2u)))
-    };
-
-    auto const affectedAccountsFlat = meta->getAffectedAccounts();
-    auto affectedAccounts =
-        std::unordered_set<ripple::AccountID>(affectedAccountsFlat.cbegin(), affectedAccountsFlat.cend());
-
-    std::unordered_set<ripple::Book> affectedBooks;
-
-    for (auto const& node : meta->getNodes()) {
-        if (node.getFieldU16(ripple::sfLedgerEntryType) == ripple::ltOFFER) {
-            ripple::SField const* field = nullptr;
-
-            // We need a field that contains the TakerGets and TakerPays
-            // parameters.
-            if (node.getFName() == ripple::sfModifiedNode) {
-                field = &ripple::sfPreviousFields;
-            } else if (node.getFName() == ripple::sfCreatedNode) {
-                field = &ripple::sfNewFields;
-            } else if (node.getFName() == ripple::sfDeletedNode) {
-                field = &ripple::sfFinalFields;
-            }
+    auto const allVersionsMsgs = std::make_shared<AllVersionTransactionsType const>(std::move(genJsonByVersion));
+    auto const transaction = std::make_shared<PendingTransaction const>(std::move(pending));
 
-            if (field != nullptr) {
-                auto const data = dynamic_cast<ripple::STObject const*>(node.peekAtPField(*field));
+    for (auto const& shard : shards_) {
+        if (not shard->hasSubscribers(transaction->affectedAccounts, transaction->affectedBooks))
+            continue;
 
-                if ((data != nullptr) && data->isFieldPresent(ripple::sfTakerPays) &&
-                    data->isFieldPresent(ripple::sfTakerGets)) {
-                    // determine the OrderBook
-                    ripple::Book const book{
-                        data->getFieldAmount(ripple::sfTakerGets).issue(),
-                        data->getFieldAmount(ripple::sfTakerPays).issue()
-                    };
-                    if (affectedBooks.find(book) == affectedBooks.end()) {
-                        affectedBooks.insert(book);
-                    }
-                }
-            }
-        }
+        [[maybe_unused]] auto task = shard->strand.execute([shard = shard.get(), allVersionsMsgs, transaction]() {
+            shard->emit(*allVersionsMsgs, transaction->affectedAccounts, transaction->affectedBooks);
+        });
     }
+}
 
-    [[maybe_unused]] auto task = strand_.execute([this,
-                                                  allVersionsMsgs = std::move(allVersionsMsgs),
-                                                  affectedAccounts = std::move(affectedAccounts),
-                                                  affectedBooks = std::move(affectedBooks)]() {
-        notified_.clear();
-        signal_.emit(allVersionsMsgs);
-        // clear the notified set. If the same connection subscribes both transactions + proposed_transactions,
-        // rippled SENDS the same message twice
-        notified_.clear();
-        txProposedSignal_.emit(allVersionsMsgs);
-        notified_.clear();
-        // check duplicate for account and proposed_account, this prevents sending the same message multiple times
-        // if it affects multiple accounts watched by the same connection
-        for (auto const& account : affectedAccounts) {
-            accountSignal_.emit(account, allVersionsMsgs);
-            accountProposedSignal_.emit(account, allVersionsMsgs);
-        }
-        notified_.clear();
-        // check duplicate for books, this prevents sending the same message multiple times if it affects multiple
-        // books watched by the same connection
-        for (auto const& book : affectedBooks) {
-            bookSignal_.emit(book, allVersionsMsgs);
-        }
+TransactionFeed::Shard&
+TransactionFeed::shardFor(SubscriberPtr subscriber) const
+{
+    // pointers are aligned so their lowest bits carry no information
+    auto const value = reinterpret_cast<std::uintptr_t>(subscriber) >> 4u;
+    return *shards_[value % shards_.size()];
+}
+
+bool
+TransactionFeed::hasSubscribers(
+    std::unordered_set<ripple::AccountID> const& affectedAccounts,
+    std::unordered_set<ripple::Book> const& affectedBooks
+) const
+{
+    return std::ranges::any_of(shards_, [&](auto const& shard) {
+        return shard->hasSubscribers(affectedAccounts, affectedBooks);
     });
 }
 
 void
 TransactionFeed::unsubInternal(SubscriberPtr subscriber)
 {
-    if (signal_.disconnect(subscriber)) {
+    if (shardFor(subscriber).signal.disconnect(subscriber)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed transactions";
         --subAllCount_.get();
     }
@@ -312,7 +441,7 @@ TransactionFeed::unsubInternal(SubscriberPtr subscriber)
 void
 TransactionFeed::unsubInternal(ripple::AccountID const& account, SubscriberPtr subscriber)
 {
-    if (accountSignal_.disconnect(subscriber, account)) {
+    if (shardFor(subscriber).accountSignal.disconnect(subscriber, account)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed account " << account;
         --subAccountCount_.get();
     }
@@ -321,19 +450,19 @@ TransactionFeed::unsubInternal(ripple::AccountID const& account, SubscriberPtr s
 void
 TransactionFeed::unsubProposedInternal(SubscriberPtr subscriber)
 {
-    txProposedSignal_.disconnect(subscriber);
+    shardFor(subscriber).txProposedSignal.disconnect(subscriber);
 }
 
 void
 TransactionFeed::unsubProposedInternal(ripple::AccountID const& account, SubscriberPtr subscriber)
 {
-    accountProposedSignal_.disconnect(subscriber, account);
+    shardFor(subscriber).accountProposedSignal.disconnect(subscriber, account);
 }
 
 void
 TransactionFeed::unsubInternal(ripple::Book const& book, SubscriberPtr subscriber)
 {
-    if (bookSignal_.disconnect(subscriber, book)) {
+    if (shardFor(subscriber).bookSignal.disconnect(subscriber, book)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed book " << book;
         --subBookCount_.get();
     }
@@ -32,30 +32,71 @@
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/json/object.hpp>
 #include <fmt/core.h>
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Book.h>
 #include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/STTx.h>
+#include <xrpl/protocol/TxMeta.h>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace feed::impl {
 
+/**
+ * @brief Feed of validated transactions.
+ *
+ * Subscribers are partitioned by their pointer across a number of shards. Each shard owns the signals of its
+ * subscribers and a strand of the execution context publishing to them, so fan-out to many subscribers runs in
+ * parallel. All the subscriptions of a connection live in the same shard, which keeps the messages sent to a connection
+ * in order and lets the shard skip duplicates of a transaction matching several of its subscriptions.
+ */
 class TransactionFeed {
-    // Hold two versions of transaction messages
-    using AllVersionTransactionsType = std::array<std::shared_ptr<std::string>, 2>;
+    /**
+     * @brief The messages of a transaction for both API versions.
+     *
+     * A message is only generated and serialized the first time a subscriber using its API version is notified, so
+     * nothing is built for a version no subscriber uses. Shared by the strands of all the shards.
+     */
+    class TransactionMessages {
+        std::function<boost::json::object(std::uint32_t)> generate_;
+        mutable std::array<std::once_flag, 2> generated_;
+        mutable std::array<std::shared_ptr<std::string>, 2> messages_;
+
+    public:
+        explicit TransactionMessages(std::function<boost::json::object(std::uint32_t)> generate)
+            : generate_(std::move(generate))
+        {
+        }
+
+        std::shared_ptr<std::string> const&
+        get(std::uint32_t apiVersion) const;
+    };
+
+    using AllVersionTransactionsType = TransactionMessages;
+
+    struct Shard;
 
     struct TransactionSlot {
-        std::reference_wrapper<TransactionFeed> feed;
+        std::reference_wrapper<Shard> shard;
         std::weak_ptr<Subscriber> subscriptionContextWeakPtr;
 
-        TransactionSlot(TransactionFeed& feed, SubscriberSharedPtr const& connection)
-            : feed(feed), subscriptionContextWeakPtr(connection)
+        TransactionSlot(Shard& shard, SubscriberSharedPtr const& connection)
+            : shard(shard), subscriptionContextWeakPtr(connection)
         {
         }
 
@@ -63,35 +104,61 @@ class TransactionFeed {
         operator()(AllVersionTransactionsType const& allVersionMsgs) const;
     };
 
+    struct Shard {
+        util::async::AnyStrand strand;
+
+        TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountSignal;
+        TrackableSignalMap<ripple::Book, Subscriber, AllVersionTransactionsType const&> bookSignal;
+        TrackableSignal<Subscriber, AllVersionTransactionsType const&> signal;
+
+        // Signals for proposed tx subscribers
+        TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountProposedSignal;
+        TrackableSignal<Subscriber, AllVersionTransactionsType const&> txProposedSignal;
+
+        std::unordered_set<SubscriberPtr>
+            notified;  // Used by slots to prevent double notifications if tx contains multiple subscribed accounts
+
+        explicit Shard(util::async::AnyStrand strand) : strand(std::move(strand))
+        {
+        }
+
+        bool
+        hasSubscribers(
+            std::unordered_set<ripple::AccountID> const& affectedAccounts,
+            std::unordered_set<ripple::Book> const& affectedBooks
+        ) const;
+
+        void
+        emit(
+            AllVersionTransactionsType const& allVersionMsgs,
+            std::unordered_set<ripple::AccountID> const& affectedAccounts,
+            std::unordered_set<ripple::Book> const& affectedBooks
+        );
+    };
+
     util::Logger logger_{"Subscriptions"};
 
-    util::async::AnyStrand strand_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAllCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAccountCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subBookCount_;
 
-    TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountSignal_;
-    TrackableSignalMap<ripple::Book, Subscriber, AllVersionTransactionsType const&> bookSignal_;
-    TrackableSignal<Subscriber, AllVersionTransactionsType const&> signal_;
-
-    // Signals for proposed tx subscribers
-    TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountProposedSignal_;
-    TrackableSignal<Subscriber, AllVersionTransactionsType const&> txProposedSignal_;
-
-    std::unordered_set<SubscriberPtr>
-        notified_;  // Used by slots to prevent double notifications if tx contains multiple subscribed accounts
+    // shards are never moved because the slots connected to their signals refer to them
+    std::vector<std::unique_ptr<Shard>> shards_;
 
 public:
     /**
      * @brief Construct a new Transaction Feed object.
-     * @param executionCtx The actual publish will be called in the strand of this.
+     * @param executionCtx The actual publish will be called in the strands of this.
+     * @param numShards The number of shards the subscribers are partitioned in; each shard has its own strand.
      */
-    TransactionFeed(util::async::AnyExecutionContext& executionCtx)
-        : strand_(executionCtx.makeStrand())
-        , subAllCount_(getSubscriptionsGaugeInt("tx"))
+    TransactionFeed(util::async::AnyExecutionContext& executionCtx, std::size_t numShards = 1)
+        : subAllCount_(getSubscriptionsGaugeInt("tx"))
         , subAccountCount_(getSubscriptionsGaugeInt("account"))
         , subBookCount_(getSubscriptionsGaugeInt("book"))
     {
+        shards_.reserve(std::max(numShards, 1uz));
+        for (auto i = 0uz; i < std::max(numShards, 1uz); ++i)
+            shards_.push_back(std::make_unique<Shard>(executionCtx.makeStrand()));
     }
 
     /**
@@ -182,6 +249,21 @@ public:
         ripple::LedgerHeader const& lgrInfo,
         std::shared_ptr<data::BackendInterface const> const& backend);
 
+    /**
+     * @brief Publishes all the transactions of a ledger to the transaction feed.
+     *
+     * The owner funds of all the OfferCreate transactions someone listens to are fetched together in one batch before
+     * any message is built, instead of one blocking round trip per offer.
+     *
+     * @param transactions The transactions and metadata, in the order they should be published.
+     * @param lgrInfo The ledger header.
+     * @param backend The backend.
+     */
+    void
+    pub(std::span<data::TransactionAndMetadata const> transactions,
+        ripple::LedgerHeader const& lgrInfo,
+        std::shared_ptr<data::BackendInterface const> const& backend);
+
     /**
      * @brief Get the number of subscribers of the transaction feed.
      */
@@ -201,6 +283,27 @@ public:
     bookSubCount() const;
 
 private:
+    struct PendingTransaction {
+        std::shared_ptr<ripple::STTx const> tx;
+        std::shared_ptr<ripple::TxMeta const> meta;
+        std::uint32_t date = 0;
+        std::unordered_set<ripple::AccountID> affectedAccounts;
+        std::unordered_set<ripple::Book> affectedBooks;
+        std::optional<ripple::STAmount> ownerFunds;
+    };
+
+    void
+    pubInternal(PendingTransaction pending, ripple::LedgerHeader const& lgrInfo);
+
+    Shard&
+    shardFor(SubscriberPtr subscriber) const;
+
+    bool
+    hasSubscribers(
+        std::unordered_set<ripple::AccountID> const& affectedAccounts,
+        std::unordered_set<ripple::Book> const& affectedBooks
+    ) const;
+
     void
     unsubInternal(SubscriberPtr subscriber);
 
@@ -20,14 +20,20 @@
 #pragma once
 
 #include "data/BackendInterface.hpp"
+#include "data/Types.hpp"
 #include "rpc/Errors.hpp"
+#include "rpc/JS.hpp"
 #include "rpc/RPCHelpers.hpp"
 #include "rpc/WorkQueue.hpp"
 #include "rpc/common/HandlerProvider.hpp"
 #include "rpc/common/Types.hpp"
 #include "rpc/common/impl/ForwardingProxy.hpp"
+#include "util/LedgerResponseCache.hpp"
 #include "util/ResponseExpirationCache.hpp"
 #include "util/log/Logger.hpp"
+#include "util/newconfig/ArrayView.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/newconfig/ValueView.hpp"
 #include "web/Context.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 
@@ -37,13 +43,18 @@
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <xrpl/protocol/ErrorCodes.h>
+#include <xrpl/protocol/jss.h>
 
+#include <charconv>
 #include <chrono>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <unordered_set>
 #include <utility>
 
@@ -70,6 +81,13 @@ class RPCEngine {
     impl::ForwardingProxy<LoadBalancerType, CountersType, HandlerProvider> forwardingProxy_;
 
     std::optional<util::ResponseExpirationCache> responseCache_;
+    std::optional<util::LedgerResponseCache> ledgerResponseCache_;
+
+    // the ledger a cacheable request reads and whether it was resolved to the latest validated one
+    struct ResolvedLedger {
+        std::uint32_t sequence;
+        bool latest;
+    };
 
 public:
     /**
@@ -110,6 +128,24 @@ public:
                 std::unordered_set<std::string>{"server_info"}
             );
         }
+
+        std::unordered_set<std::string> cachedMethods;
+        auto const methods = config.getArray("rpc.response_cache.methods");
+        for (auto it = methods.begin<util::config::ValueView>(); it != methods.end<util::config::ValueView>(); ++it)
+            cachedMethods.insert((*it).asString());
+
+        if (not cachedMethods.empty()) {
+            auto const maxEntries = config.get<std::uint32_t>("rpc.response_cache.max_entries");
+            auto const maxBytes = config.get<std::uint32_t>("rpc.response_cache.max_bytes");
+            LOG(log_.info()) << fmt::format(
+                "Init RPC response cache for {} methods, max entries: {}, max bytes: {}",
+                cachedMethods.size(),
+                maxEntries,
+                maxBytes
+            );
+
+            ledgerResponseCache_.emplace(maxEntries, maxBytes, std::move(cachedMethods));
+        }
     }
 
     /**
@@ -160,6 +196,18 @@ public:
                 return Result{std::move(res).value()};
         }
 
+        std::optional<ResolvedLedger> cachedLedger;
+        if (not ctx.isAdmin and ledgerResponseCache_ and ledgerResponseCache_->shouldCache(ctx.method)) {
+            ledgerResponseCache_->onLedgerRange(ctx.range.minSequence, ctx.range.maxSequence);
+
+            cachedLedger = resolveLedger(ctx.params, ctx.range);
+            if (cachedLedger.has_value()) {
+                auto res = ledgerResponseCache_->get(ctx.method, ctx.params, ctx.apiVersion, cachedLedger->sequence);
+                if (res.has_value())
+                    return Result{std::move(res).value()};
+            }
+        }
+
         if (backend_->isTooBusy()) {
             LOG(log_.error()) << "Database is too busy. Rejecting request";
             notifyTooBusy();  // TODO: should we add ctx.method if we have it?
@@ -188,8 +236,20 @@ public:
 
             if (not v) {
                 notifyErrored(ctx.method);
-            } else if (not ctx.isAdmin and responseCache_) {
-                responseCache_->put(ctx.method, v.result->as_object());
+            } else {
+                if (not ctx.isAdmin and responseCache_)
+                    responseCache_->put(ctx.method, v.result->as_object());
+
+                if (cachedLedger.has_value() and v.warnings.empty()) {
+                    ledgerResponseCache_->put(
+                        ctx.method,
+                        ctx.params,
+                        ctx.apiVersion,
+                        cachedLedger->sequence,
+                        cachedLedger->latest,
+                        v.result->as_object()
+                    );
+                }
             }
 
             return Result{std::move(v)};
@@ -212,13 +272,16 @@ public:
      * @tparam FnType The type of function
      * @param func The lambda to execute when this request is handled
      * @param ip The ip address for which this request is being executed
+     * @param method The method of the request used to pick its cost class; empty if not known yet
      * @return true if the request was successfully scheduled; false otherwise
      */
     template <typename FnType>
     bool
-    post(FnType&& func, std::string const& ip)
+    post(FnType&& func, std::string const& ip, std::string const& method = {})
     {
-        return workQueue_.get().postCoro(std::forward<FnType>(func), dosGuard_.get().isWhiteListed(ip));
+        return workQueue_.get().postCoro(
+            std::forward<FnType>(func), dosGuard_.get().isWhiteListed(ip), WorkQueue::costClassOf(method), ip
+        );
     }
 
     /**
@@ -316,6 +379,39 @@ private:
     {
         return handlerProvider_->contains(method) || forwardingProxy_.isProxied(method);
     }
+
+    // requests naming a ledger by hash are not cached as resolving the hash would need a database read
+    static std::optional<ResolvedLedger>
+    resolveLedger(boost::json::object const& params, data::LedgerRange const& range)
+    {
+        if (params.contains(JS(ledger_hash)))
+            return std::nullopt;
+
+        if (not params.contains(JS(ledger_index)))
+            return ResolvedLedger{.sequence = range.maxSequence, .latest = true};
+
+        std::optional<std::uint32_t> sequence;
+        auto const& index = params.at(JS(ledger_index));
+        if (index.is_uint64() and index.as_uint64() <= range.maxSequence) {
+            sequence = static_cast<std::uint32_t>(index.as_uint64());
+        } else if (index.is_int64() and index.as_int64() >= 0 and index.as_int64() <= range.maxSequence) {
+            sequence = static_cast<std::uint32_t>(index.as_int64());
+        } else if (index.is_string()) {
+            std::string_view const str = index.as_string();
+            if (str == "validated" or str == "current" or str == "closed")
+                return ResolvedLedger{.sequence = range.maxSequence, .latest = true};
+
+            std::uint32_t parsed = 0;
+            if (auto const [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), parsed);
+                ec == std::errc{} and ptr == str.data() + str.size())
+                sequence = parsed;
+        }
+
+        if (not sequence.has_value() or *sequence < range.minSequence or *sequence > range.maxSequence)
+            return std::nullopt;
+
+        return ResolvedLedger{.sequence = *sequence, .latest = false};
+    }
 };
 
 }  // namespace rpc
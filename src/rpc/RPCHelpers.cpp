@@ -20,6 +20,7 @@
 #include "rpc/RPCHelpers.hpp"
 
 #include "data/BackendInterface.hpp"
+#include "data/OrderBookIndex.hpp"
 #include "data/Types.hpp"
 #include "rpc/Errors.hpp"
 #include "rpc/JS.hpp"
@@ -54,6 +55,7 @@
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Book.h>
 #include <xrpl/protocol/ErrorCodes.h>
+#include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/Indexes.h>
 #include <xrpl/protocol/Issue.h>
 #include <xrpl/protocol/Keylet.h>
@@ -92,9 +94,11 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <ranges>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -943,6 +947,53 @@ isFrozen(
     return false;
 }
 
+namespace {
+
+template <typename FetchFeesType>
+ripple::XRPAmount
+liquidXrp(ripple::SLE const& accountRoot, FetchFeesType&& fetchFees)
+{
+    std::uint32_t const ownerCount = accountRoot.getFieldU32(ripple::sfOwnerCount);
+
+    auto balance = accountRoot.getFieldAmount(ripple::sfBalance);
+
+    ripple::STAmount const amount = [&]() {
+        // AMM doesn't require the reserves
+        if ((accountRoot.getFlags() & ripple::lsfAMMNode) != 0u)
+            return balance;
+        auto const reserve = fetchFees().accountReserve(ownerCount);
+        ripple::STAmount amount = balance - reserve;
+        if (balance < reserve)
+            amount.clear();
+        return amount;
+    }();
+
+    return amount.xrp();
+}
+
+ripple::STAmount
+lineBalance(ripple::SLE const& line, ripple::AccountID const& account, ripple::AccountID const& issuer)
+{
+    auto amount = line.getFieldAmount(ripple::sfBalance);
+    if (account > issuer) {
+        // Put balance in account terms.
+        amount.negate();
+    }
+    amount.setIssuer(issuer);
+    return amount;
+}
+
+ripple::STAmount
+zeroAmount(ripple::Currency const& currency, ripple::AccountID const& issuer)
+{
+    ripple::STAmount amount;
+    amount.setIssue(ripple::Issue(currency, issuer));
+    amount.clear();
+    return amount;
+}
+
+}  // namespace
+
 ripple::XRPAmount
 xrpLiquid(
     BackendInterface const& backend,
@@ -960,22 +1011,7 @@ xrpLiquid(
     ripple::SerialIter it{blob->data(), blob->size()};
     ripple::SLE const sle{it, key};
 
-    std::uint32_t const ownerCount = sle.getFieldU32(ripple::sfOwnerCount);
-
-    auto balance = sle.getFieldAmount(ripple::sfBalance);
-
-    ripple::STAmount const amount = [&]() {
-        // AMM doesn't require the reserves
-        if ((sle.getFlags() & ripple::lsfAMMNode) != 0u)
-            return balance;
-        auto const reserve = backend.fetchFees(sequence, yield)->accountReserve(ownerCount);
-        ripple::STAmount amount = balance - reserve;
-        if (balance < reserve)
-            amount.clear();
-        return amount;
-    }();
-
-    return amount.xrp();
+    return liquidXrp(sle, [&]() { return *backend.fetchFees(sequence, yield); });
 }
 
 ripple::STAmount
@@ -994,6 +1030,91 @@ accountFunds(
     return accountHolds(backend, sequence, id, amount.getCurrency(), amount.getIssuer(), true, yield);
 }
 
+std::vector<ripple::STAmount>
+accountFunds(
+    BackendInterface const& backend,
+    std::uint32_t const sequence,
+    std::vector<std::pair<ripple::AccountID, ripple::STAmount>> const& owners,
+    boost::asio::yield_context yield
+)
+{
+    auto const isOwnIssue = [](ripple::AccountID const& id, ripple::STAmount const& amount) {
+        return !amount.native() && amount.getIssuer() == id;
+    };
+
+    // every ledger object needed by any of the owners is fetched in a single (cache first) round trip
+    std::vector<ripple::uint256> keys;
+    for (auto const& [id, amount] : owners) {
+        if (isOwnIssue(id, amount))
+            continue;
+
+        if (amount.native()) {
+            keys.push_back(ripple::keylet::account(id).key);
+        } else {
+            keys.push_back(ripple::keylet::line(id, amount.getIssuer(), amount.getCurrency()).key);
+            keys.push_back(ripple::keylet::account(amount.getIssuer()).key);
+        }
+    }
+
+    std::ranges::sort(keys);
+    keys.erase(std::ranges::unique(keys).begin(), keys.end());
+
+    auto const blobs = keys.empty() ? std::vector<Blob>{} : backend.fetchLedgerObjects(keys, sequence, yield);
+    auto const findObject = [&](ripple::uint256 const& key) -> std::shared_ptr<ripple::SLE const> {
+        auto const it = std::ranges::lower_bound(keys, key);
+        if (it == keys.end() || *it != key)
+            return nullptr;
+
+        auto const& blob = blobs[static_cast<std::size_t>(std::distance(keys.begin(), it))];
+        if (blob.empty())
+            return nullptr;
+
+        ripple::SerialIter sit{blob.data(), blob.size()};
+        return std::make_shared<ripple::SLE const>(sit, key);
+    };
+
+    std::optional<ripple::Fees> fees;
+    auto const fetchFees = [&]() -> ripple::Fees const& {
+        if (!fees)
+            fees = backend.fetchFees(sequence, yield);
+        return *fees;
+    };
+
+    std::vector<ripple::STAmount> funds;
+    funds.reserve(owners.size());
+
+    for (auto const& [id, amount] : owners) {
+        if (isOwnIssue(id, amount)) {
+            funds.push_back(amount);
+            continue;
+        }
+
+        if (amount.native()) {
+            auto const accountRoot = findObject(ripple::keylet::account(id).key);
+            funds.emplace_back(accountRoot ? liquidXrp(*accountRoot, fetchFees) : ripple::XRPAmount{beast::zero});
+            continue;
+        }
+
+        auto const& issuer = amount.getIssuer();
+        auto const& currency = amount.getCurrency();
+        auto const line = findObject(ripple::keylet::line(id, issuer, currency).key);
+        auto const issuerRoot = findObject(ripple::keylet::account(issuer).key);
+
+        // same rules as isFrozen: nothing is frozen if the issuer does not exist
+        auto const frozen = issuerRoot &&
+            (issuerRoot->isFlag(ripple::lsfGlobalFreeze) ||
+             (line && line->isFlag((issuer > id) ? ripple::lsfHighFreeze : ripple::lsfLowFreeze)));
+
+        if (!line || frozen) {
+            funds.push_back(zeroAmount(currency, issuer));
+        } else {
+            funds.push_back(lineBalance(*line, id, issuer));
+        }
+    }
+
+    return funds;
+}
+
 ripple::STAmount
 accountHolds(
     BackendInterface const& backend,
@@ -1005,35 +1126,22 @@ accountHolds(
     boost::asio::yield_context yield
 )
 {
-    ripple::STAmount amount;
     if (ripple::isXRP(currency))
         return {xrpLiquid(backend, sequence, account, yield)};
 
     auto const key = ripple::keylet::line(account, issuer, currency).key;
     auto const blob = backend.fetchLedgerObject(key, sequence, yield);
 
-    if (!blob) {
-        amount.setIssue(ripple::Issue(currency, issuer));
-        amount.clear();
-        return amount;
-    }
+    if (!blob)
+        return zeroAmount(currency, issuer);
 
     ripple::SerialIter it{blob->data(), blob->size()};
     ripple::SLE const sle{it, key};
 
-    if (zeroIfFrozen && isFrozen(backend, sequence, account, currency, issuer, yield)) {
-        amount.setIssue(ripple::Issue(currency, issuer));
-        amount.clear();
-    } else {
-        amount = sle.getFieldAmount(ripple::sfBalance);
-        if (account > issuer) {
-            // Put balance in account terms.
-            amount.negate();
-        }
-        amount.setIssuer(issuer);
-    }
+    if (zeroIfFrozen && isFrozen(backend, sequence, account, currency, issuer, yield))
+        return zeroAmount(currency, issuer);
 
-    return amount;
+    return lineBalance(sle, account, issuer);
 }
 
 ripple::Rate
@@ -1058,9 +1166,63 @@ transferRate(
     return ripple::parityRate;
 }
 
+std::unordered_map<std::uint32_t, ripple::LedgerHeader>
+fetchLedgerHeaders(
+    BackendInterface const& backend,
+    std::vector<data::TransactionAndMetadata> const& transactions,
+    boost::asio::yield_context yield
+)
+{
+    std::vector<std::uint32_t> sequences;
+    sequences.reserve(transactions.size());
+    std::ranges::transform(transactions, std::back_inserter(sequences), [](auto const& txn) {
+        return txn.ledgerSequence;
+    });
+
+    // transactions of a page are ordered by ledger so duplicates are adjacent
+    auto const [first, last] = std::ranges::unique(sequences);
+    sequences.erase(first, last);
+
+    std::unordered_map<std::uint32_t, ripple::LedgerHeader> headers;
+    auto const fetched = backend.fetchLedgersBySequence(sequences, yield);
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        if (fetched[i].has_value())
+            headers.emplace(sequences[i], *fetched[i]);
+    }
+
+    return headers;
+}
+
+std::vector<data::BookOfferPtr>
+fetchBookOffers(
+    BackendInterface const& backend,
+    ripple::Book const& book,
+    std::uint32_t const ledgerSequence,
+    std::uint32_t const limit,
+    boost::asio::yield_context yield
+)
+{
+    auto const bookBase = getBookBase(book);
+    if (auto offers = backend.cache().getBookOffers(bookBase, ledgerSequence, limit); offers.has_value())
+        return std::move(offers).value();
+
+    auto const [objects, _] = backend.fetchBookOffers(bookBase, ledgerSequence, limit, yield);
+
+    std::vector<data::BookOfferPtr> offers;
+    offers.reserve(objects.size());
+    for (auto const& obj : objects) {
+        try {
+            offers.push_back(std::make_shared<data::BookOffer const>(obj.key, obj.blob));
+        } catch (std::exception const& e) {
+            LOG(gLog.error()) << "caught exception: " << e.what();
+        }
+    }
+    return offers;
+}
+
 boost::json::array
 postProcessOrderBook(
-    std::vector<data::LedgerObject> const& offers,
+    std::vector<data::BookOfferPtr> const& offers,
     ripple::Book const& book,
     ripple::AccountID const& takerID,
     data::BackendInterface const& backend,
@@ -1077,15 +1239,14 @@ postProcessOrderBook(
 
     auto rate = transferRate(backend, ledgerSequence, book.out.account, yield);
 
-    for (auto const& obj : offers) {
+    for (auto const& offerPtr : offers) {
         try {
-            ripple::SerialIter it{obj.blob.data(), obj.blob.size()};
-            ripple::SLE const offer{it, obj.key};
-            ripple::uint256 const bookDir = offer.getFieldH256(ripple::sfBookDirectory);
+            auto const& offer = offerPtr->sle;
+            ripple::uint256 const& bookDir = offerPtr->bookDirectory;
 
-            auto const uOfferOwnerID = offer.getAccountID(ripple::sfAccount);
-            auto const& saTakerGets = offer.getFieldAmount(ripple::sfTakerGets);
-            auto const& saTakerPays = offer.getFieldAmount(ripple::sfTakerPays);
+            auto const& uOfferOwnerID = offerPtr->owner;
+            auto const& saTakerGets = offerPtr->takerGets;
+            auto const& saTakerPays = offerPtr->takerPays;
             ripple::STAmount saOwnerFunds;
             bool firstOwnerOffer = true;
 
@@ -1366,6 +1527,16 @@ isAdminCmd(std::string const& method, boost::json::object const& request)
     return false;
 }
 
+std::string
+getRequestMethod(boost::json::object const& request)
+{
+    for (auto const key : {JS(command), JS(method)}) {
+        if (auto const* value = request.if_contains(key); value != nullptr and value->is_string())
+            return std::string{value->as_string()};
+    }
+    return {};
+}
+
 std::variant<ripple::uint256, Status>
 getNFTID(boost::json::object const& request)
 {
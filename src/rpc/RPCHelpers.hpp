@@ -25,6 +25,7 @@
  */
 
 #include "data/BackendInterface.hpp"
+#include "data/OrderBookIndex.hpp"
 #include "data/Types.hpp"
 #include "rpc/Errors.hpp"
 #include "rpc/common/Types.hpp"
@@ -70,6 +71,7 @@
 #include <optional>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -446,6 +448,26 @@ accountFunds(
     boost::asio::yield_context yield
 );
 
+/**
+ * @brief Get the funds of many accounts at once
+ *
+ * Gives the same results as calling accountFunds for every entry but all the ledger objects involved are fetched with
+ * a single fetchLedgerObjects call (served from the cache when possible) and the fees are fetched at most once.
+ *
+ * @param backend The backend to use
+ * @param sequence The sequence
+ * @param owners The account IDs with the amount whose funds should be computed
+ * @param yield The coroutine context
+ * @return The account funds, in the same order as owners
+ */
+std::vector<ripple::STAmount>
+accountFunds(
+    BackendInterface const& backend,
+    std::uint32_t sequence,
+    std::vector<std::pair<ripple::AccountID, ripple::STAmount>> const& owners,
+    boost::asio::yield_context yield
+);
+
 /**
  * @brief Get the amount that an account holds
  *
@@ -503,6 +525,45 @@ xrpLiquid(
     boost::asio::yield_context yield
 );
 
+/**
+ * @brief Get the headers of the ledgers that the given transactions were included in
+ *
+ * All headers are fetched with a single batched read through the ledger header cache of the backend.
+ *
+ * @param backend The backend to use
+ * @param transactions The transactions
+ * @param yield The coroutine context
+ * @return The headers by ledger sequence; ledgers that could not be found are omitted
+ */
+std::unordered_map<std::uint32_t, ripple::LedgerHeader>
+fetchLedgerHeaders(
+    BackendInterface const& backend,
+    std::vector<data::TransactionAndMetadata> const& transactions,
+    boost::asio::yield_context yield
+);
+
+/**
+ * @brief Get the best offers of an order book
+ *
+ * The offers are read from the order book index of the cache if it holds the requested ledger; otherwise they are
+ * fetched from the backend and parsed.
+ *
+ * @param backend The backend to use
+ * @param book The book
+ * @param ledgerSequence The ledger sequence
+ * @param limit The maximum number of offers to return
+ * @param yield The coroutine context
+ * @return The offers ordered by quality
+ */
+std::vector<data::BookOfferPtr>
+fetchBookOffers(
+    BackendInterface const& backend,
+    ripple::Book const& book,
+    std::uint32_t ledgerSequence,
+    std::uint32_t limit,
+    boost::asio::yield_context yield
+);
+
 /**
  * @brief Post process an order book
  *
@@ -516,7 +577,7 @@ xrpLiquid(
  */
 boost::json::array
 postProcessOrderBook(
-    std::vector<data::LedgerObject> const& offers,
+    std::vector<data::BookOfferPtr> const& offers,
     ripple::Book const& book,
     ripple::AccountID const& takerID,
     data::BackendInterface const& backend,
@@ -582,6 +643,15 @@ specifiesCurrentOrClosedLedger(boost::json::object const& request);
 bool
 isAdminCmd(std::string const& method, boost::json::object const& request);
 
+/**
+ * @brief Get the method of a raw request without validating the request.
+ *
+ * @param request The request as received from a websocket (`command`) or http (`method`) client
+ * @return The method if it is specified as a string; empty string otherwise
+ */
+std::string
+getRequestMethod(boost::json::object const& request);
+
 /**
  * @brief Get the NFTID from the request
  *
@@ -19,19 +19,50 @@
 
 #include "rpc/WorkQueue.hpp"
 
+#include "util/Assert.hpp"
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
+#include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace rpc {
 
+namespace {
+
+std::vector<std::int64_t> const kDEPTH_BUCKETS = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 5000};
+std::vector<std::int64_t> const kWAIT_BUCKETS_US =
+    {100, 500, 1'000, 5'000, 10'000, 50'000, 100'000, 500'000, 1'000'000};
+
+char const*
+toString(WorkQueue::CostClass costClass)
+{
+    switch (costClass) {
+        case WorkQueue::CostClass::Cheap:
+            return "cheap";
+        case WorkQueue::CostClass::Default:
+            return "default";
+        case WorkQueue::CostClass::Expensive:
+            return "expensive";
+    }
+    ASSERT(false, "Unknown cost class");
+    std::unreachable();
+}
+
+}  // namespace
+
 void
 WorkQueue::OneTimeCallable::setCallable(std::function<void()> func)
 {
@@ -51,7 +82,12 @@ WorkQueue::OneTimeCallable::operator bool() const
     return func_.operator bool();
 }
 
-WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize)
+WorkQueue::WorkQueue(
+    std::uint32_t numWorkers,
+    uint32_t maxSize,
+    uint32_t maxRunning,
+    std::optional<impl::AdmissionController::Settings> loadShedding
+)
     : queued_{PrometheusService::counterInt(
           "work_queue_queued_total_number",
           util::prometheus::Labels(),
@@ -67,10 +103,42 @@ WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize)
           util::prometheus::Labels(),
           "The current number of tasks in the queue"
       )}
+    , state_{State{
+          .scheduler = impl::FairScheduler<Job>{
+              std::vector<std::int64_t>(kCOST_CLASS_WEIGHTS.begin(), kCOST_CLASS_WEIGHTS.end())
+          },
+          .admissionController = loadShedding.transform([](auto settings) {
+              return impl::AdmissionController{std::move(settings)};
+          })
+      }}
+    , maxRunning_{maxRunning != 0 ? maxRunning : numWorkers * kDEFAULT_MAX_RUNNING_PER_WORKER}
     , ioc_{numWorkers}
 {
     if (maxSize != 0)
         maxSize_ = maxSize;
+
+    for (auto const costClass : {CostClass::Cheap, CostClass::Default, CostClass::Expensive}) {
+        auto const labels = util::prometheus::Labels{{{"class", toString(costClass)}}};
+        classCounters_.push_back(ClassCounters{
+            .depth = PrometheusService::histogramInt(
+                "work_queue_depth_histogram",
+                labels,
+                kDEPTH_BUCKETS,
+                "The number of tasks of the class waiting in the queue when a task is queued"
+            ),
+            .waitUs = PrometheusService::histogramInt(
+                "work_queue_wait_duration_microseconds_histogram",
+                labels,
+                kWAIT_BUCKETS_US,
+                "The number of microseconds tasks of the class were waiting to be executed"
+            ),
+            .shed = PrometheusService::counterInt(
+                "work_queue_shed_total_number",
+                labels,
+                "The total number of tasks of the class rejected because the queue was overloaded"
+            )
+        });
+    }
 }
 
 WorkQueue::~WorkQueue()
@@ -90,15 +158,73 @@ WorkQueue::stop(std::function<void()> onQueueEmpty)
 }
 
 WorkQueue
-WorkQueue::makeWorkQueue(util::config::ClioConfigDefinition const& config)
+WorkQueue::makeWorkQueue(
+    util::config::ClioConfigDefinition const& config,
+    std::function<std::chrono::microseconds()> readLatency
+)
 {
     static util::Logger const log{"RPC"};  // NOLINT(readability-identifier-naming)
     auto const serverConfig = config.getObject("server");
     auto const numThreads = config.get<uint32_t>("workers");
     auto const maxQueueSize = serverConfig.get<uint32_t>("max_queue_size");
 
-    LOG(log.info()) << "Number of workers = " << numThreads << ". Max queue size = " << maxQueueSize;
-    return WorkQueue{numThreads, maxQueueSize};
+    auto const maxRunning = serverConfig.get<uint32_t>("max_running_requests");
+
+    std::optional<impl::AdmissionController::Settings> loadShedding;
+    if (serverConfig.get<bool>("load_shedding.enabled")) {
+        loadShedding = impl::AdmissionController::Settings{
+            .targetWait = std::chrono::milliseconds{serverConfig.get<uint32_t>("load_shedding.target_wait_ms")},
+            .interval = std::chrono::milliseconds{serverConfig.get<uint32_t>("load_shedding.interval_ms")},
+            .targetReadLatency =
+                std::chrono::milliseconds{serverConfig.get<uint32_t>("load_shedding.target_read_latency_ms")},
+            .readLatency = std::move(readLatency)
+        };
+    }
+
+    LOG(log.info()) << "Number of workers = " << numThreads << ". Max queue size = " << maxQueueSize
+                    << ". Max running requests = " << maxRunning
+                    << ". Load shedding = " << (loadShedding.has_value() ? "enabled" : "disabled");
+    return WorkQueue{numThreads, maxQueueSize, maxRunning, std::move(loadShedding)};
+}
+
+WorkQueue::CostClass
+WorkQueue::costClassOf(std::string_view method)
+{
+    static std::unordered_set<std::string_view> const kCHEAP = {
+        "fee",
+        "ledger_closed",
+        "ledger_current",
+        "ledger_range",
+        "ping",
+        "random",
+        "server_info",
+        "server_state",
+        "unsubscribe",
+        "version",
+    };
+    static std::unordered_set<std::string_view> const kEXPENSIVE = {
+        "account_channels",
+        "account_lines",
+        "account_objects",
+        "account_offers",
+        "account_tx",
+        "book_changes",
+        "book_offers",
+        "gateway_balances",
+        "get_aggregate_price",
+        "ledger",
+        "ledger_data",
+        "mpt_holders",
+        "nft_history",
+        "nfts_by_issuer",
+        "noripple_check",
+    };
+
+    if (kCHEAP.contains(method))
+        return CostClass::Cheap;
+    if (kEXPENSIVE.contains(method))
+        return CostClass::Expensive;
+    return CostClass::Default;
 }
 
 boost::json::object
@@ -126,4 +252,54 @@ WorkQueue::size() const
     return curSize_.get().value();
 }
 
+std::vector<std::pair<WorkQueue::Job, std::size_t>>
+WorkQueue::takeReady(State& state)
+{
+    std::vector<std::pair<Job, std::size_t>> ready;
+    while (state.running < maxRunning_) {
+        auto next = state.scheduler.pop();
+        if (not next.has_value())
+            break;
+
+        ++state.running;
+        ready.push_back(std::move(next).value());
+    }
+    return ready;
+}
+
+void
+WorkQueue::startJob(Job job, std::size_t costClass)
+{
+    boost::asio::spawn(ioc_, [this, job = std::move(job), costClass](boost::asio::yield_context yield) mutable {
+        auto const run = std::chrono::system_clock::now();
+        auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - job.start).count();
+
+        ++queued_.get();
+        durationUs_.get() += wait;
+        classCounters_[costClass].waitUs.get().observe(wait);
+        if (auto state = state_.lock(); state->admissionController.has_value())
+            state->admissionController->onJobStarted(std::chrono::microseconds{wait});
+        LOG(log_.info()) << "WorkQueue wait time = " << wait << " queue size = " << curSize_.get().value();
+
+        job.func(yield);
+
+        // the slot of the finished job is handed over to the jobs waiting in the queue
+        std::vector<std::pair<Job, std::size_t>> ready;
+        {
+            auto state = state_.lock();
+            --state->running;
+            ready = takeReady(*state);
+        }
+        for (auto& [nextJob, nextClass] : ready)
+            startJob(std::move(nextJob), nextClass);
+
+        --curSize_.get();
+        if (curSize_.get().value() == 0 && stopping_) {
+            auto onTasksComplete = onQueueEmpty_.lock();
+            ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
+            onTasksComplete->operator()();
+        }
+    });
+}
+
 }  // namespace rpc
@@ -19,11 +19,14 @@
 
 #pragma once
 
+#include "rpc/impl/AdmissionController.hpp"
+#include "rpc/impl/FairScheduler.hpp"
 #include "util/Mutex.hpp"
 #include "util/log/Logger.hpp"
 #include "util/newconfig/ConfigDefinition.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/asio/spawn.hpp>
@@ -31,19 +34,55 @@
 #include <boost/json.hpp>
 #include <boost/json/object.hpp>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace rpc {
 
 /**
  * @brief An asynchronous, thread-safe queue for RPC requests.
+ *
+ * At most a limited number of jobs run at the same time; the rest wait in the queue. Waiting jobs are split by cost
+ * class so that cheap requests are not stuck behind a burst of expensive ones, and inside each class by client so that
+ * one client can't monopolise the queue. See impl::FairScheduler for the details.
+ *
+ * When load shedding is enabled, jobs other than cheap ones are rejected while the queue is overloaded. See
+ * impl::AdmissionController for the details.
  */
 class WorkQueue {
+public:
+    /**
+     * @brief The cost class of a job; determines the share of the workers the job competes for.
+     */
+    enum class CostClass : std::uint8_t { Cheap, Default, Expensive };
+
+    static constexpr std::uint32_t kDEFAULT_MAX_RUNNING_PER_WORKER = 16;
+
+private:
+    static constexpr std::size_t kNUM_COST_CLASSES = 3;
+    static constexpr std::array<std::int64_t, kNUM_COST_CLASSES> kCOST_CLASS_WEIGHTS = {8, 4, 1};
+
+    struct Job {
+        std::function<void(boost::asio::yield_context)> func;
+        std::chrono::system_clock::time_point start;
+    };
+
+    struct ClassCounters {
+        std::reference_wrapper<util::prometheus::HistogramInt> depth;
+        std::reference_wrapper<util::prometheus::HistogramInt> waitUs;
+        std::reference_wrapper<util::prometheus::CounterInt> shed;
+    };
+
     // these are cumulative for the lifetime of the process
     std::reference_wrapper<util::prometheus::CounterInt> queued_;
     std::reference_wrapper<util::prometheus::CounterInt> durationUs_;
@@ -51,6 +90,16 @@ class WorkQueue {
     std::reference_wrapper<util::prometheus::GaugeInt> curSize_;
     uint32_t maxSize_ = std::numeric_limits<uint32_t>::max();
 
+    std::vector<ClassCounters> classCounters_;
+
+    struct State {
+        impl::FairScheduler<Job> scheduler;
+        std::uint32_t running = 0;
+        std::optional<impl::AdmissionController> admissionController;
+    };
+    util::Mutex<State> state_;
+    std::uint32_t maxRunning_;
+
     util::Logger log_{"RPC"};
     boost::asio::thread_pool ioc_;
 
@@ -77,8 +126,16 @@ public:
      *
      * @param numWorkers The amount of threads to spawn in the pool
      * @param maxSize The maximum capacity of the queue; 0 means unlimited
+     * @param maxRunning The maximum number of jobs running at the same time; 0 means kDEFAULT_MAX_RUNNING_PER_WORKER
+     * jobs per worker
+     * @param loadShedding The settings of load shedding; nullopt disables load shedding
      */
-    WorkQueue(std::uint32_t numWorkers, uint32_t maxSize = 0);
+    WorkQueue(
+        std::uint32_t numWorkers,
+        uint32_t maxSize = 0,
+        uint32_t maxRunning = 0,
+        std::optional<impl::AdmissionController::Settings> loadShedding = std::nullopt
+    );
     ~WorkQueue();
 
     /**
@@ -93,24 +150,45 @@ public:
      * @brief A factory function that creates the work queue based on a config.
      *
      * @param config The Clio config to use
+     * @param readLatency Provides the recent read latency of the database, used for load shedding if set
      * @return The work queue
      */
     static WorkQueue
-    makeWorkQueue(util::config::ClioConfigDefinition const& config);
+    makeWorkQueue(
+        util::config::ClioConfigDefinition const& config,
+        std::function<std::chrono::microseconds()> readLatency = nullptr
+    );
+
+    /**
+     * @brief Get the cost class of an RPC method.
+     *
+     * @param method The name of the method; may be empty if unknown
+     * @return The cost class of the method
+     */
+    static CostClass
+    costClassOf(std::string_view method);
 
     /**
      * @brief Submit a job to the work queue.
      *
-     * The job will be rejected if isWhiteListed is set to false and the current size of the queue reached capacity.
+     * The job will be rejected if isWhiteListed is set to false and either the current size of the queue reached
+     * capacity or the job is not cheap and the queue is overloaded.
      *
      * @tparam FnType The function object type
      * @param func The function object to queue as a job
      * @param isWhiteListed Whether the queue capacity applies to this job
+     * @param costClass The cost class of the job
+     * @param client The client that submitted the job; jobs of different clients are scheduled fairly
      * @return true if the job was successfully queued; false otherwise
      */
     template <typename FnType>
     bool
-    postCoro(FnType&& func, bool isWhiteListed)
+    postCoro(
+        FnType&& func,
+        bool isWhiteListed,
+        CostClass costClass = CostClass::Default,
+        std::string const& client = {}
+    )
     {
         if (stopping_) {
             LOG(log_.warn()) << "Queue is stopping, rejecting incoming task.";
@@ -123,29 +201,30 @@ public:
             return false;
         }
 
-        ++curSize_.get();
-
-        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job at the front
-        // of the job queue.
-        boost::asio::spawn(
-            ioc_,
-            [this, func = std::forward<FnType>(func), start = std::chrono::system_clock::now()](auto yield) mutable {
-                auto const run = std::chrono::system_clock::now();
-                auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - start).count();
-
-                ++queued_.get();
-                durationUs_.get() += wait;
-                LOG(log_.info()) << "WorkQueue wait time = " << wait << " queue size = " << curSize_.get().value();
-
-                func(yield);
-                --curSize_.get();
-                if (curSize_.get().value() == 0 && stopping_) {
-                    auto onTasksComplete = onQueueEmpty_.lock();
-                    ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
-                    onTasksComplete->operator()();
-                }
+        auto const classIndex = static_cast<std::size_t>(costClass);
+        std::vector<std::pair<Job, std::size_t>> ready;
+        {
+            auto state = state_.lock();
+            if (not isWhiteListed and costClass != CostClass::Cheap and state->admissionController.has_value() and
+                state->admissionController->isOverloaded(state->scheduler.size() > 0)) {
+                LOG(log_.warn()) << "Queue is overloaded. rejecting job. current size = " << state->scheduler.size();
+                ++classCounters_[classIndex].shed.get();
+                return false;
             }
-        );
+
+            ++curSize_.get();
+            state->scheduler.push(
+                classIndex,
+                client,
+                Job{.func = std::forward<FnType>(func), .start = std::chrono::system_clock::now()}
+            );
+            auto const depth = static_cast<std::int64_t>(state->scheduler.size(classIndex));
+            classCounters_[classIndex].depth.get().observe(depth);
+            ready = takeReady(*state);
+        }
+
+        for (auto& [job, jobClass] : ready)
+            startJob(std::move(job), jobClass);
 
         return true;
     }
@@ -171,6 +250,13 @@ public:
      */
     size_t
     size() const;
+
+private:
+    std::vector<std::pair<Job, std::size_t>>
+    takeReady(State& state);
+
+    void
+    startJob(Job job, std::size_t costClass);
 };
 
 }  // namespace rpc
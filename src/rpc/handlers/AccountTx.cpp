@@ -45,6 +45,7 @@
 #include <limits>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 
@@ -134,6 +135,11 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
     if (retCursor)
         response.marker = {.ledger = retCursor->ledgerSequence, .seq = retCursor->transactionIndex};
 
+    // api v2 responses carry the hash and close time of the ledger of each transaction
+    auto const ledgerHeaders = !input.binary && ctx.apiVersion >= 2u
+        ? fetchLedgerHeaders(*sharedPtrBackend_, blobs, ctx.yield)
+        : std::unordered_map<std::uint32_t, ripple::LedgerHeader>{};
+
     for (auto const& txnPlusMeta : blobs) {
         // over the range
         if ((txnPlusMeta.ledgerSequence < minIndex && !input.forward) ||
@@ -172,11 +178,9 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
                         obj[JS(hash)] = obj[txKey].as_object()[JS(hash)];
                         obj[txKey].as_object().erase(JS(hash));
                     }
-                    if (auto const ledgerHeader =
-                            sharedPtrBackend_->fetchLedgerBySequence(txnPlusMeta.ledgerSequence, ctx.yield);
-                        ledgerHeader) {
-                        obj[JS(ledger_hash)] = ripple::strHex(ledgerHeader->hash);
-                        obj[JS(close_time_iso)] = ripple::to_string_iso(ledgerHeader->closeTime);
+                    if (auto const it = ledgerHeaders.find(txnPlusMeta.ledgerSequence); it != ledgerHeaders.end()) {
+                        obj[JS(ledger_hash)] = ripple::strHex(it->second.hash);
+                        obj[JS(close_time_iso)] = ripple::to_string_iso(it->second.closeTime);
                     }
                 }
                 obj[JS(validated)] = true;
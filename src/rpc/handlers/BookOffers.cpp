@@ -63,10 +63,7 @@ BookOffersHandler::process(Input input, Context const& ctx) const
 
     auto const lgrInfo = std::get<ripple::LedgerHeader>(lgrInfoOrStatus);
     auto const book = std::get<ripple::Book>(bookMaybe);
-    auto const bookKey = getBookBase(book);
-
-    // TODO: Add perfomance metrics if needed in future
-    auto [offers, _] = sharedPtrBackend_->fetchBookOffers(bookKey, lgrInfo.seq, input.limit, ctx.yield);
+    auto const offers = fetchBookOffers(*sharedPtrBackend_, book, lgrInfo.seq, input.limit, ctx.yield);
 
     auto output = BookOffersHandler::Output{};
     output.ledgerHash = ripple::strHex(lgrInfo.hash);
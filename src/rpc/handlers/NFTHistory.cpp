@@ -43,6 +43,7 @@
 #include <limits>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 
@@ -117,6 +118,11 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
     if (retCursor)
         response.marker = {.ledger = retCursor->ledgerSequence, .seq = retCursor->transactionIndex};
 
+    // api v2 responses carry the hash and close time of the ledger of each transaction
+    auto const ledgerHeaders = !input.binary && ctx.apiVersion > 1u
+        ? fetchLedgerHeaders(*sharedPtrBackend_, blobs, ctx.yield)
+        : std::unordered_map<std::uint32_t, ripple::LedgerHeader>{};
+
     for (auto const& txnPlusMeta : blobs) {
         // over the range
         if ((txnPlusMeta.ledgerSequence < minIndex && !input.forward) ||
@@ -144,11 +150,9 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
                     obj[JS(hash)] = obj[txKey].at(JS(hash));
                     obj[txKey].as_object().erase(JS(hash));
                 }
-                if (auto const lgrInfo =
-                        sharedPtrBackend_->fetchLedgerBySequence(txnPlusMeta.ledgerSequence, ctx.yield);
-                    lgrInfo) {
-                    obj[JS(close_time_iso)] = ripple::to_string_iso(lgrInfo->closeTime);
-                    obj[JS(ledger_hash)] = ripple::strHex(lgrInfo->hash);
+                if (auto const it = ledgerHeaders.find(txnPlusMeta.ledgerSequence); it != ledgerHeaders.end()) {
+                    obj[JS(close_time_iso)] = ripple::to_string_iso(it->second.closeTime);
+                    obj[JS(ledger_hash)] = ripple::strHex(it->second.hash);
                 }
             }
         } else {
@@ -208,9 +208,7 @@ SubscribeHandler::subscribeToBooks(
             }
 
             auto const getOrderBook = [&](auto const& book, auto& snapshots) {
-                auto const bookBase = getBookBase(book);
-                auto const [offers, _] =
-                    sharedPtrBackend_->fetchBookOffers(bookBase, rng->maxSequence, kFETCH_LIMIT, yield);
+                auto const offers = fetchBookOffers(*sharedPtrBackend_, book, rng->maxSequence, kFETCH_LIMIT, yield);
 
                 // the taker is not really uesed, same issue with
                 // https://github.com/XRPLF/xrpl-dev-portal/issues/1818
@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/impl/AdmissionController.hpp"
+
+#include <chrono>
+#include <utility>
+
+namespace rpc::impl {
+
+AdmissionController::AdmissionController(Settings settings) : settings_{std::move(settings)}
+{
+}
+
+void
+AdmissionController::onJobStarted(std::chrono::microseconds wait, ClockType::time_point now)
+{
+    if (wait < settings_.targetWait) {
+        firstAboveTime_.reset();
+        overloaded_ = false;
+        return;
+    }
+
+    lastAboveTime_ = now;
+    if (not firstAboveTime_.has_value()) {
+        firstAboveTime_ = now + settings_.interval;
+    } else if (now >= *firstAboveTime_) {
+        overloaded_ = true;
+    }
+}
+
+bool
+AdmissionController::isOverloaded(bool hasBacklog, ClockType::time_point now) const
+{
+    // without jobs starting there is nothing to measure, so the last verdict expires after an interval
+    if (overloaded_ and now - lastAboveTime_ < settings_.interval)
+        return true;
+
+    if (hasBacklog and settings_.targetReadLatency.count() > 0 and settings_.readLatency)
+        return settings_.readLatency() > settings_.targetReadLatency;
+
+    return false;
+}
+
+}  // namespace rpc::impl
@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace rpc::impl {
+
+/**
+ * @brief Decides whether the work queue is overloaded, based on how long jobs wait in it.
+ *
+ * This follows CoDel (Controlled Delay): short bursts are fine as long as they drain quickly, so the queue is only
+ * considered overloaded once every job that started during a whole interval had waited longer than the target. It
+ * stays overloaded until a job waits less than the target again or no job waits longer than the target for an
+ * interval.
+ *
+ * Optionally the read latency of the database is taken into account too: while jobs are waiting in the queue and the
+ * database is slower than its target, admitting more work would only make every request slower.
+ *
+ * @note This class is not thread-safe; synchronisation is the responsibility of the owner.
+ */
+class AdmissionController {
+public:
+    using ClockType = std::chrono::steady_clock;
+
+    /**
+     * @brief The settings of the controller
+     */
+    struct Settings {
+        std::chrono::microseconds targetWait;
+        std::chrono::milliseconds interval;
+        std::chrono::microseconds targetReadLatency{0};                    ///< 0 means the latency is not checked
+        std::function<std::chrono::microseconds()> readLatency = nullptr;  ///< Provides the read latency of the DB
+    };
+
+private:
+    Settings settings_;
+
+    std::optional<ClockType::time_point> firstAboveTime_;
+    ClockType::time_point lastAboveTime_;
+    bool overloaded_ = false;
+
+public:
+    /**
+     * @brief Construct a new controller
+     *
+     * @param settings The settings to use
+     */
+    explicit AdmissionController(Settings settings);
+
+    /**
+     * @brief Record the time a job waited in the queue before it started
+     *
+     * @param wait The time the job waited
+     * @param now The time the job started
+     */
+    void
+    onJobStarted(std::chrono::microseconds wait, ClockType::time_point now = ClockType::now());
+
+    /**
+     * @brief Check whether new low priority jobs should be rejected
+     *
+     * @param hasBacklog Whether there are jobs waiting in the queue
+     * @param now The current time
+     * @return true if the queue is overloaded; false otherwise
+     */
+    [[nodiscard]] bool
+    isOverloaded(bool hasBacklog, ClockType::time_point now = ClockType::now()) const;
+};
+
+}  // namespace rpc::impl
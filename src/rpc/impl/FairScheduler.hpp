@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Assert.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rpc::impl {
+
+/**
+ * @brief A queue of jobs that are split into classes and, within each class, by client.
+ *
+ * Classes are served by smooth weighted round-robin: with weights {4, 2, 1} out of every 7 jobs popped while all the
+ * classes are busy 4 come from the first class, 2 from the second and 1 from the third, interleaved rather than in
+ * bursts. An empty class gives up its share to the others. Within a class clients are served in round-robin order so
+ * that a single client queueing many jobs can't delay the jobs of everyone else.
+ *
+ * @note This class is not thread-safe; synchronisation is the responsibility of the owner.
+ *
+ * @tparam JobType The type of the job stored in the queue
+ */
+template <typename JobType>
+class FairScheduler {
+    struct ClassQueue {
+        std::int64_t weight;
+        std::int64_t current = 0;
+        std::size_t size = 0;
+
+        std::unordered_map<std::string, std::deque<JobType>> jobsByClient;
+        std::deque<std::string> clients;  // clients having at least one job, in the order they are served
+    };
+
+    std::vector<ClassQueue> classes_;
+    std::size_t size_ = 0;
+
+public:
+    /**
+     * @brief Construct a new scheduler
+     *
+     * @param weights The weight of each class; the size of the vector is the number of classes
+     */
+    explicit FairScheduler(std::vector<std::int64_t> const& weights)
+    {
+        ASSERT(not weights.empty(), "At least one class is required");
+
+        classes_.reserve(weights.size());
+        for (auto const weight : weights) {
+            ASSERT(weight > 0, "Class weight must be positive");
+            classes_.push_back(ClassQueue{.weight = weight});
+        }
+    }
+
+    /**
+     * @brief Add a job to the queue
+     *
+     * @param costClass The index of the class of the job
+     * @param client The client the job belongs to
+     * @param job The job to add
+     */
+    void
+    push(std::size_t costClass, std::string const& client, JobType job)
+    {
+        ASSERT(costClass < classes_.size(), "Unknown class {}", costClass);
+        auto& queue = classes_[costClass];
+
+        auto& jobs = queue.jobsByClient[client];
+        if (jobs.empty())
+            queue.clients.push_back(client);
+
+        jobs.push_back(std::move(job));
+        ++queue.size;
+        ++size_;
+    }
+
+    /**
+     * @brief Take the next job to run out of the queue
+     *
+     * @return The job and the index of its class if the queue is not empty; nullopt otherwise
+     */
+    std::optional<std::pair<JobType, std::size_t>>
+    pop()
+    {
+        if (size_ == 0)
+            return std::nullopt;
+
+        std::int64_t totalWeight = 0;
+        ClassQueue* selected = nullptr;
+        for (auto& queue : classes_) {
+            if (queue.size == 0)
+                continue;
+
+            queue.current += queue.weight;
+            totalWeight += queue.weight;
+            if (selected == nullptr or queue.current > selected->current)
+                selected = &queue;
+        }
+
+        ASSERT(selected != nullptr, "Non-empty scheduler must have a non-empty class");
+        selected->current -= totalWeight;
+
+        auto client = std::move(selected->clients.front());
+        selected->clients.pop_front();
+
+        auto const it = selected->jobsByClient.find(client);
+        auto job = std::move(it->second.front());
+        it->second.pop_front();
+
+        if (it->second.empty()) {
+            selected->jobsByClient.erase(it);
+        } else {
+            selected->clients.push_back(std::move(client));
+        }
+
+        // an idle class must not accumulate credit to spend in a burst later
+        if (--selected->size == 0)
+            selected->current = 0;
+        --size_;
+
+        return std::make_pair(std::move(job), static_cast<std::size_t>(selected - classes_.data()));
+    }
+
+    /**
+     * @return The total number of jobs in the queue
+     */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @param costClass The index of the class
+     * @return The number of jobs of the given class in the queue
+     */
+    [[nodiscard]] std::size_t
+    size(std::size_t costClass) const
+    {
+        ASSERT(costClass < classes_.size(), "Unknown class {}", costClass);
+        return classes_[costClass].size;
+    }
+};
+
+}  // namespace rpc::impl
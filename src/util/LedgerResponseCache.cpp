@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/LedgerResponseCache.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/string.hpp>
+#include <boost/json/value.hpp>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+namespace {
+
+// request fields that identify the request or were already taken into account
+constexpr std::array<std::string_view, 4> kIGNORED_FIELDS{"id", "command", "method", "api_version"};
+
+void
+appendNormalized(std::string& out, boost::json::value const& value);
+
+void
+appendNormalized(std::string& out, boost::json::object const& object, bool skipIgnoredFields)
+{
+    std::vector<std::pair<std::string_view, boost::json::value const*>> fields;
+    fields.reserve(object.size());
+    for (auto const& [key, field] : object) {
+        if (not skipIgnoredFields or std::ranges::find(kIGNORED_FIELDS, std::string_view{key}) == kIGNORED_FIELDS.end())
+            fields.emplace_back(key, &field);
+    }
+    std::ranges::sort(fields, {}, [](auto const& field) { return field.first; });
+
+    out.push_back('{');
+    for (auto const& [key, field] : fields) {
+        out += boost::json::serialize(boost::json::string{key});
+        out.push_back(':');
+        appendNormalized(out, *field);
+        out.push_back(',');
+    }
+    out.push_back('}');
+}
+
+void
+appendNormalized(std::string& out, boost::json::value const& value)
+{
+    if (value.is_object()) {
+        appendNormalized(out, value.as_object(), false);
+    } else if (value.is_array()) {
+        out.push_back('[');
+        for (auto const& element : value.as_array()) {
+            appendNormalized(out, element);
+            out.push_back(',');
+        }
+        out.push_back(']');
+    } else {
+        out += boost::json::serialize(value);
+    }
+}
+
+}  // namespace
+
+LedgerResponseCache::LedgerResponseCache(
+    std::size_t maxEntries,
+    std::size_t maxBytes,
+    std::unordered_set<std::string> methods
+)
+    : maxEntries_(maxEntries), maxBytes_(maxBytes), methods_(std::move(methods))
+{
+}
+
+bool
+LedgerResponseCache::shouldCache(std::string const& method) const
+{
+    return maxEntries_ > 0 and maxBytes_ > 0 and methods_.contains(method);
+}
+
+std::optional<boost::json::object>
+LedgerResponseCache::get(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    std::uint32_t ledgerSequence
+)
+{
+    if (not shouldCache(method))
+        return std::nullopt;
+
+    ++reqCounter_.get();
+    auto const key = makeKey(method, params, apiVersion, ledgerSequence);
+
+    std::shared_ptr<boost::json::object const> response;
+    {
+        std::scoped_lock const lck{mtx_};
+        auto const it = entries_.find(key);
+        if (it == entries_.end())
+            return std::nullopt;
+
+        lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+        response = it->second.response;
+    }
+
+    ++hitCounter_.get();
+    return *response;
+}
+
+void
+LedgerResponseCache::put(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    std::uint32_t ledgerSequence,
+    bool latest,
+    boost::json::object response
+)
+{
+    if (not shouldCache(method))
+        return;
+
+    auto const bytes = boost::json::serialize(response).size();
+    if (bytes > maxBytes_)
+        return;
+
+    auto key = makeKey(method, params, apiVersion, ledgerSequence);
+    auto stored = std::make_shared<boost::json::object const>(std::move(response));
+
+    std::scoped_lock const lck{mtx_};
+
+    // a newer ledger was published while the request was processed
+    if (latest and ledgerSequence < latestSequence_)
+        return;
+
+    if (auto const it = entries_.find(key); it != entries_.end())
+        erase(it);
+
+    lru_.push_front(key);
+    numBytes_ += bytes;
+    entries_.emplace(
+        std::move(key),
+        Entry{
+            .response = std::move(stored),
+            .bytes = bytes,
+            .ledgerSequence = ledgerSequence,
+            .latest = latest,
+            .lruPosition = lru_.begin()
+        }
+    );
+
+    while (entries_.size() > maxEntries_ or numBytes_ > maxBytes_)
+        erase(entries_.find(lru_.back()));
+}
+
+void
+LedgerResponseCache::onLedgerRange(std::uint32_t minSequence, std::uint32_t maxSequence)
+{
+    std::scoped_lock const lck{mtx_};
+    if (maxSequence <= latestSequence_)
+        return;
+
+    latestSequence_ = maxSequence;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto const& entry = it->second;
+        if ((entry.latest and entry.ledgerSequence < maxSequence) or entry.ledgerSequence < minSequence) {
+            erase(std::exchange(it, std::next(it)));
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::size_t
+LedgerResponseCache::size() const
+{
+    std::scoped_lock const lck{mtx_};
+    return entries_.size();
+}
+
+std::size_t
+LedgerResponseCache::bytes() const
+{
+    std::scoped_lock const lck{mtx_};
+    return numBytes_;
+}
+
+std::string
+LedgerResponseCache::makeKey(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    std::uint32_t ledgerSequence
+)
+{
+    auto key = fmt::format("{}|{}|{}|", method, apiVersion, ledgerSequence);
+    appendNormalized(key, params, true);
+    return key;
+}
+
+void
+LedgerResponseCache::erase(std::unordered_map<std::string, Entry>::iterator it)
+{
+    lru_.erase(it->second.lruPosition);
+    numBytes_ -= it->second.bytes;
+    entries_.erase(it);
+}
+
+}  // namespace util
@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/json/object.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace util {
+
+/**
+ * @brief Cache of RPC responses for requests that read a fixed ledger.
+ *
+ * Responses are keyed by method, normalized request parameters, API version and the sequence of the ledger the request
+ * was resolved to. A validated ledger never changes, so entries don't expire with time. Instead, responses to requests
+ * that were resolved to the latest validated ledger are dropped once a newer ledger is published, and all responses
+ * for ledgers that fell out of the available range are dropped. The cache is bounded by the number of entries and by
+ * the serialized size of the responses, with least recently used entries evicted first.
+ */
+class LedgerResponseCache {
+    struct Entry {
+        std::shared_ptr<boost::json::object const> response;
+        std::size_t bytes = 0;
+        std::uint32_t ledgerSequence = 0;
+        bool latest = false;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    std::size_t maxEntries_;
+    std::size_t maxBytes_;
+    std::unordered_set<std::string> methods_;
+
+    mutable std::mutex mtx_;
+    std::unordered_map<std::string, Entry> entries_;
+    // most recently used key first
+    std::list<std::string> lru_;
+    std::size_t numBytes_ = 0;
+    std::uint32_t latestSequence_ = 0;
+
+    std::reference_wrapper<util::prometheus::CounterInt> reqCounter_{PrometheusService::counterInt(
+        "rpc_response_cache_counter_total_number",
+        util::prometheus::Labels{{{"type", "request"}}},
+        "Ledger aware RPC response cache statistics"
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_{PrometheusService::counterInt(
+        "rpc_response_cache_counter_total_number",
+        util::prometheus::Labels{{{"type", "cache_hit"}}}
+    )};
+
+public:
+    /**
+     * @brief Construct a new LedgerResponseCache
+     *
+     * @param maxEntries The maximum number of cached responses
+     * @param maxBytes The maximum serialized size of all cached responses together
+     * @param methods The methods whose responses should be cached
+     */
+    LedgerResponseCache(std::size_t maxEntries, std::size_t maxBytes, std::unordered_set<std::string> methods);
+
+    /**
+     * @brief Check whether responses of the given method are cached
+     *
+     * @param method The method
+     * @return true if the method is cached; false otherwise
+     */
+    [[nodiscard]] bool
+    shouldCache(std::string const& method) const;
+
+    /**
+     * @brief Get a cached response
+     *
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param ledgerSequence The sequence of the ledger the request was resolved to
+     * @return The response if cached; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<boost::json::object>
+    get(std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        std::uint32_t ledgerSequence);
+
+    /**
+     * @brief Put a response into the cache if the method should be cached
+     *
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param ledgerSequence The sequence of the ledger the request was resolved to
+     * @param latest Whether the request did not name a ledger and was resolved to the latest validated one
+     * @param response The response to store
+     */
+    void
+    put(std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        std::uint32_t ledgerSequence,
+        bool latest,
+        boost::json::object response);
+
+    /**
+     * @brief Drop the responses that can't be served anymore after the available ledger range changed
+     *
+     * @param minSequence The oldest available ledger
+     * @param maxSequence The latest validated ledger
+     */
+    void
+    onLedgerRange(std::uint32_t minSequence, std::uint32_t maxSequence);
+
+    /**
+     * @return The number of cached responses
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * @return The serialized size of all cached responses together
+     */
+    [[nodiscard]] std::size_t
+    bytes() const;
+
+    /**
+     * @brief Build the cache key of a request
+     *
+     * Object keys are sorted and the fields that don't affect the response (id, command, method and api_version) are
+     * dropped so that equivalent requests map to the same key.
+     *
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param ledgerSequence The sequence of the ledger the request was resolved to
+     * @return The key
+     */
+    [[nodiscard]] static std::string
+    makeKey(
+        std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        std::uint32_t ledgerSequence
+    );
+
+private:
+    void
+    erase(std::unordered_map<std::string, Entry>::iterator it);
+};
+
+}  // namespace util
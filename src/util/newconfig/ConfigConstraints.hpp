@@ -84,6 +84,11 @@ static constexpr std::array<char const*, 1> kDATABASE_TYPE = {"cassandra"};
  */
 static constexpr std::array<char const*, 2> kPROCESSING_POLICY = {"parallel", "sequent"};
 
+/**
+ * @brief specific values that are accepted for cassandra read consistency levels in config.
+ */
+static constexpr std::array<char const*, 4> kREAD_CONSISTENCY = {"quorum", "local_quorum", "one", "local_one"};
+
 /**
  * @brief An interface to enforce constraints on certain values within ClioConfigDefinition.
  */
@@ -352,6 +357,7 @@ static constinit OneOf gValidateCassandraName{"database.type", kDATABASE_TYPE};
 static constinit OneOf gValidateLoadMode{"cache.load", kLOAD_CACHE_MODE};
 static constinit OneOf gValidateLogTag{"log_tag_style", kLOG_TAGS};
 static constinit OneOf gValidateProcessingPolicy{"server.processing_policy", kPROCESSING_POLICY};
+static constinit OneOf gValidateReadConsistency{"database.cassandra.immutable_read_consistency", kREAD_CONSISTENCY};
 
 static constinit PositiveDouble gValidatePositiveDouble{};
 
@@ -370,6 +376,10 @@ static constinit NumberValueConstraint<uint32_t> gValidateUint32{
     std::numeric_limits<uint32_t>::min(),
     std::numeric_limits<uint32_t>::max()
 };
+// zlib doesn't support a window of 8 bits for raw deflate streams, so permessage-deflate window is 9 to 15 bits
+static constinit NumberValueConstraint<uint32_t> gValidateDeflateWindowBits{9, 15};
+static constinit NumberValueConstraint<uint32_t> gValidateDeflateLevel{0, 9};
+static constinit NumberValueConstraint<uint32_t> gValidateDeflateMemoryLevel{1, 9};
 static constinit NumberValueConstraint<uint32_t> gValidateApiVersion{rpc::kAPI_VERSION_MIN, rpc::kAPI_VERSION_MAX};
 
 }  // namespace util::config
@@ -30,6 +30,7 @@
 #include "util/newconfig/ObjectView.hpp"
 #include "util/newconfig/Types.hpp"
 #include "util/newconfig/ValueView.hpp"
+#include "web/WsCompressionDefaults.hpp"
 
 #include <boost/json/value.hpp>
 #include <boost/json/value_to.hpp>
@@ -308,6 +309,18 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
      {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint16)},
      {"database.cassandra.write_batch_size",
       ConfigValue{ConfigType::Integer}.defaultValue(20).withConstraint(gValidateUint16)},
+     {"database.cassandra.read_page_size",
+      ConfigValue{ConfigType::Integer}.defaultValue(5000).withConstraint(gValidateUint16)},
+     {"database.cassandra.immutable_read_consistency",
+      ConfigValue{ConfigType::String}.defaultValue("quorum").withConstraint(gValidateReadConsistency)},
+     {"database.cassandra.speculative_execution_delay",
+      ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)},
+     {"database.cassandra.max_speculative_executions",
+      ConfigValue{ConfigType::Integer}.defaultValue(1).withConstraint(gValidateUint16)},
+     {"database.cassandra.hedge_reads", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"database.cassandra.account_tx_cache.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"database.cassandra.account_tx_cache.max_bytes",
+      ConfigValue{ConfigType::Integer}.defaultValue(16 * 1024 * 1024).withConstraint(gValidateUint32)},
      {"database.cassandra.connect_timeout", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)
      },
      {"database.cassandra.request_timeout", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)
@@ -328,6 +341,11 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
       ConfigValue{ConfigType::Double}.defaultValue(10.0).withConstraint(gValidatePositiveDouble)},
 
      {"rpc.cache_timeout", ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(gValidatePositiveDouble)},
+     {"rpc.response_cache.methods.[]", Array{ConfigValue{ConfigType::String}.optional()}},
+     {"rpc.response_cache.max_entries",
+      ConfigValue{ConfigType::Integer}.defaultValue(1024).withConstraint(gValidateUint32)},
+     {"rpc.response_cache.max_bytes",
+      ConfigValue{ConfigType::Integer}.defaultValue(64 * 1024 * 1024).withConstraint(gValidateUint32)},
 
      {"num_markers", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateNumMarkers)},
 
@@ -346,6 +364,14 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
      {"server.ip", ConfigValue{ConfigType::String}.withConstraint(gValidateIp)},
      {"server.port", ConfigValue{ConfigType::Integer}.withConstraint(gValidatePort)},
      {"server.max_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(gValidateUint32)},
+     {"server.max_running_requests", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(gValidateUint32)},
+     {"server.load_shedding.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"server.load_shedding.target_wait_ms",
+      ConfigValue{ConfigType::Integer}.defaultValue(5).withConstraint(gValidateUint32)},
+     {"server.load_shedding.interval_ms",
+      ConfigValue{ConfigType::Integer}.defaultValue(100).withConstraint(gValidateUint32)},
+     {"server.load_shedding.target_read_latency_ms",
+      ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(gValidateUint32)},
      {"server.local_admin", ConfigValue{ConfigType::Boolean}.optional()},
      {"server.admin_password", ConfigValue{ConfigType::String}.optional()},
      {"server.processing_policy",
@@ -353,6 +379,29 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
      {"server.parallel_requests_limit", ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint16)},
      {"server.ws_max_sending_queue_size",
       ConfigValue{ConfigType::Integer}.defaultValue(1500).withConstraint(gValidateUint32)},
+     {"server.ws_compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"server.ws_compression.server_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"server.ws_compression.client_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"server.ws_compression.server_max_window_bits",
+      ConfigValue{ConfigType::Integer}
+          .defaultValue(web::kWS_COMPRESSION_DEFAULT_MAX_WINDOW_BITS)
+          .withConstraint(gValidateDeflateWindowBits)},
+     {"server.ws_compression.client_max_window_bits",
+      ConfigValue{ConfigType::Integer}
+          .defaultValue(web::kWS_COMPRESSION_DEFAULT_MAX_WINDOW_BITS)
+          .withConstraint(gValidateDeflateWindowBits)},
+     {"server.ws_compression.level",
+      ConfigValue{ConfigType::Integer}
+          .defaultValue(web::kWS_COMPRESSION_DEFAULT_LEVEL)
+          .withConstraint(gValidateDeflateLevel)},
+     {"server.ws_compression.memory_level",
+      ConfigValue{ConfigType::Integer}
+          .defaultValue(web::kWS_COMPRESSION_DEFAULT_MEMORY_LEVEL)
+          .withConstraint(gValidateDeflateMemoryLevel)},
+     {"server.ws_compression.min_message_size",
+      ConfigValue{ConfigType::Integer}
+          .defaultValue(static_cast<uint32_t>(web::kWS_COMPRESSION_DEFAULT_MIN_MESSAGE_SIZE))
+          .withConstraint(gValidateUint32)},
      {"server.__ng_web_server", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
 
      {"prometheus.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
@@ -371,6 +420,8 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
      },
      {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512).withConstraint(gValidateUint16)},
      {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async").withConstraint(gValidateLoadMode)},
+     {"cache.num_retained_ledgers", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(gValidateUint16)},
+     {"cache.order_book_index", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
 
      {"log_channels.[].channel", Array{ConfigValue{ConfigType::String}.optional().withConstraint(gValidateChannelName)}
      },
@@ -400,6 +451,8 @@ static ClioConfigDefinition gClioConfig = ClioConfigDefinition{
 
      {"extractor_threads", ConfigValue{ConfigType::Integer}.defaultValue(1u).withConstraint(gValidateUint32)},
 
+     {"adaptive_extractor_threads", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+
      {"read_only", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
 
      {"txn_threshold", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(gValidateUint16)},
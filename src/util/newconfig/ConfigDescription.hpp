@@ -85,6 +85,24 @@ private:
            .value = "Number of core connections per host for Cassandra."},
         KV{.key = "database.cassandra.queue_size_io", .value = "Queue size for I/O operations in Cassandra."},
         KV{.key = "database.cassandra.write_batch_size", .value = "Batch size for write operations in Cassandra."},
+        KV{.key = "database.cassandra.read_page_size",
+           .value = "Number of rows fetched per page when reading large results from Cassandra."},
+        KV{.key = "database.cassandra.immutable_read_consistency",
+           .value = "Consistency level of reads of data that never changes once written, such as transactions and "
+                    "ledger headers. One of `quorum`, `local_quorum`, `one` and `local_one`."},
+        KV{.key = "database.cassandra.speculative_execution_delay",
+           .value = "Delay in milliseconds after which the Cassandra driver also sends a read to another node. "
+                    "Speculative execution is disabled if not set."},
+        KV{.key = "database.cassandra.max_speculative_executions",
+           .value = "The maximum number of additional nodes the Cassandra driver sends one read to."},
+        KV{.key = "database.cassandra.hedge_reads",
+           .value = "Whether single reads that take longer than the recent 95th percentile of read latency are sent "
+                    "a second time, using whichever answer comes first."},
+        KV{.key = "database.cassandra.account_tx_cache.enabled",
+           .value = "Whether recently read pages of account transactions are cached in memory."},
+        KV{.key = "database.cassandra.account_tx_cache.max_bytes",
+           .value = "Maximum size in bytes of the transaction and metadata blobs held by the account transactions "
+                    "cache."},
         KV{.key = "database.cassandra.connect_timeout",
            .value = "The maximum amount of time in seconds the system will wait for a connection to be successfully "
                     "established "
@@ -107,6 +125,13 @@ private:
         KV{.key = "forwarding.request_timeout",
            .value = "Timeout duration for the forwarding request used in Rippled communication."},
         KV{.key = "rpc.cache_timeout", .value = "Timeout duration for the rpc request."},
+        KV{.key = "rpc.response_cache.methods.[]",
+           .value = "List of RPC methods whose responses are cached per ledger, e.g. ledger, ledger_entry, book_offers "
+                    "and account_info. Empty by default, which disables the cache."},
+        KV{.key = "rpc.response_cache.max_entries",
+           .value = "Maximum number of responses kept by the per ledger RPC response cache."},
+        KV{.key = "rpc.response_cache.max_bytes",
+           .value = "Maximum serialized size in bytes of the responses kept by the per ledger RPC response cache."},
         KV{.key = "num_markers",
            .value = "The number of markers is the number of coroutines to load the cache concurrently."},
         KV{.key = "dos_guard.[].whitelist", .value = "List of IP addresses to whitelist for DOS protection."},
@@ -120,6 +145,20 @@ private:
         KV{.key = "server.port", .value = "Port number of the Clio HTTP server."},
         KV{.key = "server.max_queue_size",
            .value = "Maximum size of the server's request queue. Value of 0 is no limit."},
+        KV{.key = "server.max_running_requests",
+           .value = "Maximum number of requests processed at the same time; the rest wait in the queue and are "
+                    "scheduled fairly across request types and clients. Value of 0 is 16 requests per worker."},
+        KV{.key = "server.load_shedding.enabled",
+           .value = "If true, requests other than cheap ones are rejected as too busy while the request queue is "
+                    "overloaded."},
+        KV{.key = "server.load_shedding.target_wait_ms",
+           .value = "The queue is overloaded when requests keep waiting longer than this many milliseconds to start."},
+        KV{.key = "server.load_shedding.interval_ms",
+           .value = "How long in milliseconds requests must keep waiting longer than the target before the queue is "
+                    "considered overloaded."},
+        KV{.key = "server.load_shedding.target_read_latency_ms",
+           .value = "The queue is also overloaded when requests are waiting and the database read latency exceeds "
+                    "this many milliseconds. Value of 0 disables the check."},
         KV{.key = "server.local_admin", .value = "Indicates if the server should run with admin privileges."},
         KV{.key = "server.admin_password", .value = "Password for Clio admin-only APIs."},
         KV{.key = "server.processing_policy",
@@ -131,12 +170,29 @@ private:
          "parallel". It limits the number of requests for a single client connection that are processed in parallel. If not specified, the limit is infinite.)"
         },
         KV{.key = "server.ws_max_sending_queue_size", .value = "Maximum size of the websocket sending queue."},
+        KV{.key = "server.ws_compression.enabled",
+           .value = "If true, the permessage-deflate extension is offered to websocket clients."},
+        KV{.key = "server.ws_compression.server_no_context_takeover",
+           .value = "If true, Clio resets the compression context after every message. Uses less memory per "
+                    "connection at the cost of a lower compression ratio."},
+        KV{.key = "server.ws_compression.client_no_context_takeover",
+           .value = "If true, clients are asked to reset their compression context after every message."},
+        KV{.key = "server.ws_compression.server_max_window_bits",
+           .value = "Size of the window used by Clio to compress messages, as a power of two from 9 to 15."},
+        KV{.key = "server.ws_compression.client_max_window_bits",
+           .value = "Maximum size of the window clients may use to compress messages, as a power of two from 9 to "
+                    "15."},
+        KV{.key = "server.ws_compression.level", .value = "Deflate compression level from 0 to 9."},
+        KV{.key = "server.ws_compression.memory_level", .value = "Deflate memory level from 1 to 9."},
+        KV{.key = "server.ws_compression.min_message_size",
+           .value = "Messages shorter than this many bytes are sent uncompressed."},
         KV{.key = "prometheus.enabled", .value = "Enable or disable Prometheus metrics."},
         KV{.key = "prometheus.compress_reply", .value = "Enable or disable compression of Prometheus responses."},
         KV{.key = "io_threads", .value = "Number of I/O threads. Value must be greater than 1"},
         KV{.key = "subscription_workers",
            .value = "The number of worker threads or processes that are responsible for managing and processing "
-                    "subscription-based tasks."},
+                    "subscription-based tasks. The transactions feed is published to its subscribers on as many "
+                    "strands."},
         KV{.key = "graceful_period", .value = "Number of milliseconds server will wait to shutdown gracefully."},
         KV{.key = "cache.num_diffs", .value = "Number of diffs to cache."},
         KV{.key = "cache.num_markers", .value = "Number of markers to cache."},
@@ -144,6 +200,10 @@ private:
         KV{.key = "cache.num_cursors_from_account", .value = "Number of cursors from an account."},
         KV{.key = "cache.page_fetch_size", .value = "Page fetch size for cache operations."},
         KV{.key = "cache.load", .value = "Cache loading strategy ('sync' or 'async')."},
+        KV{.key = "cache.num_retained_ledgers",
+           .value = "Number of ledgers before the latest one for which the cache keeps object versions."},
+        KV{.key = "cache.order_book_index",
+           .value = "Whether to maintain an in-memory index of all order books once the cache is full."},
         KV{.key = "log_channels.[].channel", .value = "Name of the log channel."},
         KV{.key = "log_channels.[].log_level", .value = "Log level for the log channel."},
         KV{.key = "log_level", .value = "General logging level of Clio."},
@@ -155,6 +215,9 @@ private:
         KV{.key = "log_rotation_hour_interval", .value = "Interval in hours for log rotation."},
         KV{.key = "log_tag_style", .value = "Style for log tags."},
         KV{.key = "extractor_threads", .value = "Number of extractor threads."},
+        KV{.key = "adaptive_extractor_threads",
+           .value = "If true, extractor_threads is the upper limit and the number of extractors fetching at the same "
+                    "time is adjusted to the load of the ETL sources, the transformer and the database."},
         KV{.key = "read_only", .value = "Indicates if the server should have read-only privileges."},
         KV{.key = "txn_threshold", .value = "Transaction threshold value."},
         KV{.key = "start_sequence", .value = "Starting ledger index."},
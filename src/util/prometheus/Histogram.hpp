@@ -23,6 +23,7 @@
 #include "util/prometheus/MetricBase.hpp"
 #include "util/prometheus/OStream.hpp"
 #include "util/prometheus/impl/HistogramImpl.hpp"
+#include "util/prometheus/impl/ShardedHistogramImpl.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -53,7 +54,7 @@ public:
      * @param buckets The buckets of the histogram
      * @param impl The implementation of the histogram (has default value and need to be specified only for testing)
      */
-    template <impl::SomeHistogramImpl ImplType = impl::HistogramImpl<ValueType>>
+    template <impl::SomeHistogramImpl ImplType = impl::ShardedHistogramImpl<ValueType>>
         requires std::same_as<ValueType, typename std::remove_cvref_t<ImplType>::ValueType>
     AnyHistogram(std::string name, std::string labelsString, Buckets const& buckets, ImplType&& impl = ImplType{})
         : MetricBase(std::move(name), std::move(labelsString))
@@ -24,6 +24,7 @@
 #include "util/Mutex.hpp"
 #include "util/prometheus/OStream.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -44,6 +45,55 @@ concept SomeHistogramImpl = requires(T t) {
     { t.serializeValue(std::string{}, std::string{}, std::declval<OStream&>()) } -> std::same_as<void>;
 };
 
+/**
+ * @brief Serialize histogram data in Prometheus format
+ *
+ * @param name The name of the metric
+ * @param labelsString The labels of the metric in serialized format, e.g. {name="value",name2="value2"}
+ * @param bounds The upper bounds of the buckets
+ * @param counts The number of observations in each bucket followed by the number of observations above the last bound
+ * @param sum The sum of all observations
+ * @param stream The stream to serialize into
+ */
+template <SomeNumberType ValueType>
+void
+serializeHistogram(
+    std::string const& name,
+    std::string labelsString,
+    std::vector<ValueType> const& bounds,
+    std::vector<std::uint64_t> const& counts,
+    ValueType const sum,
+    OStream& stream
+)
+{
+    ASSERT(counts.size() == bounds.size() + 1, "Histogram must have a count for every bucket and +Inf.");
+    if (labelsString.empty()) {
+        labelsString = "{";
+    } else {
+        ASSERT(
+            labelsString.front() == '{' && labelsString.back() == '}', "Labels must be in Prometheus serialized format."
+        );
+        labelsString.back() = ',';
+    }
+
+    std::uint64_t cumulativeCount = 0;
+
+    for (std::size_t i = 0; i < bounds.size(); ++i) {
+        cumulativeCount += counts[i];
+        stream << name << "_bucket" << labelsString << "le=\"" << bounds[i] << "\"} " << cumulativeCount << '\n';
+    }
+    cumulativeCount += counts.back();
+    stream << name << "_bucket" << labelsString << "le=\"+Inf\"} " << cumulativeCount << '\n';
+
+    if (labelsString.size() == 1) {
+        labelsString = "";
+    } else {
+        labelsString.back() = '}';
+    }
+    stream << name << "_sum" << labelsString << " " << sum << '\n';
+    stream << name << "_count" << labelsString << " " << cumulativeCount << '\n';
+}
+
 template <SomeNumberType NumberType>
 class HistogramImpl {
 public:
@@ -91,34 +141,18 @@ public:
     void
     serializeValue(std::string const& name, std::string labelsString, OStream& stream) const
     {
-        if (labelsString.empty()) {
-            labelsString = "{";
-        } else {
-            ASSERT(
-                labelsString.front() == '{' && labelsString.back() == '}',
-                "Labels must be in Prometheus serialized format."
-            );
-            labelsString.back() = ',';
-        }
-
         auto data = data_->template lock<std::scoped_lock>();
-        std::uint64_t cumulativeCount = 0;
-
+        std::vector<ValueType> bounds;
+        std::vector<std::uint64_t> counts;
+        bounds.reserve(data->buckets.size());
+        counts.reserve(data->buckets.size() + 1);
         for (auto const& bucket : data->buckets) {
-            cumulativeCount += bucket.count;
-            stream << name << "_bucket" << labelsString << "le=\"" << bucket.upperBound << "\"} " << cumulativeCount
-                   << '\n';
+            bounds.push_back(bucket.upperBound);
+            counts.push_back(bucket.count);
         }
-        cumulativeCount += data->lastBucket.count;
-        stream << name << "_bucket" << labelsString << "le=\"+Inf\"} " << cumulativeCount << '\n';
+        counts.push_back(data->lastBucket.count);
 
-        if (labelsString.size() == 1) {
-            labelsString = "";
-        } else {
-            labelsString.back() = '}';
-        }
-        stream << name << "_sum" << labelsString << " " << data->sum << '\n';
-        stream << name << "_count" << labelsString << " " << cumulativeCount << '\n';
+        serializeHistogram(name, std::move(labelsString), bounds, counts, data->sum, stream);
     }
 
 private:
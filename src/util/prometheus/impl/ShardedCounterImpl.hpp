@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Atomic.hpp"
+#include "util/Concepts.hpp"
+#include "util/prometheus/impl/Sharding.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace util::prometheus::impl {
+
+/**
+ * @brief Counter implementation that spreads additions over cache line sized shards.
+ *
+ * Every thread adds to its own shard so concurrent increments don't bounce a single cache line between cores. The
+ * shards are summed up only when the value is read, i.e. when metrics are collected.
+ *
+ * @note set() is not atomic with respect to concurrent add() calls. It's meant for resetting the counter.
+ */
+template <SomeNumberType NumberType>
+class ShardedCounterImpl {
+public:
+    using ValueType = NumberType;
+
+    void
+    add(ValueType const value)
+    {
+        shards_[currentShard()].value.add(value);
+    }
+
+    void
+    set(ValueType const value)
+    {
+        shards_.front().value.set(value);
+        for (std::size_t i = 1; i < shards_.size(); ++i)
+            shards_[i].value.set(ValueType{0});
+    }
+
+    ValueType
+    value() const
+    {
+        ValueType result{0};
+        for (auto const& shard : shards_)
+            result += shard.value.value();
+        return result;
+    }
+
+private:
+    struct alignas(kCACHE_LINE_SIZE) Shard {
+        Atomic<ValueType> value{0};
+    };
+
+    std::vector<Shard> shards_ = std::vector<Shard>(kNUM_SHARDS);
+};
+
+}  // namespace util::prometheus::impl
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Assert.hpp"
+#include "util/Atomic.hpp"
+#include "util/Concepts.hpp"
+#include "util/prometheus/OStream.hpp"
+#include "util/prometheus/impl/HistogramImpl.hpp"
+#include "util/prometheus/impl/Sharding.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace util::prometheus::impl {
+
+/**
+ * @brief Lock-free histogram implementation that keeps a separate set of bucket counters per shard.
+ *
+ * observe() only does relaxed atomic increments in the calling thread's shard. Shards are merged when the histogram
+ * is serialized, i.e. when metrics are collected. Observations made concurrently with serialization may be reflected
+ * in the bucket counts but not yet in the sum (or the other way round); this is fine for monitoring purposes.
+ */
+template <SomeNumberType NumberType>
+class ShardedHistogramImpl {
+public:
+    using ValueType = NumberType;
+
+    void
+    setBuckets(std::vector<ValueType> const& bounds)
+    {
+        ASSERT(bounds_.empty() && counts_.empty(), "Buckets can be set only once.");
+        bounds_ = bounds;
+
+        // each shard gets its own cache lines: one counter per bucket plus one for +Inf
+        linesPerShard_ = (bounds_.size() + kCOUNTS_PER_LINE) / kCOUNTS_PER_LINE;
+        counts_ = std::vector<CountsLine>(linesPerShard_ * kNUM_SHARDS);
+    }
+
+    void
+    observe(ValueType const value)
+    {
+        auto const shard = currentShard();
+        auto const bucket =
+            static_cast<std::size_t>(std::distance(bounds_.begin(), std::ranges::lower_bound(bounds_, value)));
+
+        counter(shard, bucket).fetch_add(1, std::memory_order_relaxed);
+        sums_[shard].value.add(value);
+    }
+
+    void
+    serializeValue(std::string const& name, std::string labelsString, OStream& stream) const
+    {
+        std::vector<std::uint64_t> counts(bounds_.size() + 1, 0);
+        ValueType sum{0};
+
+        for (std::size_t shard = 0; shard < kNUM_SHARDS; ++shard) {
+            for (std::size_t bucket = 0; bucket < counts.size(); ++bucket)
+                counts[bucket] += counter(shard, bucket).load(std::memory_order_relaxed);
+            sum += sums_[shard].value.value();
+        }
+
+        serializeHistogram(name, std::move(labelsString), bounds_, counts, sum, stream);
+    }
+
+private:
+    static constexpr std::size_t kCOUNTS_PER_LINE = kCACHE_LINE_SIZE / sizeof(std::atomic_uint64_t);
+
+    struct alignas(kCACHE_LINE_SIZE) CountsLine {
+        std::array<std::atomic_uint64_t, kCOUNTS_PER_LINE> counts{};
+    };
+
+    struct alignas(kCACHE_LINE_SIZE) Sum {
+        Atomic<ValueType> value{0};
+    };
+
+    std::atomic_uint64_t&
+    counter(std::size_t const shard, std::size_t const bucket)
+    {
+        return counts_[(shard * linesPerShard_) + (bucket / kCOUNTS_PER_LINE)].counts[bucket % kCOUNTS_PER_LINE];
+    }
+
+    std::atomic_uint64_t const&
+    counter(std::size_t const shard, std::size_t const bucket) const
+    {
+        return counts_[(shard * linesPerShard_) + (bucket / kCOUNTS_PER_LINE)].counts[bucket % kCOUNTS_PER_LINE];
+    }
+
+    std::vector<ValueType> bounds_;
+    std::size_t linesPerShard_ = 0;
+    std::vector<CountsLine> counts_;
+    std::vector<Sum> sums_ = std::vector<Sum>(kNUM_SHARDS);
+};
+
+}  // namespace util::prometheus::impl
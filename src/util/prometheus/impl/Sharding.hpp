@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace util::prometheus::impl {
+
+/** @brief Number of shards used by the sharded counter and histogram implementations */
+static constexpr std::size_t kNUM_SHARDS = 16;
+
+/** @brief Shards are aligned to this size so that two shards never share a cache line */
+static constexpr std::size_t kCACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Get the shard the calling thread should write to.
+ *
+ * Threads are assigned to shards round-robin the first time they touch a sharded metric, so up to kNUM_SHARDS
+ * threads never contend on the same cache line.
+ *
+ * @return The index of the shard in [0, kNUM_SHARDS)
+ */
+inline std::size_t
+currentShard()
+{
+    static std::atomic_size_t kNEXT_THREAD{0};
+    thread_local std::size_t const kSHARD = kNEXT_THREAD.fetch_add(1, std::memory_order_relaxed) % kNUM_SHARDS;
+    return kSHARD;
+}
+
+}  // namespace util::prometheus::impl
@@ -22,6 +22,7 @@
 #include "util/Taggable.hpp"
 #include "web/AdminVerificationStrategy.hpp"
 #include "web/PlainWsSession.hpp"
+#include "web/WsCompression.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/HttpBase.hpp"
 #include "web/interface/Concepts.hpp"
@@ -56,6 +57,7 @@ class HttpSession : public impl::HttpBase<HttpSession, HandlerType>,
     boost::beast::tcp_stream stream_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
     std::uint32_t maxWsSendingQueueSize_;
+    WsCompressionOptions wsCompression_;
 
 public:
     /**
@@ -69,6 +71,7 @@ public:
      * @param handler The server handler to use
      * @param buffer Buffer with initial data received from the peer
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param wsCompression The permessage-deflate settings for websocket
      */
     explicit HttpSession(
         tcp::socket&& socket,
@@ -78,7 +81,8 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer buffer,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        WsCompressionOptions wsCompression
     )
         : impl::HttpBase<HttpSession, HandlerType>(
               ip,
@@ -91,6 +95,7 @@ public:
         , stream_(std::move(socket))
         , tagFactory_(tagFactory)
         , maxWsSendingQueueSize_(maxWsSendingQueueSize)
+        , wsCompression_(wsCompression)
     {
     }
 
@@ -136,7 +141,8 @@ public:
             std::move(this->buffer_),
             std::move(this->req_),
             ConnectionBase::isAdmin(),
-            maxWsSendingQueueSize_
+            maxWsSendingQueueSize_,
+            wsCompression_
         )
             ->run();
     }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "util/Taggable.hpp"
+#include "web/WsCompression.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/WsBase.hpp"
 #include "web/interface/ConnectionBase.hpp"
@@ -64,6 +65,7 @@ public:
      * @param buffer Buffer with initial data received from the peer
      * @param isAdmin Whether the connection has admin privileges,
      * @param maxSendingQueueSize The maximum size of the sending queue for websocket
+     * @param compression The permessage-deflate settings
      */
     explicit PlainWsSession(
         boost::asio::ip::tcp::socket&& socket,
@@ -73,7 +75,8 @@ public:
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer&& buffer,
         bool isAdmin,
-        std::uint32_t maxSendingQueueSize
+        std::uint32_t maxSendingQueueSize,
+        WsCompressionOptions compression
     )
         : impl::WsBase<PlainWsSession, HandlerType>(
               ip,
@@ -81,7 +84,8 @@ public:
               dosGuard,
               handler,
               std::move(buffer),
-              maxSendingQueueSize
+              maxSendingQueueSize,
+              compression
           )
         , ws_(std::move(socket))
     {
@@ -117,6 +121,7 @@ class WsUpgrader : public std::enable_shared_from_this<WsUpgrader<HandlerType>>
     std::shared_ptr<HandlerType> const handler_;
     bool isAdmin_;
     std::uint32_t maxWsSendingQueueSize_;
+    WsCompressionOptions wsCompression_;
 
 public:
     /**
@@ -131,6 +136,7 @@ public:
      * @param request The request. Ownership is transferred
      * @param isAdmin Whether the connection has admin privileges
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param wsCompression The permessage-deflate settings for websocket
      */
     WsUpgrader(
         boost::beast::tcp_stream&& stream,
@@ -141,7 +147,8 @@ public:
         boost::beast::flat_buffer&& buffer,
         http::request<http::string_body> request,
         bool isAdmin,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        WsCompressionOptions wsCompression
     )
         : http_(std::move(stream))
         , buffer_(std::move(buffer))
@@ -152,6 +159,7 @@ public:
         , handler_(handler)
         , isAdmin_(isAdmin)
         , maxWsSendingQueueSize_(maxWsSendingQueueSize)
+        , wsCompression_(wsCompression)
     {
     }
 
@@ -195,7 +203,8 @@ private:
             handler_,
             std::move(buffer_),
             isAdmin_,
-            maxWsSendingQueueSize_
+            maxWsSendingQueueSize_,
+            wsCompression_
         )
             ->run(std::move(req_));
     }
@@ -108,11 +108,13 @@ public:
             if (not connection->upgraded and shouldReplaceParams(req))
                 req[JS(params)] = boost::json::array({boost::json::object{}});
 
+            auto const method = rpc::getRequestMethod(req);
             if (!rpcEngine_->post(
                     [this, request = std::move(req), connection](boost::asio::yield_context yield) mutable {
                         handleRequest(yield, std::move(request), connection);
                     },
-                    connection->clientIp
+                    connection->clientIp,
+                    method
                 )) {
                 rpcEngine_->notifyTooBusy();
                 web::impl::ErrorHelper(connection).sendTooBusyError();
@@ -259,7 +261,7 @@ private:
                 warnings.emplace_back(rpc::makeWarning(rpc::WarnRpcOutdated));
 
             response["warnings"] = warnings;
-            connection->send(boost::json::serialize(response));
+            connection->send(std::move(response));
         } catch (std::exception const& ex) {
             // note: while we are catching this in buildResponse too, this is here to make sure
             // that any other code that may throw is outside of buildResponse is also worked around.
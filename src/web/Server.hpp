@@ -24,6 +24,7 @@
 #include "web/AdminVerificationStrategy.hpp"
 #include "web/HttpSession.hpp"
 #include "web/SslHttpSession.hpp"
+#include "web/WsCompression.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/interface/Concepts.hpp"
 #include "web/ng/impl/ServerSslContext.hpp"
@@ -87,6 +88,7 @@ class Detector : public std::enable_shared_from_this<Detector<PlainSessionType,
     boost::beast::flat_buffer buffer_;
     std::shared_ptr<AdminVerificationStrategy> const adminVerification_;
     std::uint32_t maxWsSendingQueueSize_;
+    WsCompressionOptions wsCompression_;
 
 public:
     /**
@@ -99,6 +101,7 @@ public:
      * @param handler The server handler to use
      * @param adminVerification The admin verification strategy to use
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param wsCompression The permessage-deflate settings for websocket
      */
     Detector(
         tcp::socket&& socket,
@@ -107,7 +110,8 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> handler,
         std::shared_ptr<AdminVerificationStrategy> adminVerification,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        WsCompressionOptions wsCompression
     )
         : stream_(std::move(socket))
         , ctx_(ctx)
@@ -116,6 +120,7 @@ public:
         , handler_(std::move(handler))
         , adminVerification_(std::move(adminVerification))
         , maxWsSendingQueueSize_(maxWsSendingQueueSize)
+        , wsCompression_(wsCompression)
     {
     }
 
@@ -174,7 +179,8 @@ public:
                 dosGuard_,
                 handler_,
                 std::move(buffer_),
-                maxWsSendingQueueSize_
+                maxWsSendingQueueSize_,
+                wsCompression_
             )
                 ->run();
             return;
@@ -188,7 +194,8 @@ public:
             dosGuard_,
             handler_,
             std::move(buffer_),
-            maxWsSendingQueueSize_
+            maxWsSendingQueueSize_,
+            wsCompression_
         )
             ->run();
     }
@@ -219,6 +226,7 @@ class Server : public std::enable_shared_from_this<Server<PlainSessionType, SslS
     tcp::acceptor acceptor_;
     std::shared_ptr<AdminVerificationStrategy> adminVerification_;
     std::uint32_t maxWsSendingQueueSize_;
+    WsCompressionOptions wsCompression_;
 
 public:
     /**
@@ -232,6 +240,7 @@ public:
      * @param handler The server handler to use
      * @param adminVerification The admin verification strategy to use
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param wsCompression The permessage-deflate settings for websocket
      */
     Server(
         boost::asio::io_context& ioc,
@@ -241,7 +250,8 @@ public:
         dosguard::DOSGuardInterface& dosGuard,
         std::shared_ptr<HandlerType> handler,
         std::shared_ptr<AdminVerificationStrategy> adminVerification,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        WsCompressionOptions wsCompression
     )
         : ioc_(std::ref(ioc))
         , ctx_(std::move(ctx))
@@ -251,6 +261,7 @@ public:
         , acceptor_(boost::asio::make_strand(ioc))
         , adminVerification_(std::move(adminVerification))
         , maxWsSendingQueueSize_(maxWsSendingQueueSize)
+        , wsCompression_(wsCompression)
     {
         boost::beast::error_code ec;
 
@@ -310,7 +321,8 @@ private:
                 dosGuard_,
                 handler_,
                 adminVerification_,
-                maxWsSendingQueueSize_
+                maxWsSendingQueueSize_,
+                wsCompression_
             )
                 ->run();
         }
@@ -363,6 +375,7 @@ makeHttpServer(
     // If the transactions number is 200 per ledger, A client which subscribes everything will send 400+ feeds for
     // each ledger. we allow user delay 3 ledgers by default
     auto const maxWsSendingQueueSize = serverConfig.get<uint32_t>("ws_max_sending_queue_size");
+    auto const wsCompression = WsCompressionOptions::fromConfig(config);
 
     auto server = std::make_shared<HttpServer<HandlerType>>(
         ioc,
@@ -372,7 +385,8 @@ makeHttpServer(
         dosGuard,
         handler,
         std::move(expectedAdminVerification).value(),
-        maxWsSendingQueueSize
+        maxWsSendingQueueSize,
+        wsCompression
     );
 
     server->run();
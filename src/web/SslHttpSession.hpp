@@ -22,6 +22,7 @@
 #include "util/Taggable.hpp"
 #include "web/AdminVerificationStrategy.hpp"
 #include "web/SslWsSession.hpp"
+#include "web/WsCompression.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/HttpBase.hpp"
 #include "web/interface/Concepts.hpp"
@@ -62,6 +63,7 @@ class SslHttpSession : public impl::HttpBase<SslHttpSession, HandlerType>,
     boost::beast::ssl_stream<boost::beast::tcp_stream> stream_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
     std::uint32_t maxWsSendingQueueSize_;
+    WsCompressionOptions wsCompression_;
 
 public:
     /**
@@ -76,6 +78,7 @@ public:
      * @param handler The server handler to use
      * @param buffer Buffer with initial data received from the peer
      * @param maxWsSendingQueueSize The maximum size of the sending queue for websocket
+     * @param wsCompression The permessage-deflate settings for websocket
      */
     explicit SslHttpSession(
         tcp::socket&& socket,
@@ -86,7 +89,8 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer buffer,
-        std::uint32_t maxWsSendingQueueSize
+        std::uint32_t maxWsSendingQueueSize,
+        WsCompressionOptions wsCompression
     )
         : impl::HttpBase<SslHttpSession, HandlerType>(
               ip,
@@ -99,6 +103,7 @@ public:
         , stream_(std::move(socket), ctx)
         , tagFactory_(tagFactory)
         , maxWsSendingQueueSize_(maxWsSendingQueueSize)
+        , wsCompression_(wsCompression)
     {
     }
 
@@ -180,7 +185,8 @@ public:
             std::move(this->buffer_),
             std::move(this->req_),
             ConnectionBase::isAdmin(),
-            maxWsSendingQueueSize_
+            maxWsSendingQueueSize_,
+            wsCompression_
         )
             ->run();
     }
@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/WsCompression.hpp"
+
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/beast/core/string_type.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/rfc6455.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace web {
+
+WsCompressionOptions
+WsCompressionOptions::fromConfig(util::config::ClioConfigDefinition const& config)
+{
+    auto const compressionConfig = config.getObject("server.ws_compression");
+    return WsCompressionOptions{
+        .enabled = compressionConfig.get<bool>("enabled"),
+        .serverNoContextTakeover = compressionConfig.get<bool>("server_no_context_takeover"),
+        .clientNoContextTakeover = compressionConfig.get<bool>("client_no_context_takeover"),
+        .serverMaxWindowBits = compressionConfig.get<int>("server_max_window_bits"),
+        .clientMaxWindowBits = compressionConfig.get<int>("client_max_window_bits"),
+        .compressionLevel = compressionConfig.get<int>("level"),
+        .memoryLevel = compressionConfig.get<int>("memory_level"),
+        .minMessageSize = compressionConfig.get<uint32_t>("min_message_size")
+    };
+}
+
+boost::beast::websocket::permessage_deflate
+WsCompressionOptions::toStreamOption() const
+{
+    boost::beast::websocket::permessage_deflate option;
+    option.server_enable = enabled;
+    option.server_no_context_takeover = serverNoContextTakeover;
+    option.client_no_context_takeover = clientNoContextTakeover;
+    option.server_max_window_bits = serverMaxWindowBits;
+    option.client_max_window_bits = clientMaxWindowBits;
+    option.compLevel = compressionLevel;
+    option.memLevel = memoryLevel;
+    return option;
+}
+
+WsCompression::WsCompression(WsCompressionOptions options)
+    : options_(options)
+    , compressedBytes_(PrometheusService::counterInt(
+          "ws_sent_message_bytes_total_number",
+          util::prometheus::Labels{{{"compression", "deflate"}}},
+          "Size of the messages sent to websocket clients before compression, by whether they were compressed"
+      ))
+    , uncompressedBytes_(PrometheusService::counterInt(
+          "ws_sent_message_bytes_total_number",
+          util::prometheus::Labels{{{"compression", "none"}}}
+      ))
+{
+}
+
+void
+WsCompression::onHandshake(boost::beast::websocket::response_type const& response)
+{
+    auto const extensions = response.find(boost::beast::http::field::sec_websocket_extensions);
+    negotiated_ = extensions != response.end() &&
+        extensions->value().find("permessage-deflate") != boost::beast::string_view::npos;
+}
+
+bool
+WsCompression::shouldCompress(std::size_t messageSize)
+{
+    auto const compress = negotiated_ && messageSize >= options_.minMessageSize;
+    onContinuation(messageSize, compress);
+    return compress;
+}
+
+void
+WsCompression::onContinuation(std::size_t fragmentSize, bool compressed)
+{
+    if (compressed) {
+        compressedBytes_.get() += fragmentSize;
+    } else {
+        uncompressedBytes_.get() += fragmentSize;
+    }
+}
+
+}  // namespace web
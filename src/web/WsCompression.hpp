@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "web/WsCompressionDefaults.hpp"
+
+#include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/rfc6455.hpp>
+#include <boost/beast/websocket/stream.hpp>
+
+#include <cstddef>
+#include <functional>
+
+namespace web {
+
+/**
+ * @brief Settings of the permessage-deflate websocket extension (RFC 7692) offered to the clients.
+ */
+struct WsCompressionOptions {
+    bool enabled = false;
+    bool serverNoContextTakeover = false;
+    bool clientNoContextTakeover = false;
+    int serverMaxWindowBits = kWS_COMPRESSION_DEFAULT_MAX_WINDOW_BITS;
+    int clientMaxWindowBits = kWS_COMPRESSION_DEFAULT_MAX_WINDOW_BITS;
+    int compressionLevel = kWS_COMPRESSION_DEFAULT_LEVEL;
+    int memoryLevel = kWS_COMPRESSION_DEFAULT_MEMORY_LEVEL;
+    std::size_t minMessageSize = kWS_COMPRESSION_DEFAULT_MIN_MESSAGE_SIZE;
+
+    /**
+     * @brief Read the options from the `server.ws_compression` section of the config.
+     *
+     * @param config The config to read from
+     * @return The options
+     */
+    static WsCompressionOptions
+    fromConfig(util::config::ClioConfigDefinition const& config);
+
+    /** @return The options in the form accepted by the websocket stream */
+    boost::beast::websocket::permessage_deflate
+    toStreamOption() const;
+};
+
+/**
+ * @brief Permessage-deflate state of a single websocket connection.
+ *
+ * Remembers whether the extension was negotiated during the handshake and decides for every outgoing message whether it
+ * is compressed: messages shorter than the configured minimum size are sent as is, since deflate framing costs more
+ * than it saves on them. Sizes of outgoing messages are reported to prometheus split by whether they were compressed.
+ */
+class WsCompression {
+    WsCompressionOptions options_;
+    bool negotiated_ = false;
+
+    std::reference_wrapper<util::prometheus::CounterInt> compressedBytes_;
+    std::reference_wrapper<util::prometheus::CounterInt> uncompressedBytes_;
+
+public:
+    /**
+     * @brief Construct the state of a new connection.
+     *
+     * @param options The compression options of the server
+     */
+    explicit WsCompression(WsCompressionOptions options);
+
+    /**
+     * @brief Offer the extension on a stream that is about to accept the handshake.
+     * @note The stream keeps a pointer to this object so it must outlive the handshake.
+     *
+     * @param ws The websocket stream
+     */
+    template <typename StreamType>
+    void
+    setupStream(boost::beast::websocket::stream<StreamType>& ws)
+    {
+        ws.set_option(options_.toStreamOption());
+    }
+
+    /**
+     * @brief Record the result of the negotiation from the handshake response sent to the client.
+     *
+     * @param response The handshake response, including the extensions agreed on
+     */
+    void
+    onHandshake(boost::beast::websocket::response_type const& response);
+
+    /** @return true if the client accepted permessage-deflate; false otherwise */
+    bool
+    negotiated() const
+    {
+        return negotiated_;
+    }
+
+    /**
+     * @brief Decide whether the next message is compressed and account its size.
+     *
+     * @param messageSize The size of the message in bytes
+     * @return true if the message should be compressed; false otherwise
+     */
+    bool
+    shouldCompress(std::size_t messageSize);
+
+    /**
+     * @brief Account the size of a continuation frame of a message sent in fragments.
+     *
+     * @param fragmentSize The size of the fragment in bytes
+     * @param compressed Whether the message is compressed, as decided by shouldCompress() for its first fragment
+     */
+    void
+    onContinuation(std::size_t fragmentSize, bool compressed);
+};
+
+}  // namespace web
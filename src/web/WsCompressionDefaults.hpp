@@ -0,0 +1,39 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <cstddef>
+
+namespace web {
+
+/**
+ * @brief Default settings of the permessage-deflate websocket extension.
+ *
+ * Shared by WsCompressionOptions and the `server.ws_compression` section of the config, so options built in code
+ * behave the same as options read from a config that doesn't set them.
+ */
+static constexpr int kWS_COMPRESSION_DEFAULT_MAX_WINDOW_BITS = 15;
+static constexpr int kWS_COMPRESSION_DEFAULT_LEVEL = 8;
+static constexpr int kWS_COMPRESSION_DEFAULT_MEMORY_LEVEL = 4;
+
+/** @brief Messages shorter than this are not compressed by default since deflate framing costs more than it saves */
+static constexpr std::size_t kWS_COMPRESSION_DEFAULT_MIN_MESSAGE_SIZE = 256;
+
+}  // namespace web
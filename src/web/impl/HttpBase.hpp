@@ -28,6 +28,8 @@
 #include "web/AdminVerificationStrategy.hpp"
 #include "web/SubscriptionContextInterface.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
+#include "web/impl/JsonStream.hpp"
+#include "web/impl/WarningsTail.hpp"
 #include "web/interface/Concepts.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
@@ -38,16 +40,17 @@
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/http.hpp>
+#include <boost/beast/http/buffer_body.hpp>
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/message.hpp>
+#include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <boost/json.hpp>
-#include <boost/json/array.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <xrpl/protocol/ErrorCodes.h>
@@ -57,7 +60,9 @@
 #include <exception>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace web::impl {
@@ -117,6 +122,18 @@ class HttpBase : public ConnectionBase {
         }
     };
 
+    // A JSON response written with chunked transfer encoding while it is being serialized
+    struct ChunkedResponse {
+        std::shared_ptr<JsonStream> json;
+        http::response<http::buffer_body> response;
+        http::response_serializer<http::buffer_body> serializer;
+
+        ChunkedResponse(std::shared_ptr<JsonStream> json, http::status status, unsigned version)
+            : json(std::move(json)), response(status, version), serializer(response)
+        {
+        }
+    };
+
     std::shared_ptr<void> res_;
     SendLambda sender_;
     std::shared_ptr<AdminVerificationStrategy> adminVerification_;
@@ -275,12 +292,7 @@ public:
     {
         if (!dosGuard_.get().add(clientIp, msg.size())) {
             auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::WarnRpcRateLimit));
-            } else {
-                jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::WarnRpcRateLimit)};
-            }
+            addLoadWarning(jsonResponse, rpc::makeWarning(rpc::WarnRpcRateLimit));
 
             // Reserialize when we need to include this warning
             msg = boost::json::serialize(jsonResponse);
@@ -288,6 +300,36 @@ public:
         sender_(httpResponse(status, "application/json", std::move(msg)));
     }
 
+    /**
+     * @brief Send a JSON response to the client.
+     *
+     * Responses larger than one chunk are written with chunked transfer encoding while they are serialized, so the
+     * whole serialized response is never held in memory. If the DOSGuard limit is reached, the warning is added to the
+     * end of the response.
+     *
+     * @param msg The response to send
+     * @param status The HTTP status code; defaults to OK
+     */
+    void
+    send(boost::json::object&& msg, http::status status = http::status::ok) override
+    {
+        auto json = std::make_shared<JsonStream>(std::move(msg), [this](std::size_t size) {
+            return loadWarning(size);
+        });
+        auto const chunk = json->read();
+
+        // HTTP/1.0 clients don't support chunked transfer encoding
+        if (json->serialized() or req_.version() < 11) {
+            std::string message{chunk};
+            for (auto next = json->read(); not next.empty(); next = json->read())
+                message += next;
+
+            return sender_(httpResponse(status, "application/json", std::move(message)));
+        }
+
+        sendChunked(status, std::move(json), chunk);
+    }
+
     SubscriptionContextPtr
     makeSubscriptionContext(util::TagDecoratorFactory const&) override
     {
@@ -313,6 +355,68 @@ public:
     }
 
 private:
+    std::optional<boost::json::object>
+    loadWarning(std::size_t responseSize)
+    {
+        if (dosGuard_.get().add(clientIp, responseSize))
+            return std::nullopt;
+
+        return rpc::makeWarning(rpc::WarnRpcRateLimit);
+    }
+
+    void
+    sendChunked(http::status status, std::shared_ptr<JsonStream> json, std::string_view firstChunk)
+    {
+        if (dead())
+            return;
+
+        auto chunked = std::make_shared<ChunkedResponse>(std::move(json), status, req_.version());
+        auto& response = chunked->response;
+        response.set(http::field::server, "clio-server-" + util::build::getClioVersionString());
+        response.set(http::field::content_type, "application/json");
+        response.keep_alive(req_.keep_alive());
+        response.chunked(true);
+        setChunk(response.body(), firstChunk);
+
+        res_ = chunked;
+        writeChunk(std::move(chunked));
+    }
+
+    void
+    writeChunk(std::shared_ptr<ChunkedResponse> chunked)
+    {
+        auto& serializer = chunked->serializer;
+        http::async_write(
+            derived().stream(),
+            serializer,
+            boost::beast::bind_front_handler(&HttpBase::onChunkWrite, derived().shared_from_this(), std::move(chunked))
+        );
+    }
+
+    void
+    onChunkWrite(std::shared_ptr<ChunkedResponse> chunked, boost::beast::error_code ec, std::size_t bytesTransferred)
+    {
+        // The serializer asks for the next chunk once the current one is written
+        if (ec == http::error::need_buffer)
+            ec = {};
+
+        if (ec or chunked->serializer.is_done())
+            return onWrite(chunked->response.need_eof(), ec, bytesTransferred);
+
+        setChunk(chunked->response.body(), chunked->json->read());
+        writeChunk(std::move(chunked));
+    }
+
+    static void
+    setChunk(http::buffer_body::value_type& body, std::string_view chunk)
+    {
+        // An empty chunk completes the response. The body is only read from, the cast is required by buffer_body.
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        body.data = chunk.empty() ? nullptr : const_cast<char*>(chunk.data());
+        body.size = chunk.size();
+        body.more = not chunk.empty();
+    }
+
     http::response<http::string_body>
     httpResponse(http::status status, std::string contentType, std::string message) const
     {
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/JsonStream.hpp"
+
+#include "web/impl/WarningsTail.hpp"
+
+#include <boost/json/object.hpp>
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+namespace web::impl {
+
+JsonStream::JsonStream(boost::json::object response, LoadWarningHook loadWarningHook, std::size_t chunkSize)
+    : response_(std::move(response))
+    , tail_(WarningsTail::extract(response_))
+    , buffer_(chunkSize)
+    , loadWarningHook_(std::move(loadWarningHook))
+{
+    serializer_.reset(&response_);
+}
+
+std::string_view
+JsonStream::read()
+{
+    if (serializer_.done()) {
+        if (endRead_)
+            return {};
+
+        // the end of the response is returned in chunks of at most the buffer size as well
+        auto const chunk = std::string_view{end_}.substr(endOffset_, buffer_.size());
+        endOffset_ += chunk.size();
+        endRead_ = endOffset_ == end_.size();
+        size_ += chunk.size();
+        return chunk;
+    }
+
+    auto chunk = serializer_.read(buffer_.data(), buffer_.size());
+    if (serializer_.done()) {
+        chunk.remove_suffix(1);  // closing brace, it is written after the warnings
+
+        tail_.appendTo(end_);
+        if (auto const warning = loadWarningHook_(size_ + chunk.size() + end_.size()); warning.has_value()) {
+            tail_.addLoadWarning(*warning);
+            end_.clear();
+            tail_.appendTo(end_);
+        }
+
+        if (chunk.empty())
+            return read();
+    }
+
+    size_ += chunk.size();
+    return chunk;
+}
+
+}  // namespace web::impl
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "web/impl/WarningsTail.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/serializer.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace web::impl {
+
+/**
+ * @brief Serializes a JSON response chunk by chunk so that it can be written while it is being serialized.
+ *
+ * Only one chunk of the serialized response is kept in memory at a time. The warning fields are written last, after
+ * the size of the rest of the response is known, so that a load warning can still be added when the client goes over
+ * its DOSGuard budget.
+ */
+class JsonStream {
+public:
+    static constexpr std::size_t kCHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Called once with the size of the whole response before its warnings are written.
+     *
+     * Returns the warning to add to the response, if any.
+     */
+    using LoadWarningHook = std::function<std::optional<boost::json::object>(std::size_t)>;
+
+private:
+    boost::json::object response_;
+    WarningsTail tail_;
+    boost::json::serializer serializer_;
+    std::vector<char> buffer_;
+    LoadWarningHook loadWarningHook_;
+    std::string end_;
+    std::size_t endOffset_ = 0;
+    std::size_t size_ = 0;
+    bool endRead_ = false;
+
+public:
+    /**
+     * @brief Construct a stream over a response.
+     *
+     * @param response The response to serialize
+     * @param loadWarningHook Decides whether a load warning has to be added once the size of the response is known
+     * @param chunkSize The maximum size of a chunk
+     */
+    JsonStream(boost::json::object response, LoadWarningHook loadWarningHook, std::size_t chunkSize = kCHUNK_SIZE);
+
+    JsonStream(JsonStream const&) = delete;
+    JsonStream(JsonStream&&) = delete;
+    JsonStream&
+    operator=(JsonStream const&) = delete;
+    JsonStream&
+    operator=(JsonStream&&) = delete;
+
+    /**
+     * @brief Serialize the next chunk of the response.
+     *
+     * @return The chunk; valid until the next call. Empty once the whole response was read
+     */
+    std::string_view
+    read();
+
+    /** @return true if the response was serialized up to its warnings, i.e. only its end is left to read */
+    bool
+    serialized() const
+    {
+        return serializer_.done();
+    }
+
+    /** @return true if the whole response was read */
+    bool
+    done() const
+    {
+        return endRead_;
+    }
+
+    /** @return The number of bytes read so far */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+};
+
+}  // namespace web::impl
@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/WarningsTail.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/value.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace web::impl {
+
+namespace {
+
+constexpr std::string_view kWARNING = "warning";
+constexpr std::string_view kWARNINGS = "warnings";
+
+std::optional<boost::json::value>
+extractField(boost::json::object& response, std::string_view key)
+{
+    auto const it = response.find(key);
+    if (it == response.end())
+        return std::nullopt;
+
+    auto value = std::move(it->value());
+    response.erase(it);
+    return value;
+}
+
+}  // namespace
+
+std::pair<std::string, WarningsTail>
+WarningsTail::serialize(boost::json::object response)
+{
+    auto tail = extract(response);
+
+    auto message = boost::json::serialize(response);
+    message.pop_back();  // closing brace, the tail is appended after the remaining fields
+
+    tail.offset_ = message.size();
+    tail.appendTo(message);
+
+    return {std::move(message), std::move(tail)};
+}
+
+WarningsTail
+WarningsTail::extract(boost::json::object& response)
+{
+    WarningsTail tail;
+    tail.warning_ = extractField(response, kWARNING);
+    tail.warnings_ = extractField(response, kWARNINGS);
+    tail.needsSeparator_ = not response.empty();
+    return tail;
+}
+
+void
+WarningsTail::addLoadWarning(std::string& message, boost::json::object const& warning)
+{
+    addLoadWarning(warning);
+
+    message.resize(offset_);
+    appendTo(message);
+}
+
+void
+WarningsTail::addLoadWarning(boost::json::object const& warning)
+{
+    warning_ = "load";
+    if (warnings_.has_value() && warnings_->is_array()) {
+        warnings_->as_array().push_back(warning);
+    } else {
+        warnings_ = boost::json::array{warning};
+    }
+}
+
+void
+WarningsTail::appendTo(std::string& message) const
+{
+    auto needsSeparator = needsSeparator_;
+    auto const appendField = [&](std::string_view key, std::optional<boost::json::value> const& value) {
+        if (not value.has_value())
+            return;
+
+        if (needsSeparator)
+            message += ',';
+        needsSeparator = true;
+
+        message += '"';
+        message += key;
+        message += "\":";
+        message += boost::json::serialize(*value);
+    };
+
+    appendField(kWARNING, warning_);
+    appendField(kWARNINGS, warnings_);
+    message += '}';
+}
+
+void
+addLoadWarning(boost::json::object& response, boost::json::object const& warning)
+{
+    response[kWARNING] = "load";
+    if (response.contains(kWARNINGS) && response[kWARNINGS].is_array()) {
+        response[kWARNINGS].as_array().push_back(warning);
+    } else {
+        response[kWARNINGS] = boost::json::array{warning};
+    }
+}
+
+}  // namespace web::impl
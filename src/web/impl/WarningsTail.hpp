@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json/object.hpp>
+#include <boost/json/value.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace web::impl {
+
+/**
+ * @brief The `warning` and `warnings` fields of a serialized JSON response, kept at its end.
+ *
+ * A response is serialized once with these fields moved after all the other fields. The tail of the message can then be
+ * rewritten to add a warning once the size of the response is known (e.g. when the client goes over its DOSGuard
+ * budget) without parsing and serializing the whole response again.
+ */
+class WarningsTail {
+    std::size_t offset_ = 0;
+    bool needsSeparator_ = false;
+    std::optional<boost::json::value> warning_;
+    std::optional<boost::json::value> warnings_;
+
+public:
+    /**
+     * @brief Serialize a response with its warning fields at the end.
+     *
+     * @param response The response to serialize
+     * @return The serialized response and its tail
+     */
+    static std::pair<std::string, WarningsTail>
+    serialize(boost::json::object response);
+
+    /**
+     * @brief Move the warning fields out of a response that is going to be serialized separately.
+     *
+     * @param response The response; the warning fields are removed from it
+     * @return The tail to append after the rest of the response without its closing brace
+     */
+    static WarningsTail
+    extract(boost::json::object& response);
+
+    /**
+     * @brief Mark the response as sent under load: set `warning` to "load" and append a warning to `warnings`.
+     *
+     * @param message The message returned by serialize(); only its tail is rewritten
+     * @param warning The warning to append
+     */
+    void
+    addLoadWarning(std::string& message, boost::json::object const& warning);
+
+    /**
+     * @brief Mark the response as sent under load without rewriting any message.
+     *
+     * @param warning The warning to append
+     */
+    void
+    addLoadWarning(boost::json::object const& warning);
+
+    /**
+     * @brief Append the warning fields and the closing brace of the response.
+     *
+     * @param message The serialized response without its closing brace
+     */
+    void
+    appendTo(std::string& message) const;
+
+private:
+    WarningsTail() = default;
+};
+
+/**
+ * @brief Mark a response as sent under load: set `warning` to "load" and append a warning to `warnings`.
+ *
+ * @param response The response to modify
+ * @param warning The warning to append
+ */
+void
+addLoadWarning(boost::json::object& response, boost::json::object const& warning);
+
+}  // namespace web::impl
@@ -21,11 +21,19 @@
 
 #include "rpc/Errors.hpp"
 #include "rpc/common/Types.hpp"
+#include "util/Mutex.hpp"
 #include "util/Taggable.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 #include "web/SubscriptionContext.hpp"
 #include "web/SubscriptionContextInterface.hpp"
+#include "web/WsCompression.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
+#include "web/impl/JsonStream.hpp"
+#include "web/impl/WarningsTail.hpp"
 #include "web/interface/Concepts.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
@@ -44,19 +52,23 @@
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
 #include <boost/core/ignore_unused.hpp>
-#include <boost/json/array.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <xrpl/protocol/ErrorCodes.h>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <exception>
 #include <functional>
 #include <memory>
-#include <queue>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 namespace web::impl {
 
@@ -68,6 +80,18 @@ namespace web::impl {
  * The write operation also supports shared_ptr of string, so the caller can keep the string alive until it is sent.
  * It is useful when we have multiple sessions sending the same content.
  *
+ * Messages sent from other threads are collected in a pending batch and moved to the queue by a single handler on the
+ * executor of the stream, so a burst of messages (e.g. at ledger close) costs one dispatch instead of one per message.
+ * A client whose queue grows past half of the maximum size is reported as falling behind, with the number of messages
+ * and bytes it is behind and for how long; it is disconnected once the queue is full. The number of clients falling
+ * behind and of slow clients disconnected are reported to prometheus.
+ *
+ * If permessage-deflate is enabled and the client accepts it, messages above the configured minimum size are
+ * compressed.
+ *
+ * JSON responses larger than one chunk are sent as a fragmented message, serializing the next chunk once the previous
+ * fragment is written, so the whole serialized response is never held in memory.
+ *
  * @tparam Derived The derived class
  * @tparam HandlerType The handler type, will be called when a request is received.
  */
@@ -75,15 +99,52 @@ template <template <typename> typename Derived, SomeServerHandler HandlerType>
 class WsBase : public ConnectionBase, public std::enable_shared_from_this<WsBase<Derived, HandlerType>> {
     using std::enable_shared_from_this<WsBase<Derived, HandlerType>>::shared_from_this;
 
+    using ClockType = std::chrono::steady_clock;
+
+    struct QueuedMessage {
+        std::shared_ptr<std::string> message;
+        std::shared_ptr<JsonStream> stream;  // set instead of message for a response sent while being serialized
+        std::string_view chunk;              // the fragment of the stream to write next
+        bool started = false;
+        bool compressed = false;
+        std::size_t size = 0;
+        ClockType::time_point queuedAt;
+    };
+
+    struct PendingMessages {
+        std::vector<QueuedMessage> messages;
+        bool flushScheduled = false;
+    };
+
     boost::beast::flat_buffer buffer_;
     std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard_;
+
+    // written from any thread; drained on the executor of the stream
+    util::Mutex<PendingMessages> pending_;
+
+    // only accessed on the executor of the stream
     bool sending_ = false;
-    std::queue<std::shared_ptr<std::string>> messages_;
+    std::deque<QueuedMessage> messages_;
+    std::size_t queuedBytes_ = 0;
+    bool fallingBehind_ = false;
+    WsCompression compression_;
+
     std::shared_ptr<HandlerType> const handler_;
 
     SubscriptionContextPtr subscriptionContext_;
     std::uint32_t maxSendingQueueSize_;
 
+    std::reference_wrapper<util::prometheus::GaugeInt> fallingBehindConnections_ = PrometheusService::gaugeInt(
+        "ws_falling_behind_connections_total_number",
+        util::prometheus::Labels{},
+        "Number of websocket connections with more than half of the sending queue filled"
+    );
+    std::reference_wrapper<util::prometheus::CounterInt> slowClientDisconnects_ = PrometheusService::counterInt(
+        "ws_slow_client_disconnects_total_number",
+        util::prometheus::Labels{},
+        "Number of websocket connections closed because their sending queue was full"
+    );
+
 protected:
     util::Logger log_{"WebServer"};
     util::Logger perfLog_{"Performance"};
@@ -108,11 +169,13 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer&& buffer,
-        std::uint32_t maxSendingQueueSize
+        std::uint32_t maxSendingQueueSize,
+        WsCompressionOptions compression
     )
         : ConnectionBase(tagFactory, ip)
         , buffer_(std::move(buffer))
         , dosGuard_(dosGuard)
+        , compression_(compression)
         , handler_(handler)
         , maxSendingQueueSize_(maxSendingQueueSize)
     {
@@ -125,6 +188,9 @@ public:
     {
         LOG(perfLog_.debug()) << tag() << "session closed";
         dosGuard_.get().decrement(clientIp);
+
+        if (fallingBehind_)
+            --fallingBehindConnections_.get();
     }
 
     Derived<HandlerType>&
@@ -137,24 +203,127 @@ public:
     doWrite()
     {
         sending_ = true;
+        auto const& front = messages_.front();
+        if (front.stream != nullptr)
+            return doWriteFragment();
+
+        derived().ws().compress(compression_.shouldCompress(front.message->size()));
         derived().ws().async_write(
-            boost::asio::buffer(messages_.front()->data(), messages_.front()->size()),
+            boost::asio::buffer(front.message->data(), front.message->size()),
             boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this())
         );
     }
 
+    void
+    doWriteFragment()
+    {
+        auto& front = messages_.front();
+        if (not std::exchange(front.started, true)) {
+            front.compressed = compression_.shouldCompress(front.chunk.size());
+            derived().ws().compress(front.compressed);
+        } else {
+            compression_.onContinuation(front.chunk.size(), front.compressed);
+        }
+
+        derived().ws().async_write_some(
+            front.stream->done(),
+            boost::asio::buffer(front.chunk.data(), front.chunk.size()),
+            boost::beast::bind_front_handler(&WsBase::onWriteFragment, derived().shared_from_this())
+        );
+    }
+
+    void
+    onWriteFragment(boost::system::error_code ec, std::size_t bytesTransferred)
+    {
+        auto& front = messages_.front();
+        if (ec or front.stream->done())
+            return onWrite(ec, bytesTransferred);
+
+        front.chunk = front.stream->read();
+        doWriteFragment();
+    }
+
     void
     onWrite(boost::system::error_code ec, std::size_t)
     {
-        messages_.pop();
+        queuedBytes_ -= messages_.front().size;
+        messages_.pop_front();
         sending_ = false;
         if (ec) {
             wsFail(ec, "Failed to write");
         } else {
+            if (fallingBehind_ && messages_.size() <= maxSendingQueueSize_ / 4) {
+                fallingBehind_ = false;
+                --fallingBehindConnections_.get();
+                LOG(log_.info()) << tag() << "Client caught up, " << messages_.size() << " messages queued";
+            }
             maybeSendNext();
         }
     }
 
+    void
+    flushPending()
+    {
+        std::vector<QueuedMessage> batch;
+        {
+            auto pending = pending_.template lock<std::scoped_lock>();
+            batch.swap(pending->messages);
+            pending->flushScheduled = false;
+        }
+
+        // the connection is closed; nothing will be sent anymore
+        if (ec_)
+            return;
+
+        for (auto& queued : batch) {
+            if (messages_.size() > maxSendingQueueSize_) {
+                LOG(log_.warn()) << tag() << "Disconnecting slow client: " << lagDescription();
+                ++slowClientDisconnects_.get();
+                wsFail(boost::asio::error::timed_out, "Client is too slow");
+                return;
+            }
+
+            queuedBytes_ += queued.size;
+            messages_.push_back(std::move(queued));
+        }
+
+        if (!fallingBehind_ && messages_.size() > maxSendingQueueSize_ / 2) {
+            fallingBehind_ = true;
+            ++fallingBehindConnections_.get();
+            LOG(log_.warn()) << tag() << "Client is falling behind: " << lagDescription();
+        }
+
+        maybeSendNext();
+    }
+
+    void
+    scheduleFlush()
+    {
+        boost::asio::dispatch(derived().ws().get_executor(), [this, self = derived().shared_from_this()]() {
+            flushPending();
+        });
+    }
+
+    std::optional<boost::json::object>
+    loadWarning(std::size_t responseSize)
+    {
+        if (dosGuard_.get().add(clientIp, responseSize))
+            return std::nullopt;
+
+        return rpc::makeWarning(rpc::WarnRpcRateLimit);
+    }
+
+    std::string
+    lagDescription() const
+    {
+        auto const oldest = messages_.empty()
+            ? std::chrono::milliseconds{0}
+            : std::chrono::duration_cast<std::chrono::milliseconds>(ClockType::now() - messages_.front().queuedAt);
+
+        return std::to_string(messages_.size()) + " messages (" + std::to_string(queuedBytes_) +
+            " bytes) waiting to be sent, oldest queued " + std::to_string(oldest.count()) + " ms ago";
+    }
+
     void
     maybeSendNext()
     {
@@ -173,18 +342,15 @@ public:
     void
     send(std::shared_ptr<std::string> msg) override
     {
-        boost::asio::dispatch(
-            derived().ws().get_executor(),
-            [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
-                if (messages_.size() > maxSendingQueueSize_) {
-                    wsFail(boost::asio::error::timed_out, "Client is too slow");
-                    return;
-                }
-
-                messages_.push(msg);
-                maybeSendNext();
-            }
-        );
+        auto const needsFlush = [&] {
+            auto pending = pending_.template lock<std::scoped_lock>();
+            auto const size = msg->size();
+            pending->messages.push_back({.message = std::move(msg), .size = size, .queuedAt = ClockType::now()});
+            return not std::exchange(pending->flushScheduled, true);
+        }();
+
+        if (needsFlush)
+            scheduleFlush();
     }
 
     /**
@@ -213,13 +379,7 @@ public:
     {
         if (!dosGuard_.get().add(clientIp, msg.size())) {
             auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::WarnRpcRateLimit));
-            } else {
-                jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::WarnRpcRateLimit)};
-            }
+            addLoadWarning(jsonResponse, rpc::makeWarning(rpc::WarnRpcRateLimit));
 
             // Reserialize when we need to include this warning
             msg = boost::json::serialize(jsonResponse);
@@ -228,6 +388,40 @@ public:
         send(std::move(sharedMsg));
     }
 
+    /**
+     * @brief Send a JSON response to the client
+     * @param msg The response to send
+     * A response larger than one chunk is sent in fragments while it is being serialized. The message length is added
+     * to the DOSGuard once known; if the DOSGuard is triggered, the warning is added to the end of the response.
+     */
+    void
+    send(boost::json::object&& msg, http::status) override
+    {
+        auto stream = std::make_shared<JsonStream>(std::move(msg), [this](std::size_t size) {
+            return loadWarning(size);
+        });
+        auto const chunk = stream->read();
+
+        if (stream->serialized()) {
+            auto message = std::make_shared<std::string>(chunk);
+            for (auto next = stream->read(); not next.empty(); next = stream->read())
+                *message += next;
+
+            return send(std::move(message));
+        }
+
+        auto const needsFlush = [&] {
+            auto pending = pending_.template lock<std::scoped_lock>();
+            pending->messages.push_back(
+                {.stream = std::move(stream), .chunk = chunk, .size = chunk.size(), .queuedAt = ClockType::now()}
+            );
+            return not std::exchange(pending->flushScheduled, true);
+        }();
+
+        if (needsFlush)
+            scheduleFlush();
+    }
+
     /**
      * @brief Accept the session asynchroniously
      */
@@ -237,10 +431,12 @@ public:
         using namespace boost::beast;
 
         derived().ws().set_option(websocket::stream_base::timeout::suggested(role_type::server));
+        compression_.setupStream(derived().ws());
 
-        // Set a decorator to change the Server of the handshake
-        derived().ws().set_option(websocket::stream_base::decorator([](websocket::response_type& res) {
+        // Set a decorator to change the Server of the handshake and to see whether compression was negotiated
+        derived().ws().set_option(websocket::stream_base::decorator([this](websocket::response_type& res) {
             res.set(http::field::server, std::string(BOOST_BEAST_VERSION_STRING) + " websocket-server-async");
+            compression_.onHandshake(res);
         }));
 
         derived().ws().async_accept(req, bind_front_handler(&WsBase::onAccept, this->shared_from_this()));
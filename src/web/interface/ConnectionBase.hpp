@@ -24,6 +24,8 @@
 
 #include <boost/beast/http.hpp>
 #include <boost/beast/http/status.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
 #include <boost/signals2.hpp>
 #include <boost/signals2/variadic_signal.hpp>
 
@@ -70,6 +72,20 @@ public:
     virtual void
     send(std::string&& msg, http::status status = http::status::ok) = 0;
 
+    /**
+     * @brief Send a JSON response to the client.
+     *
+     * Connections that add warnings to the response override this to do so without parsing the serialized response.
+     *
+     * @param msg The message to send
+     * @param status The HTTP status code; defaults to OK
+     */
+    virtual void
+    send(boost::json::object&& msg, http::status status = http::status::ok)
+    {
+        send(boost::json::serialize(msg), status);
+    }
+
     /**
      * @brief Send via shared_ptr of string, that enables SubscriptionManager to publish to clients.
      *
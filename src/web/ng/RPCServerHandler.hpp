@@ -45,6 +45,7 @@
 #include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
+#include <boost/system/error_code.hpp>
 #include <boost/system/system_error.hpp>
 #include <xrpl/protocol/jss.h>
 
@@ -121,15 +122,26 @@ public:
         auto const onTaskComplete = coroutineGroup.registerForeign();
         ASSERT(onTaskComplete.has_value(), "Coroutine group can't be full");
 
+        // The method of the request is needed to schedule it. Malformed requests are reported from the work queue.
+        std::optional<boost::json::object> preParsedRequest;
+        boost::system::error_code ec;
+        if (auto value = boost::json::parse(request.message(), ec); not ec and value.is_object())
+            preParsedRequest = std::move(value).as_object();
+
+        auto const method = preParsedRequest.has_value() ? rpc::getRequestMethod(*preParsedRequest) : std::string{};
+
         bool const postSuccessful = rpcEngine_->post(
             [this,
              &request,
              &response,
              &onTaskComplete = onTaskComplete.value(),
              &connectionMetadata,
+             preParsedRequest = std::move(preParsedRequest),
              subscriptionContext = std::move(subscriptionContext)](boost::asio::yield_context yield) mutable {
                 try {
-                    auto parsedRequest = boost::json::parse(request.message()).as_object();
+                    auto parsedRequest = preParsedRequest.has_value()
+                        ? std::move(preParsedRequest).value()
+                        : boost::json::parse(request.message()).as_object();
                     LOG(perfLog_.debug()) << connectionMetadata.tag() << "Adding to work queue";
 
                     if (not connectionMetadata.wasUpgraded() and shouldReplaceParams(parsedRequest))
@@ -158,7 +170,8 @@ public:
                 // notify the coroutine group that the foreign task is done
                 onTaskComplete();
             },
-            connectionMetadata.ip()
+            connectionMetadata.ip(),
+            method
         );
 
         if (not postSuccessful) {
@@ -298,7 +311,7 @@ private:
                 warnings.emplace_back(rpc::makeWarning(rpc::WarnRpcOutdated));
 
             response["warnings"] = warnings;
-            return Response{boost::beast::http::status::ok, response, rawRequest};
+            return Response{boost::beast::http::status::ok, std::move(response), rawRequest};
         } catch (std::exception const& ex) {
             // note: while we are catching this in buildResponse too, this is here to make sure
             // that any other code that may throw is outside of buildResponse is also worked around.
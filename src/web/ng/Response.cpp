@@ -22,6 +22,7 @@
 #include "util/Assert.hpp"
 #include "util/OverloadSet.hpp"
 #include "util/build/Build.hpp"
+#include "web/impl/WarningsTail.hpp"
 #include "web/ng/Connection.hpp"
 #include "web/ng/Request.hpp"
 
@@ -31,7 +32,7 @@
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/json/object.hpp>
-#include <boost/json/serialize.hpp>
+#include <boost/json/parse.hpp>
 #include <fmt/core.h>
 
 #include <cstdint>
@@ -55,13 +56,16 @@ struct MessageData {
             body = std::move(message);
             contentType = "text/html";
         } else {
-            body = boost::json::serialize(message);
+            auto [serialized, tail] = web::impl::WarningsTail::serialize(std::move(message));
+            body = std::move(serialized);
             contentType = "application/json";
+            warningsTail = std::move(tail);
         }
     }
 
     std::string body;
     std::string contentType;
+    std::optional<web::impl::WarningsTail> warningsTail;
 };
 
 http::response<http::string_body>
@@ -81,12 +85,9 @@ makeHttpData(MessageData messageData, http::status status, uint16_t httpVersion,
     return prepareResponse(std::move(result), keepAlive);
 }
 
-template <typename MessageType>
 std::variant<http::response<http::string_body>, std::string>
-makeData(http::status status, MessageType message, Request const& request)
+makeData(http::status status, MessageData messageData, Request const& request)
 {
-    MessageData messageData{std::move(message)};
-
     if (not request.isHttp())
         return std::move(messageData).body;
 
@@ -94,12 +95,9 @@ makeData(http::status status, MessageType message, Request const& request)
     return makeHttpData(std::move(messageData), status, httpRequest.version(), httpRequest.keep_alive());
 }
 
-template <typename MessageType>
 std::variant<http::response<http::string_body>, std::string>
-makeData(http::status status, MessageType message, Connection const& connection)
+makeData(http::status status, MessageData messageData, Connection const& connection)
 {
-    MessageData messageData{std::move(message)};
-
     if (connection.wasUpgraded())
         return std::move(messageData).body;
 
@@ -109,29 +107,33 @@ makeData(http::status status, MessageType message, Connection const& connection)
 }  // namespace
 
 Response::Response(boost::beast::http::status status, std::string message, Request const& request)
-    : data{makeData(status, std::move(message), request)}
+    : data_{makeData(status, MessageData{std::move(message)}, request)}
 {
 }
 
-Response::Response(boost::beast::http::status status, boost::json::object const& message, Request const& request)
-    : data{makeData(status, message, request)}
+Response::Response(boost::beast::http::status status, boost::json::object message, Request const& request)
 {
+    MessageData messageData{std::move(message)};
+    warningsTail_ = std::move(messageData.warningsTail);
+    data_ = makeData(status, std::move(messageData), request);
 }
 
-Response::Response(boost::beast::http::status status, boost::json::object const& message, Connection const& connection)
-    : data{makeData(status, message, connection)}
+Response::Response(boost::beast::http::status status, boost::json::object message, Connection const& connection)
 {
+    MessageData messageData{std::move(message)};
+    warningsTail_ = std::move(messageData.warningsTail);
+    data_ = makeData(status, std::move(messageData), connection);
 }
 
 Response::Response(boost::beast::http::status status, std::string message, Connection const& connection)
-    : data{makeData(status, std::move(message), connection)}
+    : data_{makeData(status, MessageData{std::move(message)}, connection)}
 {
 }
 
 Response::Response(boost::beast::http::response<boost::beast::http::string_body> response, Request const& request)
 {
     ASSERT(request.isHttp(), "Request must be HTTP to construct response from HTTP response");
-    data = prepareResponse(std::move(response), request.asHttpRequest()->get().keep_alive());
+    data_ = prepareResponse(std::move(response), request.asHttpRequest()->get().keep_alive());
 }
 
 std::string const&
@@ -144,51 +146,75 @@ Response::message() const
                 return message;  // NOLINT(bugprone-return-const-ref-from-parameter)
             },
         },
-        data
+        data_
     );
 }
 
 void
 Response::setMessage(std::string newMessage)
 {
-    if (std::holds_alternative<std::string>(data)) {
-        std::get<std::string>(data) = std::move(newMessage);
+    warningsTail_.reset();
+    if (std::holds_alternative<std::string>(data_)) {
+        std::get<std::string>(data_) = std::move(newMessage);
         return;
     }
     MessageData messageData{std::move(newMessage)};
-    auto const& oldHttpResponse = std::get<http::response<http::string_body>>(data);
-    data = makeHttpData(
+    auto const& oldHttpResponse = std::get<http::response<http::string_body>>(data_);
+    data_ = makeHttpData(
         std::move(messageData), oldHttpResponse.result(), oldHttpResponse.version(), oldHttpResponse.keep_alive()
     );
 }
 
 void
-Response::setMessage(boost::json::object const& newMessage)
+Response::setMessage(boost::json::object newMessage)
 {
-    MessageData messageData{newMessage};
-    if (std::holds_alternative<std::string>(data)) {
-        std::get<std::string>(data) = std::move(messageData).body;
+    MessageData messageData{std::move(newMessage)};
+    warningsTail_ = std::move(messageData.warningsTail);
+    if (std::holds_alternative<std::string>(data_)) {
+        std::get<std::string>(data_) = std::move(messageData).body;
         return;
     }
-    auto const& oldHttpResponse = std::get<http::response<http::string_body>>(data);
-    data = makeHttpData(
+    auto const& oldHttpResponse = std::get<http::response<http::string_body>>(data_);
+    data_ = makeHttpData(
         std::move(messageData), oldHttpResponse.result(), oldHttpResponse.version(), oldHttpResponse.keep_alive()
     );
 }
 
+void
+Response::addLoadWarning(boost::json::object const& warning)
+{
+    if (not warningsTail_.has_value()) {
+        auto json = boost::json::parse(message()).as_object();
+        web::impl::addLoadWarning(json, warning);
+        setMessage(std::move(json));
+        return;
+    }
+
+    std::visit(
+        util::OverloadSet{
+            [&](http::response<http::string_body>& response) {
+                warningsTail_->addLoadWarning(response.body(), warning);
+                response.prepare_payload();
+            },
+            [&](std::string& message) { warningsTail_->addLoadWarning(message, warning); },
+        },
+        data_
+    );
+}
+
 http::response<http::string_body>
 Response::intoHttpResponse() &&
 {
-    ASSERT(std::holds_alternative<http::response<http::string_body>>(data), "Response must contain HTTP data");
+    ASSERT(std::holds_alternative<http::response<http::string_body>>(data_), "Response must contain HTTP data");
 
-    return std::move(std::get<http::response<http::string_body>>(data));
+    return std::move(std::get<http::response<http::string_body>>(data_));
 }
 
 boost::asio::const_buffer
 Response::asWsResponse() const&
 {
-    ASSERT(std::holds_alternative<std::string>(data), "Response must contain WebSocket data");
-    auto const& message = std::get<std::string>(data);
+    ASSERT(std::holds_alternative<std::string>(data_), "Response must contain WebSocket data");
+    auto const& message = std::get<std::string>(data_);
 
     return boost::asio::buffer(message.data(), message.size());
 }
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "web/impl/WarningsTail.hpp"
 #include "web/ng/Request.hpp"
 
 #include <boost/asio/buffer.hpp>
@@ -27,6 +28,7 @@
 #include <boost/beast/http/string_body.hpp>
 #include <boost/json/object.hpp>
 
+#include <optional>
 #include <string>
 #include <variant>
 
@@ -38,8 +40,11 @@ class Connection;
  * @brief Represents an HTTP or Websocket response.
  */
 class Response {
-public:
-    std::variant<boost::beast::http::response<boost::beast::http::string_body>, std::string> data;
+    std::variant<boost::beast::http::response<boost::beast::http::string_body>, std::string> data_;
+
+    // set when the message is a serialized JSON object, so warnings can be added without parsing it. Only valid as long
+    // as the message is changed through the methods of this class
+    std::optional<web::impl::WarningsTail> warningsTail_;
 
 public:
     /**
@@ -60,7 +65,7 @@ public:
      * @param request The request that triggered this response. Used to determine whether the response should contain
      * HTTP or WebSocket
      */
-    Response(boost::beast::http::status status, boost::json::object const& message, Request const& request);
+    Response(boost::beast::http::status status, boost::json::object message, Request const& request);
 
     /**
      * @brief Construct a Response from string. Content type will be text/html.
@@ -70,7 +75,7 @@ public:
      * @param connection The connection that triggered this response. Used to determine whether the response should
      * contain HTTP or WebSocket data.
      */
-    Response(boost::beast::http::status status, boost::json::object const& message, Connection const& connection);
+    Response(boost::beast::http::status status, boost::json::object message, Connection const& connection);
 
     /**
      * @brief Construct a Response from string. Content type will be text/html.
@@ -112,7 +117,16 @@ public:
      * @param newMessage The new message.
      */
     void
-    setMessage(boost::json::object const& newMessage);
+    setMessage(boost::json::object newMessage);
+
+    /**
+     * @brief Mark the response as sent under load: set `warning` to "load" and append a warning to `warnings`.
+     * @note Responses constructed from a JSON object are not parsed again, only the end of the message is rewritten.
+     *
+     * @param warning The warning to append.
+     */
+    void
+    addLoadWarning(boost::json::object const& warning);
 
     /**
      * @brief Convert the Response to an HTTP response.
@@ -24,6 +24,7 @@
 #include "util/log/Logger.hpp"
 #include "util/newconfig/ConfigDefinition.hpp"
 #include "util/newconfig/ObjectView.hpp"
+#include "web/WsCompression.hpp"
 #include "web/ng/Connection.hpp"
 #include "web/ng/MessageHandler.hpp"
 #include "web/ng/ProcessingPolicy.hpp"
@@ -166,6 +167,7 @@ tryUpgradeConnection(
     impl::UpgradableConnectionPtr connection,
     std::optional<boost::asio::ssl::context>& sslContext,
     util::TagDecoratorFactory& tagDecoratorFactory,
+    WsCompressionOptions const& wsCompression,
     boost::asio::yield_context yield
 )
 {
@@ -177,7 +179,7 @@ tryUpgradeConnection(
     }
 
     if (*expectedIsUpgrade) {
-        auto expectedUpgradedConnection = connection->upgrade(sslContext, tagDecoratorFactory, yield);
+        auto expectedUpgradedConnection = connection->upgrade(sslContext, tagDecoratorFactory, wsCompression, yield);
         if (expectedUpgradedConnection.has_value())
             return std::move(expectedUpgradedConnection).value();
 
@@ -198,12 +200,14 @@ Server::Server(
     std::optional<size_t> parallelRequestLimit,
     util::TagDecoratorFactory tagDecoratorFactory,
     std::optional<size_t> maxSubscriptionSendQueueSize,
+    WsCompressionOptions wsCompression,
     OnConnectCheck onConnectCheck,
     OnDisconnectHook onDisconnectHook
 )
     : ctx_{ctx}
     , sslContext_{std::move(sslContext)}
     , tagDecoratorFactory_{tagDecoratorFactory}
+    , wsCompression_{wsCompression}
     , connectionHandler_{processingPolicy, parallelRequestLimit, tagDecoratorFactory_, maxSubscriptionSendQueueSize, std::move(onDisconnectHook)}
     , endpoint_{std::move(endpoint)}
     , onConnectCheck_{std::move(onConnectCheck)}
@@ -316,8 +320,9 @@ Server::handleConnection(boost::asio::ip::tcp::socket socket, boost::asio::yield
         return;
     }
 
-    auto connection =
-        tryUpgradeConnection(std::move(connectionExpected).value(), sslContext_, tagDecoratorFactory_, yield);
+    auto connection = tryUpgradeConnection(
+        std::move(connectionExpected).value(), sslContext_, tagDecoratorFactory_, wsCompression_, yield
+    );
     if (not connection.has_value()) {
         LOG(log_.info()) << connection.error();
         return;
@@ -371,6 +376,7 @@ makeServer(
         parallelRequestLimit,
         util::TagDecoratorFactory(config),
         maxSubscriptionSendQueueSize,
+        WsCompressionOptions::fromConfig(config),
         std::move(onConnectCheck),
         std::move(onDisconnectHook)
     };
@@ -22,6 +22,7 @@
 #include "util/Taggable.hpp"
 #include "util/log/Logger.hpp"
 #include "util/newconfig/ConfigDefinition.hpp"
+#include "web/WsCompression.hpp"
 #include "web/ng/Connection.hpp"
 #include "web/ng/MessageHandler.hpp"
 #include "web/ng/ProcessingPolicy.hpp"
@@ -75,6 +76,7 @@ private:
     std::optional<boost::asio::ssl::context> sslContext_;
 
     util::TagDecoratorFactory tagDecoratorFactory_;
+    WsCompressionOptions wsCompression_;
 
     impl::ConnectionHandler connectionHandler_;
     boost::asio::ip::tcp::endpoint endpoint_;
@@ -95,6 +97,7 @@ public:
      * if processingPolicy is parallel.
      * @param tagDecoratorFactory The tag decorator factory.
      * @param maxSubscriptionSendQueueSize The maximum size of the subscription send queue.
+     * @param wsCompression The permessage-deflate settings for websocket connections.
      * @param onConnectCheck The check to perform on each connection.
      * @param onDisconnectHook The hook to call on each disconnection.
      */
@@ -106,6 +109,7 @@ public:
         std::optional<size_t> parallelRequestLimit,
         util::TagDecoratorFactory tagDecoratorFactory,
         std::optional<size_t> maxSubscriptionSendQueueSize,
+        WsCompressionOptions wsCompression,
         OnConnectCheck onConnectCheck,
         OnDisconnectHook onDisconnectHook
     );
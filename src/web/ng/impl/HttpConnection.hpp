@@ -21,6 +21,7 @@
 
 #include "util/Assert.hpp"
 #include "util/Taggable.hpp"
+#include "web/WsCompression.hpp"
 #include "web/ng/Connection.hpp"
 #include "web/ng/Error.hpp"
 #include "web/ng/Request.hpp"
@@ -60,6 +61,7 @@ public:
     upgrade(
         std::optional<boost::asio::ssl::context>& sslContext,
         util::TagDecoratorFactory const& tagDecoratorFactory,
+        WsCompressionOptions const& wsCompression,
         boost::asio::yield_context yield
     ) = 0;
 
@@ -186,6 +188,7 @@ public:
     upgrade(
         [[maybe_unused]] std::optional<boost::asio::ssl::context>& sslContext,
         util::TagDecoratorFactory const& tagDecoratorFactory,
+        WsCompressionOptions const& wsCompression,
         boost::asio::yield_context yield
     ) override
     {
@@ -200,6 +203,7 @@ public:
                 std::move(request_).value(),
                 sslContext.value(),
                 tagDecoratorFactory,
+                wsCompression,
                 yield
             );
         } else {
@@ -209,6 +213,7 @@ public:
                 std::move(buffer_),
                 std::move(request_).value(),
                 tagDecoratorFactory,
+                wsCompression,
                 yield
             );
         }
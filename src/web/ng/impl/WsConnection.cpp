@@ -20,6 +20,7 @@
 #include "web/ng/impl/WsConnection.hpp"
 
 #include "util/Taggable.hpp"
+#include "web/WsCompression.hpp"
 #include "web/ng/Error.hpp"
 
 #include <boost/asio/ip/tcp.hpp>
@@ -42,11 +43,12 @@ makePlainWsConnection(
     boost::beast::flat_buffer buffer,
     boost::beast::http::request<boost::beast::http::string_body> request,
     util::TagDecoratorFactory const& tagDecoratorFactory,
+    WsCompressionOptions const& compression,
     boost::asio::yield_context yield
 )
 {
     auto connection = std::make_unique<PlainWsConnection>(
-        std::move(socket), std::move(ip), std::move(buffer), std::move(request), tagDecoratorFactory
+        std::move(socket), std::move(ip), std::move(buffer), std::move(request), tagDecoratorFactory, compression
     );
     auto maybeError = connection->performHandshake(yield);
     if (maybeError.has_value())
@@ -62,11 +64,18 @@ makeSslWsConnection(
     boost::beast::http::request<boost::beast::http::string_body> request,
     boost::asio::ssl::context& sslContext,
     util::TagDecoratorFactory const& tagDecoratorFactory,
+    WsCompressionOptions const& compression,
     boost::asio::yield_context yield
 )
 {
     auto connection = std::make_unique<SslWsConnection>(
-        std::move(socket), std::move(ip), std::move(buffer), sslContext, std::move(request), tagDecoratorFactory
+        std::move(socket),
+        std::move(ip),
+        std::move(buffer),
+        sslContext,
+        std::move(request),
+        tagDecoratorFactory,
+        compression
     );
     auto maybeError = connection->performHandshake(yield);
     if (maybeError.has_value())
@@ -21,6 +21,7 @@
 
 #include "util/Taggable.hpp"
 #include "util/build/Build.hpp"
+#include "web/WsCompression.hpp"
 #include "web/ng/Connection.hpp"
 #include "web/ng/Error.hpp"
 #include "web/ng/Request.hpp"
@@ -64,6 +65,7 @@ template <typename StreamType>
 class WsConnection : public WsConnectionBase {
     boost::beast::websocket::stream<StreamType> stream_;
     boost::beast::http::request<boost::beast::http::string_body> initialRequest_;
+    WsCompression compression_;
     bool closed_{false};
 
 public:
@@ -72,12 +74,14 @@ public:
         std::string ip,
         boost::beast::flat_buffer buffer,
         boost::beast::http::request<boost::beast::http::string_body> initialRequest,
-        util::TagDecoratorFactory const& tagDecoratorFactory
+        util::TagDecoratorFactory const& tagDecoratorFactory,
+        WsCompressionOptions const& compression
     )
         requires IsTcpStream<StreamType>
         : WsConnectionBase(std::move(ip), std::move(buffer), tagDecoratorFactory)
         , stream_(std::move(socket))
         , initialRequest_(std::move(initialRequest))
+        , compression_(compression)
     {
         setupWsStream();
     }
@@ -88,12 +92,14 @@ public:
         boost::beast::flat_buffer buffer,
         boost::asio::ssl::context& sslContext,
         boost::beast::http::request<boost::beast::http::string_body> initialRequest,
-        util::TagDecoratorFactory const& tagDecoratorFactory
+        util::TagDecoratorFactory const& tagDecoratorFactory,
+        WsCompressionOptions const& compression
     )
         requires IsSslTcpStream<StreamType>
         : WsConnectionBase(std::move(ip), std::move(buffer), tagDecoratorFactory)
         , stream_(std::move(socket), sslContext)
         , initialRequest_(std::move(initialRequest))
+        , compression_(compression)
     {
         setupWsStream();
     }
@@ -121,6 +127,7 @@ public:
         stream_.get_option(timeoutOption);
 
         boost::system::error_code error;
+        stream_.compress(compression_.shouldCompress(buffer.size()));
         stream_.async_write(buffer, yield[error]);
         if (error)
             return error;
@@ -178,9 +185,11 @@ private:
         // Disable the timeout. The websocket::stream uses its own timeout settings.
         boost::beast::get_lowest_layer(stream_).expires_never();
         setTimeout(kDEFAULT_TIMEOUT);
+        compression_.setupStream(stream_);
         stream_.set_option(
-            boost::beast::websocket::stream_base::decorator([](boost::beast::websocket::response_type& res) {
+            boost::beast::websocket::stream_base::decorator([this](boost::beast::websocket::response_type& res) {
                 res.set(boost::beast::http::field::server, util::build::getClioFullVersionString());
+                compression_.onHandshake(res);
             })
         );
     }
@@ -196,6 +205,7 @@ makePlainWsConnection(
     boost::beast::flat_buffer buffer,
     boost::beast::http::request<boost::beast::http::string_body> request,
     util::TagDecoratorFactory const& tagDecoratorFactory,
+    WsCompressionOptions const& compression,
     boost::asio::yield_context yield
 );
 
@@ -207,6 +217,7 @@ makeSslWsConnection(
     boost::beast::http::request<boost::beast::http::string_body> request,
     boost::asio::ssl::context& sslContext,
     util::TagDecoratorFactory const& tagDecoratorFactory,
+    WsCompressionOptions const& compression,
     boost::asio::yield_context yield
 );
 
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include "data/cassandra/Error.hpp"
+#include "data/cassandra/Types.hpp"
 #include "data/cassandra/impl/AsyncExecutor.hpp"
 
 #include <boost/asio/io_context.hpp>
@@ -32,10 +33,19 @@
 using namespace data::cassandra;
 using namespace data::cassandra::impl;
 
-struct FakeResult {};
+struct FakeResult {
+    bool morePages = false;
+
+    bool
+    hasMorePages() const
+    {
+        return morePages;
+    }
+};
 
 struct FakeResultOrError {
     CassandraError err{"<default>", CASS_OK};
+    FakeResult result{};
 
     operator bool() const
     {
@@ -48,16 +58,31 @@ struct FakeResultOrError {
         return err;
     }
 
-    static FakeResult
-    value()
+    FakeResult
+    value() const
     {
-        return FakeResult{};
+        return result;
     }
 };
 
 struct FakeMaybeError {};
 
-struct FakeStatement {};
+struct FakeStatement {
+    std::uint32_t pageSize = 0;
+    std::uint32_t page = 0;
+
+    void
+    setPageSize(std::uint32_t size)
+    {
+        pageSize = size;
+    }
+
+    void
+    setPagingState(FakeResult const& /* result */)
+    {
+        ++page;
+    }
+};
 
 struct FakePreparedStatement {};
 
@@ -102,6 +127,13 @@ struct MockHandle {
         (const)
     );
 
+    MOCK_METHOD(
+        FutureWithCallbackType,
+        asyncExecute,
+        (UnloggedBatch<StatementType> const&, std::function<void(ResultOrErrorType)>&&),
+        (const)
+    );
+
     MOCK_METHOD(ResultOrErrorType, execute, (StatementType const&), (const));
 };
 
@@ -31,6 +31,7 @@
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <chrono>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -140,6 +141,13 @@ struct MockBackend : public BackendInterface {
         (const, override)
     );
 
+    MOCK_METHOD(
+        std::vector<std::optional<ripple::LedgerHeader>>,
+        doFetchLedgersBySequence,
+        (std::vector<std::uint32_t> const&, boost::asio::yield_context),
+        (const, override)
+    );
+
     MOCK_METHOD(
         std::vector<ripple::uint256>,
         fetchAccountRoots,
@@ -207,6 +215,10 @@ struct MockBackend : public BackendInterface {
 
     MOCK_METHOD(bool, isTooBusy, (), (const, override));
 
+    MOCK_METHOD(std::chrono::microseconds, readLatency, (), (const, override));
+
+    MOCK_METHOD(double, writeLoad, (), (const, override));
+
     MOCK_METHOD(boost::json::object, stats, (), (const, override));
 
     MOCK_METHOD(void, doWriteLedgerObject, (std::string&&, std::uint32_t const, std::string&&), (override));
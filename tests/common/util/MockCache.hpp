@@ -46,6 +46,10 @@ struct MockCache {
 
     MOCK_METHOD(std::optional<data::LedgerObject>, getPredecessor, (ripple::uint256 const& a, uint32_t b), (const));
 
+    MOCK_METHOD(void, setNumRetainedLedgers, (uint32_t), ());
+
+    MOCK_METHOD(void, setOrderBookIndexEnabled, (bool), ());
+
     MOCK_METHOD(void, setDisabled, (), ());
 
     MOCK_METHOD(bool, isDisabled, (), (const));
@@ -23,10 +23,13 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
 #include <cstdint>
 #include <optional>
 
 struct MockExtractionDataPipe {
+    MOCK_METHOD(void, waitForFetchSlot, (uint32_t), ());
+    MOCK_METHOD(void, releaseFetchSlot, (std::chrono::microseconds), ());
     MOCK_METHOD(void, push, (uint32_t, std::optional<FakeFetchResponse>&&), ());
     MOCK_METHOD(std::optional<FakeFetchResponse>, popNext, (uint32_t), ());
     MOCK_METHOD(uint32_t, getStride, (), (const));
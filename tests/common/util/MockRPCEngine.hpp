@@ -33,7 +33,7 @@
 struct MockAsyncRPCEngine {
     template <typename Fn>
     bool
-    post(Fn&& func, [[maybe_unused]] std::string const& ip = "")
+    post(Fn&& func, [[maybe_unused]] std::string const& ip = "", [[maybe_unused]] std::string const& method = "")
     {
         using namespace boost::asio;
         io_context ioc;
@@ -61,7 +61,12 @@ struct MockAsyncRPCEngine {
 };
 
 struct MockRPCEngine {
-    MOCK_METHOD(bool, post, (std::function<void(boost::asio::yield_context)>&&, std::string const&), ());
+    MOCK_METHOD(
+        bool,
+        post,
+        (std::function<void(boost::asio::yield_context)>&&, std::string const&, std::string const&),
+        ()
+    );
     MOCK_METHOD(void, notifyComplete, (std::string const&, std::chrono::microseconds const&), ());
     MOCK_METHOD(void, notifyErrored, (std::string const&), ());
     MOCK_METHOD(void, notifyForwarded, (std::string const&), ());
@@ -67,6 +67,13 @@ struct MockSubscriptionManager : feed::SubscriptionManagerInterface {
 
     MOCK_METHOD(void, pubTransaction, (data::TransactionAndMetadata const&, ripple::LedgerHeader const&), (override));
 
+    MOCK_METHOD(
+        void,
+        pubTransactions,
+        (std::vector<data::TransactionAndMetadata> const&, ripple::LedgerHeader const&),
+        (override)
+    );
+
     MOCK_METHOD(void, subAccount, (ripple::AccountID const&, feed::SubscriberSharedPtr const&), (override));
 
     MOCK_METHOD(void, unsubAccount, (ripple::AccountID const&, feed::SubscriberSharedPtr const&), (override));
@@ -36,6 +36,7 @@
 #include <boost/beast/core/stream_traits.hpp>
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/version.hpp>
+#include <boost/beast/websocket/option.hpp>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
@@ -53,6 +54,14 @@ namespace net = boost::asio;
 namespace ssl = boost::asio::ssl;
 using tcp = boost::asio::ip::tcp;
 
+void
+WebSocketSyncClient::enablePermessageDeflate()
+{
+    boost::beast::websocket::permessage_deflate options;
+    options.client_enable = true;
+    ws_.set_option(options);
+}
+
 void
 WebSocketSyncClient::connect(std::string const& host, std::string const& port, std::vector<WebHeader> additionalHeaders)
 {
@@ -92,6 +101,15 @@ WebSocketSyncClient::syncPost(std::string const& body)
     return boost::beast::buffers_to_string(buffer.data());
 }
 
+std::string
+WebSocketSyncClient::receive()
+{
+    boost::beast::flat_buffer buffer;
+    ws_.read(buffer);
+
+    return boost::beast::buffers_to_string(buffer.data());
+}
+
 void
 WebServerSslSyncClient::connect(std::string const& host, std::string const& port)
 {
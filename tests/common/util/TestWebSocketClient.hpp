@@ -40,6 +40,9 @@ class WebSocketSyncClient {
     boost::beast::websocket::stream<boost::asio::ip::tcp::socket> ws_{ioc_};
 
 public:
+    void
+    enablePermessageDeflate();
+
     void
     connect(std::string const& host, std::string const& port, std::vector<WebHeader> additionalHeaders = {});
 
@@ -48,6 +51,9 @@ public:
 
     std::string
     syncPost(std::string const& body);
+
+    std::string
+    receive();
 };
 
 class WebSocketAsyncClient {
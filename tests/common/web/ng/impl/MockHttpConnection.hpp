@@ -21,6 +21,7 @@
 #pragma once
 
 #include "util/Taggable.hpp"
+#include "web/WsCompression.hpp"
 #include "web/ng/Connection.hpp"
 #include "web/ng/Error.hpp"
 #include "web/ng/Request.hpp"
@@ -69,6 +70,7 @@ struct MockHttpConnectionImpl : web::ng::impl::UpgradableConnection {
         upgrade,
         (OptionalSslContext & sslContext,
          util::TagDecoratorFactory const& tagDecoratorFactory,
+         web::WsCompressionOptions const& wsCompression,
          boost::asio::yield_context yield),
         (override)
     );
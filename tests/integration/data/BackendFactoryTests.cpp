@@ -61,6 +61,13 @@ protected:
         {"database.cassandra.core_connections_per_host", ConfigValue{ConfigType::Integer}.defaultValue(1)},
         {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional()},
         {"database.cassandra.write_batch_size", ConfigValue{ConfigType::Integer}.defaultValue(20)},
+        {"database.cassandra.read_page_size", ConfigValue{ConfigType::Integer}.defaultValue(5000)},
+        {"database.cassandra.immutable_read_consistency", ConfigValue{ConfigType::String}.defaultValue("quorum")},
+        {"database.cassandra.speculative_execution_delay", ConfigValue{ConfigType::Integer}.optional()},
+        {"database.cassandra.max_speculative_executions", ConfigValue{ConfigType::Integer}.defaultValue(1)},
+        {"database.cassandra.hedge_reads", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"database.cassandra.account_tx_cache.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"database.cassandra.account_tx_cache.max_bytes", ConfigValue{ConfigType::Integer}.defaultValue(1024 * 1024)},
         {"database.cassandra.connect_timeout", ConfigValue{ConfigType::Integer}.defaultValue(1).optional()},
         {"database.cassandra.request_timeout", ConfigValue{ConfigType::Integer}.optional()},
         {"database.cassandra.username", ConfigValue{ConfigType::String}.optional()},
@@ -91,6 +91,13 @@ protected:
         {"database.cassandra.core_connections_per_host", ConfigValue{ConfigType::Integer}.defaultValue(1)},
         {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional()},
         {"database.cassandra.write_batch_size", ConfigValue{ConfigType::Integer}.defaultValue(20)},
+        {"database.cassandra.read_page_size", ConfigValue{ConfigType::Integer}.defaultValue(5000)},
+        {"database.cassandra.immutable_read_consistency", ConfigValue{ConfigType::String}.defaultValue("quorum")},
+        {"database.cassandra.speculative_execution_delay", ConfigValue{ConfigType::Integer}.optional()},
+        {"database.cassandra.max_speculative_executions", ConfigValue{ConfigType::Integer}.defaultValue(1)},
+        {"database.cassandra.hedge_reads", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"database.cassandra.account_tx_cache.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
+        {"database.cassandra.account_tx_cache.max_bytes", ConfigValue{ConfigType::Integer}.defaultValue(1024 * 1024)},
         {"database.cassandra.connect_timeout", ConfigValue{ConfigType::Integer}.defaultValue(1).optional()},
         {"database.cassandra.request_timeout", ConfigValue{ConfigType::Integer}.defaultValue(1).optional()},
         {"database.cassandra.username", ConfigValue{ConfigType::String}.optional()},
@@ -200,6 +207,15 @@ TEST_F(BackendCassandraTest, Basic)
             retLgr = backend_->fetchLedgerBySequence(lgrInfoNext.seq - 2, yield);
             EXPECT_FALSE(backend_->fetchLedgerBySequence(lgrInfoNext.seq - 2, yield).has_value());
 
+            auto const headers = backend_->fetchLedgersBySequence(
+                {lgrInfoNext.seq, lgrInfoNext.seq - 2, lgrInfoOld.seq, lgrInfoNext.seq}, yield
+            );
+            ASSERT_EQ(headers.size(), 4);
+            EXPECT_EQ(ledgerHeaderToBlob(*headers[0]), ledgerHeaderToBlob(lgrInfoNext));
+            EXPECT_FALSE(headers[1].has_value());
+            EXPECT_EQ(ledgerHeaderToBlob(*headers[2]), ledgerHeaderToBlob(lgrInfoOld));
+            EXPECT_EQ(ledgerHeaderToBlob(*headers[3]), ledgerHeaderToBlob(lgrInfoNext));
+
             auto txns = backend_->fetchAllTransactionsInLedger(lgrInfoNext.seq, yield);
             EXPECT_EQ(txns.size(), 0);
 
@@ -122,6 +122,17 @@ protected:
           ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint16)},
          {"database.cassandra.write_batch_size",
           ConfigValue{ConfigType::Integer}.defaultValue(20).withConstraint(gValidateUint16)},
+         {"database.cassandra.read_page_size",
+          ConfigValue{ConfigType::Integer}.defaultValue(5000).withConstraint(gValidateUint16)},
+         {"database.cassandra.immutable_read_consistency",
+          ConfigValue{ConfigType::String}.defaultValue("quorum").withConstraint(gValidateReadConsistency)},
+         {"database.cassandra.speculative_execution_delay",
+          ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)},
+         {"database.cassandra.max_speculative_executions",
+          ConfigValue{ConfigType::Integer}.defaultValue(1).withConstraint(gValidateUint16)},
+         {"database.cassandra.hedge_reads", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+         {"database.cassandra.account_tx_cache.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+         {"database.cassandra.account_tx_cache.max_bytes", ConfigValue{ConfigType::Integer}.defaultValue(1024 * 1024)},
          {"database.cassandra.connect_timeout",
           ConfigValue{ConfigType::Integer}.optional().withConstraint(gValidateUint32)},
          {"database.cassandra.request_timeout",
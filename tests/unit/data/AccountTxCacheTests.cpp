@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/AccountTxCache.hpp"
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/protocol/AccountID.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto kACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto kACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+
+constexpr uint32_t kSEQ = 30;
+
+TransactionsAndCursor
+createPage(uint32_t seq, std::size_t numTxns)
+{
+    TransactionsAndCursor page;
+    for (auto i = 0uz; i < numTxns; ++i)
+        page.txns.push_back(TransactionAndMetadata{{1}, {2}, seq, 0});
+    page.cursor = TransactionsCursor{seq, 0};
+    return page;
+}
+
+std::vector<AccountTransactionsData>
+createAccountTxns(ripple::AccountID const& account, uint32_t seq)
+{
+    AccountTransactionsData data;
+    data.accounts.insert(account);
+    data.ledgerSequence = seq;
+    return {data};
+}
+
+}  // namespace
+
+struct AccountTxCacheTest : util::prometheus::WithPrometheus {
+    ripple::AccountID const account = getAccountIdWithString(kACCOUNT);
+    ripple::AccountID const account2 = getAccountIdWithString(kACCOUNT2);
+
+    AccountTxCache::PageKey const newestPage{.account = account, .forward = false, .limit = 10, .cursor = {}};
+    AccountTxCache::PageKey const olderPage{
+        .account = account, .forward = false, .limit = 10, .cursor = TransactionsCursor{kSEQ - 5, 0}
+    };
+
+    // every transaction of a page created by createPage holds two bytes of blobs
+    AccountTxCache cache{20};
+};
+
+TEST_F(AccountTxCacheTest, NewestPageIsValidOnlyForItsLedger)
+{
+    cache.put(newestPage, createPage(kSEQ, 2), kSEQ);
+
+    auto const page = cache.get(newestPage, kSEQ);
+    ASSERT_TRUE(page.has_value());
+    EXPECT_EQ(page->txns.size(), 2u);
+    EXPECT_FALSE(cache.get(newestPage, kSEQ + 1).has_value());
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(AccountTxCacheTest, BackwardPageFromValidatedCursorNeverExpires)
+{
+    cache.put(olderPage, createPage(kSEQ - 6, 2), kSEQ);
+    EXPECT_TRUE(cache.get(olderPage, kSEQ + 100).has_value());
+}
+
+TEST_F(AccountTxCacheTest, PagesSurviveCommittedLedgersNotTouchingTheAccount)
+{
+    cache.commit(kSEQ);
+    cache.put(newestPage, createPage(kSEQ, 2), kSEQ);
+
+    cache.invalidate(createAccountTxns(account2, kSEQ + 1));
+    cache.commit(kSEQ + 1);
+    EXPECT_TRUE(cache.get(newestPage, kSEQ + 1).has_value());
+
+    // a ledger that was not committed through the cache may hold transactions of the account
+    EXPECT_FALSE(cache.get(newestPage, kSEQ + 2).has_value());
+}
+
+TEST_F(AccountTxCacheTest, WritesInvalidateThePagesOfTheAccount)
+{
+    cache.commit(kSEQ);
+    cache.put(newestPage, createPage(kSEQ, 2), kSEQ);
+    cache.put(olderPage, createPage(kSEQ - 6, 2), kSEQ);
+
+    cache.invalidate(createAccountTxns(account, kSEQ + 1));
+    EXPECT_EQ(cache.size(), 0u);
+
+    // a page read while the ledger is being written is dropped once it is committed
+    cache.put(newestPage, createPage(kSEQ, 2), kSEQ);
+    cache.commit(kSEQ + 1);
+    EXPECT_FALSE(cache.get(newestPage, kSEQ + 1).has_value());
+}
+
+TEST_F(AccountTxCacheTest, PageReadBeforeLatestCommitIsNotCached)
+{
+    cache.commit(kSEQ + 1);
+    cache.put(newestPage, createPage(kSEQ, 2), kSEQ);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(AccountTxCacheTest, EvictsLeastRecentlyUsedPagesBeyondMaxBytes)
+{
+    auto const otherPage = AccountTxCache::PageKey{.account = account2, .forward = true, .limit = 10, .cursor = {}};
+
+    cache.put(newestPage, createPage(kSEQ, 4), kSEQ);
+    cache.put(olderPage, createPage(kSEQ - 6, 4), kSEQ);
+    EXPECT_TRUE(cache.get(newestPage, kSEQ).has_value());
+
+    cache.put(otherPage, createPage(kSEQ, 4), kSEQ);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_TRUE(cache.get(newestPage, kSEQ).has_value());
+    EXPECT_FALSE(cache.get(olderPage, kSEQ).has_value());
+    EXPECT_TRUE(cache.get(otherPage, kSEQ).has_value());
+}
+
+TEST_F(AccountTxCacheTest, CountsTheSizeOfTheBlobs)
+{
+    auto page = createPage(kSEQ, 2);
+    page.txns.front().transaction = Blob(5, 1);
+    page.txns.front().metadata = Blob(3, 2);
+
+    cache.put(newestPage, page, kSEQ);
+    EXPECT_EQ(cache.bytes(), 10u);
+
+    cache.invalidate(createAccountTxns(account, kSEQ + 1));
+    EXPECT_EQ(cache.bytes(), 0u);
+}
+
+TEST_F(AccountTxCacheTest, PageLargerThanMaxBytesIsNotCached)
+{
+    cache.put(newestPage, createPage(kSEQ, 11), kSEQ);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.bytes(), 0u);
+}
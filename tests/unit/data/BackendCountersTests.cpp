@@ -48,7 +48,9 @@ struct BackendCountersTest : WithPrometheus {
             "read_async_pending": 0,
             "read_async_completed": 0,
             "read_async_retry": 0,
-            "read_async_error": 0
+            "read_async_error": 0,
+            "read_hedge_fired": 0,
+            "read_hedge_won": 0
         })")
             .as_object();
     }
@@ -167,6 +169,47 @@ TEST_F(BackendCountersTest, RegisterReadStartedFinishedWithCounters)
     EXPECT_EQ(counters->report(), expectedReport);
 }
 
+TEST_F(BackendCountersTest, ReadLatencyFollowsFinishedReads)
+{
+    EXPECT_EQ(counters->readLatency(), std::chrono::microseconds{0});
+
+    auto const slowStart = std::chrono::steady_clock::now() - std::chrono::milliseconds{80};
+    counters->registerReadStarted();
+    counters->registerReadFinished(slowStart);
+    auto const afterOneRead = counters->readLatency();
+    EXPECT_GT(afterOneRead, std::chrono::microseconds{0});
+
+    counters->registerReadStarted();
+    counters->registerReadFinished(slowStart);
+    EXPECT_GT(counters->readLatency(), afterOneRead);
+    EXPECT_LT(counters->readLatency(), std::chrono::milliseconds{80});
+}
+
+TEST_F(BackendCountersTest, ReadTailLatencyIsAboveLatencyWhenLatencyVaries)
+{
+    EXPECT_EQ(counters->readTailLatency(), std::chrono::microseconds{0});
+
+    auto const now = std::chrono::steady_clock::now();
+    for (auto const latency : {std::chrono::milliseconds{10}, std::chrono::milliseconds{50}}) {
+        counters->registerReadStarted();
+        counters->registerReadFinished(now - latency);
+    }
+
+    EXPECT_GT(counters->readTailLatency(), counters->readLatency());
+}
+
+TEST_F(BackendCountersTest, RegisterReadHedge)
+{
+    counters->registerReadHedgeFired();
+    counters->registerReadHedgeFired();
+    counters->registerReadHedgeWon();
+
+    auto expectedReport = emptyReport();
+    expectedReport["read_hedge_fired"] = 2;
+    expectedReport["read_hedge_won"] = 1;
+    EXPECT_EQ(counters->report(), expectedReport);
+}
+
 TEST_F(BackendCountersTest, RegisterReadRetry)
 {
     auto const counters = BackendCounters::make();
@@ -253,6 +296,13 @@ TEST_F(BackendCountersMockPrometheusTest, registerWriteRetry)
     counters->registerWriteRetry();
 }
 
+TEST_F(BackendCountersMockPrometheusTest, registerWriteBatch)
+{
+    auto& histogram = makeMock<HistogramInt>("backend_write_batch_size_histogram", "");
+    EXPECT_CALL(histogram, observe(7));
+    counters->registerWriteBatch(7);
+}
+
 TEST_F(BackendCountersMockPrometheusTest, registerReadStarted)
 {
     auto& counter =
@@ -295,3 +345,19 @@ TEST_F(BackendCountersMockPrometheusTest, registerReadError)
     EXPECT_CALL(errorCounter, add(1));
     counters->registerReadError();
 }
+
+TEST_F(BackendCountersMockPrometheusTest, registerReadHedgeFired)
+{
+    auto& counter =
+        makeMock<CounterInt>("backend_operations_total_number", "{operation=\"read_hedge\",status=\"fired\"}");
+    EXPECT_CALL(counter, add(1));
+    counters->registerReadHedgeFired();
+}
+
+TEST_F(BackendCountersMockPrometheusTest, registerReadHedgeWon)
+{
+    auto& counter =
+        makeMock<CounterInt>("backend_operations_total_number", "{operation=\"read_hedge\",status=\"won\"}");
+    EXPECT_CALL(counter, add(1));
+    counters->registerReadHedgeWon();
+}
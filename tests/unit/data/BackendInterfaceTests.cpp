@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include "data/Types.hpp"
 #include "etl/CorruptionDetector.hpp"
 #include "etl/SystemState.hpp"
 #include "util/AsioContextTestFixture.hpp"
@@ -29,8 +30,11 @@
 #include <xrpl/basics/Blob.h>
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/XRPAmount.h>
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -42,6 +46,23 @@ namespace {
 
 constexpr auto kMAX_SEQ = 30;
 constexpr auto kMIN_SEQ = 10;
+constexpr std::uint32_t kHEADER_SEQ = 20;
+constexpr auto kLEDGER_HASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+
+constexpr auto kBOOK = "CAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFE0000000000000000";
+constexpr auto kBOOK_DIR = "CAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFE0000000000000001";
+constexpr auto kOFFER1 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr auto kOFFER2 = "2B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr auto kOFFER3 = "3B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+
+Blob
+createBookDirPageBlob(ripple::uint256 const& offer, std::uint64_t next, std::uint64_t prev)
+{
+    auto dir = createOwnerDirLedgerObject({offer}, kBOOK_DIR);
+    dir.setFieldU64(ripple::sfIndexNext, next);
+    dir.setFieldU64(ripple::sfIndexPrevious, prev);
+    return dir.getSerializer().peekData();
+}
 
 }  // namespace
 
@@ -141,3 +162,119 @@ TEST_F(BackendInterfaceTest, FetchLedgerPageWithoutCorruptionDetectorDoesNotDisa
     runSpawn([this](auto yield) { backend_->fetchLedgerPage(std::nullopt, kMAX_SEQ, 10, false, yield); });
     EXPECT_FALSE(backend_->cache().isDisabled());
 }
+
+TEST_F(BackendInterfaceTest, FetchLedgerPageFetchesObjectsInChunksWhileWalkingSuccessors)
+{
+    using namespace ripple;
+
+    EXPECT_CALL(*backend_, doFetchSuccessorKey(_, _, _))
+        .Times(100)
+        .WillRepeatedly(Return(uint256{"1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"}));
+    EXPECT_CALL(*backend_, doFetchLedgerObjects(SizeIs(64), _, _)).WillOnce(Return(std::vector<Blob>(64, Blob{'s'})));
+    EXPECT_CALL(*backend_, doFetchLedgerObjects(SizeIs(36), _, _)).WillOnce(Return(std::vector<Blob>(36, Blob{'s'})));
+
+    runSpawn([this](auto yield) {
+        auto const page = backend_->fetchLedgerPage(std::nullopt, kMAX_SEQ, 100, false, yield);
+        EXPECT_EQ(page.objects.size(), 100u);
+        EXPECT_TRUE(page.cursor.has_value());
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchBookOffersPrefetchesDirectoryPagesWithRootOffers)
+{
+    using namespace ripple;
+
+    auto const bookDir = uint256{kBOOK_DIR};
+    auto const page1 = keylet::page(bookDir, 1).key;
+    auto const page2 = keylet::page(bookDir, 2).key;
+
+    EXPECT_CALL(*backend_, doFetchSuccessorKey(uint256{kBOOK}, kMAX_SEQ, _)).WillOnce(Return(bookDir));
+    EXPECT_CALL(*backend_, doFetchSuccessorKey(bookDir, kMAX_SEQ, _)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*backend_, doFetchLedgerObject(bookDir, kMAX_SEQ, _))
+        .WillOnce(Return(createBookDirPageBlob(uint256{kOFFER1}, 1, 2)));
+
+    // only the first page is needed to fill the page if directory pages are full; the second one is read on demand
+    EXPECT_CALL(*backend_, doFetchLedgerObjects(ElementsAre(uint256{kOFFER1}, page1), kMAX_SEQ, _))
+        .WillOnce(Return(std::vector<Blob>{Blob{'1'}, createBookDirPageBlob(uint256{kOFFER2}, 2, 0)}));
+    EXPECT_CALL(*backend_, doFetchLedgerObject(page2, kMAX_SEQ, _))
+        .WillOnce(Return(createBookDirPageBlob(uint256{kOFFER3}, 0, 1)));
+    EXPECT_CALL(*backend_, doFetchLedgerObjects(ElementsAre(uint256{kOFFER2}, uint256{kOFFER3}), kMAX_SEQ, _))
+        .WillOnce(Return(std::vector<Blob>{Blob{'2'}, Blob{'3'}}));
+
+    runSpawn([this](auto yield) {
+        auto const page = backend_->fetchBookOffers(uint256{kBOOK}, kMAX_SEQ, 10, yield);
+        ASSERT_EQ(page.offers.size(), 3u);
+        EXPECT_EQ(page.offers[0].key, uint256{kOFFER1});
+        EXPECT_EQ(page.offers[0].blob, Blob{'1'});
+        EXPECT_EQ(page.offers[1].key, uint256{kOFFER2});
+        EXPECT_EQ(page.offers[1].blob, Blob{'2'});
+        EXPECT_EQ(page.offers[2].key, uint256{kOFFER3});
+        EXPECT_EQ(page.offers[2].blob, Blob{'3'});
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchBookOffersIsServedFromFullCache)
+{
+    using namespace ripple;
+
+    auto const bookDir = uint256{kBOOK_DIR};
+    backend_->cache().update(
+        {{.key = bookDir, .blob = createBookDirPageBlob(uint256{kOFFER1}, 1, 1)},
+         {.key = keylet::page(bookDir, 1).key, .blob = createBookDirPageBlob(uint256{kOFFER2}, 0, 0)},
+         {.key = uint256{kOFFER1}, .blob = Blob{'1'}},
+         {.key = uint256{kOFFER2}, .blob = Blob{'2'}},
+         {.key = getQualityNext(uint256{kBOOK}), .blob = Blob{'x'}}},
+        kMAX_SEQ
+    );
+    backend_->cache().setFull();
+
+    EXPECT_CALL(*backend_, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(0);
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(0);
+
+    runSpawn([this](auto yield) {
+        auto const page = backend_->fetchBookOffers(uint256{kBOOK}, kMAX_SEQ, 10, yield);
+        ASSERT_EQ(page.offers.size(), 2u);
+        EXPECT_EQ(page.offers[0].blob, Blob{'1'});
+        EXPECT_EQ(page.offers[1].blob, Blob{'2'});
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchLedgersBySequenceFetchesDistinctMissesInOneBatch)
+{
+    auto const header1 = createLedgerHeader(kLEDGER_HASH, kHEADER_SEQ);
+    auto const header2 = createLedgerHeader(kLEDGER_HASH, kHEADER_SEQ + 1);
+
+    EXPECT_CALL(*backend_, doFetchLedgersBySequence(ElementsAre(kHEADER_SEQ, kHEADER_SEQ + 1, kHEADER_SEQ + 2), _))
+        .WillOnce(Return(std::vector<std::optional<ripple::LedgerHeader>>{header1, header2, std::nullopt}));
+
+    runSpawn([&, this](auto yield) {
+        auto const headers =
+            backend_->fetchLedgersBySequence({kHEADER_SEQ, kHEADER_SEQ + 1, kHEADER_SEQ, kHEADER_SEQ + 2}, yield);
+        ASSERT_EQ(headers.size(), 4u);
+        EXPECT_EQ(headers[0]->seq, kHEADER_SEQ);
+        EXPECT_EQ(headers[1]->seq, kHEADER_SEQ + 1);
+        EXPECT_EQ(headers[2]->seq, kHEADER_SEQ);
+        EXPECT_FALSE(headers[3].has_value());
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchLedgersBySequenceServesCachedHeaders)
+{
+    auto const header1 = createLedgerHeader(kLEDGER_HASH, kHEADER_SEQ);
+    auto const header2 = createLedgerHeader(kLEDGER_HASH, kHEADER_SEQ + 1);
+
+    EXPECT_CALL(*backend_, doFetchLedgersBySequence(ElementsAre(kHEADER_SEQ), _))
+        .WillOnce(Return(std::vector<std::optional<ripple::LedgerHeader>>{header1}));
+    EXPECT_CALL(*backend_, doFetchLedgersBySequence(ElementsAre(kHEADER_SEQ + 1), _))
+        .WillOnce(Return(std::vector<std::optional<ripple::LedgerHeader>>{header2}));
+
+    runSpawn([&, this](auto yield) {
+        EXPECT_EQ(backend_->fetchLedgersBySequence({kHEADER_SEQ}, yield).front()->seq, kHEADER_SEQ);
+
+        auto const headers = backend_->fetchLedgersBySequence({kHEADER_SEQ, kHEADER_SEQ + 1}, yield);
+        ASSERT_EQ(headers.size(), 2u);
+        EXPECT_EQ(headers[0]->seq, kHEADER_SEQ);
+        EXPECT_EQ(headers[1]->seq, kHEADER_SEQ + 1);
+    });
+}
@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/DBHelpers.hpp"
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+// keys in different shards, in ascending order
+ripple::uint256 const kKEY1{"05E1EAC2574BE082B00B16F907CE32E6058DEB8F9E81CF34A00E80A5D71FA4FE"};
+ripple::uint256 const kKEY2{"110872C7196EE6EF7032952F1852B11BB461A96FF2D7E06A8003B4BB30FD130B"};
+ripple::uint256 const kKEY3{"3B3A84E850C724E914293271785A31D0BFC8B9DD1B6332E527B149AD72E80E18"};
+ripple::uint256 const kKEY4{"3B3A84E850C724E914293271785A31D0BFC8B9DD1B6332E527B149AD72E80E19"};
+
+Blob const kBLOB1{1};
+Blob const kBLOB2{2};
+
+constexpr uint32_t kSEQ = 30;
+
+}  // namespace
+
+struct LedgerCacheTest : util::prometheus::WithPrometheus {
+    LedgerCache cache;
+};
+
+TEST_F(LedgerCacheTest, GetAndSuccessorAtLatestSequence)
+{
+    cache.update({{.key = kKEY1, .blob = kBLOB1}, {.key = kKEY3, .blob = kBLOB1}}, kSEQ);
+    cache.setFull();
+
+    EXPECT_EQ(cache.latestLedgerSequence(), kSEQ);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.get(kKEY1, kSEQ), kBLOB1);
+    EXPECT_FALSE(cache.get(kKEY2, kSEQ).has_value());
+    EXPECT_FALSE(cache.get(kKEY1, kSEQ + 1).has_value());
+
+    auto const succ = cache.getSuccessor(kKEY1, kSEQ);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, kKEY3);
+    EXPECT_FALSE(cache.getSuccessor(kKEY3, kSEQ).has_value());
+
+    auto const pred = cache.getPredecessor(kKEY3, kSEQ);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->key, kKEY1);
+    EXPECT_FALSE(cache.getPredecessor(kKEY1, kSEQ).has_value());
+}
+
+TEST_F(LedgerCacheTest, SuccessorIsNotServedWhenNotFull)
+{
+    cache.update({{.key = kKEY1, .blob = kBLOB1}, {.key = kKEY3, .blob = kBLOB1}}, kSEQ);
+
+    EXPECT_EQ(cache.get(kKEY1, kSEQ), kBLOB1);
+    EXPECT_FALSE(cache.getSuccessor(kKEY1, kSEQ).has_value());
+    EXPECT_FALSE(cache.getPredecessor(kKEY3, kSEQ).has_value());
+}
+
+TEST_F(LedgerCacheTest, PreviousSequencesAreNotServedWithoutRetainedLedgers)
+{
+    cache.update({{.key = kKEY1, .blob = kBLOB1}, {.key = kKEY3, .blob = kBLOB1}}, kSEQ);
+    cache.setFull();
+    cache.update({{.key = kKEY1, .blob = kBLOB2}}, kSEQ + 1);
+
+    EXPECT_EQ(cache.get(kKEY1, kSEQ + 1), kBLOB2);
+    EXPECT_FALSE(cache.get(kKEY1, kSEQ).has_value());
+    EXPECT_EQ(cache.get(kKEY3, kSEQ), kBLOB1);
+    EXPECT_FALSE(cache.getSuccessor(kKEY1, kSEQ).has_value());
+}
+
+TEST_F(LedgerCacheTest, RetainedLedgersServeModifiedAndDeletedObjects)
+{
+    cache.setNumRetainedLedgers(2);
+    cache.update({{.key = kKEY1, .blob = kBLOB1}, {.key = kKEY3, .blob = kBLOB1}}, kSEQ);
+    cache.setFull();
+
+    cache.update({{.key = kKEY1, .blob = kBLOB2}, {.key = kKEY2, .blob = kBLOB1}}, kSEQ + 1);
+    cache.update({{.key = kKEY3, .blob = {}}}, kSEQ + 2);
+
+    EXPECT_EQ(cache.get(kKEY1, kSEQ), kBLOB1);
+    EXPECT_EQ(cache.get(kKEY1, kSEQ + 1), kBLOB2);
+    EXPECT_EQ(cache.get(kKEY3, kSEQ + 1), kBLOB1);
+    EXPECT_FALSE(cache.get(kKEY3, kSEQ + 2).has_value());
+    EXPECT_FALSE(cache.get(kKEY2, kSEQ).has_value());
+
+    // kKEY2 did not exist yet and kKEY3 was not deleted yet
+    auto const succ = cache.getSuccessor(kKEY1, kSEQ);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, kKEY3);
+    EXPECT_EQ(succ->blob, kBLOB1);
+
+    auto const pred = cache.getPredecessor(kKEY4, kSEQ + 1);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->key, kKEY3);
+
+    auto const latestSucc = cache.getSuccessor(kKEY2, kSEQ + 2);
+    EXPECT_FALSE(latestSucc.has_value());
+}
+
+TEST_F(LedgerCacheTest, VersionsOutsideOfRetainedWindowAreDropped)
+{
+    cache.setNumRetainedLedgers(1);
+    cache.update({{.key = kKEY1, .blob = kBLOB1}, {.key = kKEY3, .blob = kBLOB1}}, kSEQ);
+    cache.setFull();
+
+    cache.update({{.key = kKEY1, .blob = kBLOB2}}, kSEQ + 1);
+    EXPECT_EQ(cache.get(kKEY1, kSEQ), kBLOB1);
+
+    cache.update({{.key = kKEY3, .blob = kBLOB2}}, kSEQ + 2);
+    EXPECT_FALSE(cache.get(kKEY1, kSEQ).has_value());
+    EXPECT_EQ(cache.get(kKEY1, kSEQ + 1), kBLOB2);
+    EXPECT_EQ(cache.get(kKEY3, kSEQ + 1), kBLOB1);
+    EXPECT_FALSE(cache.getSuccessor(kKEY1, kSEQ).has_value());
+}
+
+TEST_F(LedgerCacheTest, ContainsSequence)
+{
+    cache.setNumRetainedLedgers(1);
+    cache.update({{.key = kKEY1, .blob = kBLOB1}}, kSEQ);
+    EXPECT_FALSE(cache.containsSequence(kSEQ));
+
+    cache.setFull();
+    EXPECT_TRUE(cache.containsSequence(kSEQ));
+    EXPECT_FALSE(cache.containsSequence(kSEQ + 1));
+
+    cache.update({{.key = kKEY1, .blob = kBLOB2}}, kSEQ + 1);
+    cache.update({{.key = kKEY1, .blob = kBLOB1}}, kSEQ + 2);
+    EXPECT_TRUE(cache.containsSequence(kSEQ + 2));
+    EXPECT_TRUE(cache.containsSequence(kSEQ + 1));
+    EXPECT_FALSE(cache.containsSequence(kSEQ));
+
+    cache.setDisabled();
+    EXPECT_FALSE(cache.containsSequence(kSEQ + 2));
+}
+
+struct LedgerCacheOrderBookTest : LedgerCacheTest {
+    static constexpr auto kACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+    static constexpr auto kQUALITY = "CAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFE0000000000000001";
+
+    ripple::uint256 const quality{kQUALITY};
+    ripple::uint256 const book = getBookBase(quality);
+
+    static Blob
+    offer(int takerGets)
+    {
+        return createOfferLedgerObject(kACCOUNT, takerGets, 20, "USD", "EUR", kACCOUNT, kACCOUNT, kQUALITY)
+            .getSerializer()
+            .peekData();
+    }
+
+    static Blob
+    dir(std::vector<ripple::uint256> offers)
+    {
+        return createOwnerDirLedgerObject(std::move(offers), kQUALITY).getSerializer().peekData();
+    }
+};
+
+TEST_F(LedgerCacheOrderBookTest, OrderBookIndexIsBuiltWhenFullAndFollowsNewLedgers)
+{
+    cache.setOrderBookIndexEnabled(true);
+    cache.update({{.key = quality, .blob = dir({kKEY1})}, {.key = kKEY1, .blob = offer(10)}}, kSEQ);
+    EXPECT_FALSE(cache.getBookOffers(book, kSEQ, 10).has_value());
+
+    cache.setFull();
+    auto const offers = cache.getBookOffers(book, kSEQ, 10);
+    ASSERT_TRUE(offers.has_value());
+    ASSERT_EQ(offers->size(), 1u);
+    EXPECT_EQ(offers->front()->key, kKEY1);
+
+    cache.update({{.key = quality, .blob = dir({kKEY1, kKEY2})}, {.key = kKEY2, .blob = offer(11)}}, kSEQ + 1);
+    EXPECT_FALSE(cache.getBookOffers(book, kSEQ, 10).has_value());
+    auto const newOffers = cache.getBookOffers(book, kSEQ + 1, 10);
+    ASSERT_TRUE(newOffers.has_value());
+    ASSERT_EQ(newOffers->size(), 2u);
+    EXPECT_EQ(newOffers->back()->key, kKEY2);
+
+    cache.setDisabled();
+    EXPECT_FALSE(cache.getBookOffers(book, kSEQ + 1, 10).has_value());
+}
+
+TEST_F(LedgerCacheOrderBookTest, OrderBookIndexFollowsLedgersAppliedWhileItIsBuilt)
+{
+    static constexpr auto kNUM_LEDGERS = 100u;
+    auto const offerKey = [](uint32_t i) { return ripple::uint256{i + 1}; };
+
+    cache.setOrderBookIndexEnabled(true);
+    cache.update({{.key = quality, .blob = dir({offerKey(0)})}, {.key = offerKey(0), .blob = offer(10)}}, kSEQ);
+
+    // every ledger replaces the only offer of the book
+    std::thread writer{[&] {
+        for (auto i = 1u; i <= kNUM_LEDGERS; ++i) {
+            cache.update(
+                {{.key = quality, .blob = dir({offerKey(i)})},
+                 {.key = offerKey(i - 1), .blob = {}},
+                 {.key = offerKey(i), .blob = offer(10)}},
+                kSEQ + i
+            );
+        }
+    }};
+
+    cache.setFull();
+    writer.join();
+
+    auto const offers = cache.getBookOffers(book, kSEQ + kNUM_LEDGERS, 10);
+    ASSERT_TRUE(offers.has_value());
+    ASSERT_EQ(offers->size(), 1u);
+    EXPECT_EQ(offers->front()->key, offerKey(kNUM_LEDGERS));
+}
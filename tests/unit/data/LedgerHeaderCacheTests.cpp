@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstdint>
+
+using namespace data;
+
+namespace {
+
+constexpr auto kLEDGER_HASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto kLEDGER_HASH2 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+
+}  // namespace
+
+TEST(LedgerHeaderCacheTest, GetReturnsStoredHeader)
+{
+    LedgerHeaderCache cache{2};
+    EXPECT_FALSE(cache.get(1).has_value());
+
+    cache.put(createLedgerHeader(kLEDGER_HASH, 1));
+    auto const header = cache.get(1);
+    ASSERT_TRUE(header.has_value());
+    EXPECT_EQ(header->seq, 1u);
+    EXPECT_EQ(header->hash, ripple::uint256{kLEDGER_HASH});
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(LedgerHeaderCacheTest, PutReplacesHeaderWithSameSequence)
+{
+    LedgerHeaderCache cache{2};
+    cache.put(createLedgerHeader(kLEDGER_HASH, 1));
+    cache.put(createLedgerHeader(kLEDGER_HASH2, 1));
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.get(1)->hash, ripple::uint256{kLEDGER_HASH2});
+}
+
+TEST(LedgerHeaderCacheTest, EvictsLeastRecentlyUsedHeader)
+{
+    LedgerHeaderCache cache{2};
+    cache.put(createLedgerHeader(kLEDGER_HASH, 1));
+    cache.put(createLedgerHeader(kLEDGER_HASH, 2));
+
+    // touching 1 makes 2 the least recently used header
+    EXPECT_TRUE(cache.get(1).has_value());
+    cache.put(createLedgerHeader(kLEDGER_HASH, 3));
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_TRUE(cache.get(1).has_value());
+    EXPECT_FALSE(cache.get(2).has_value());
+    EXPECT_TRUE(cache.get(3).has_value());
+}
@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/OrderBookIndex.hpp"
+#include "data/Types.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STAmount.h>
+
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto kACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto kACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+
+ripple::uint256 const kBOOK{"CAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFE0000000000000000"};
+ripple::uint256 const kOTHER_BOOK{"BEEFBEEFBEEFBEEFBEEFBEEFBEEFBEEFBEEFBEEFBEEFBEEF0000000000000000"};
+constexpr auto kQUALITY1 = "CAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFE0000000000000001";
+constexpr auto kQUALITY2 = "CAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFECAFE0000000000000002";
+
+ripple::uint256 const kOFFER1{"1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC"};
+ripple::uint256 const kOFFER2{"2B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC"};
+ripple::uint256 const kOFFER3{"3B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC"};
+ripple::uint256 const kOFFER4{"4B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC"};
+
+constexpr uint32_t kSEQ = 30;
+
+Blob
+createOffer(int takerGets, std::string_view quality)
+{
+    return createOfferLedgerObject(kACCOUNT2, takerGets, 20, "USD", "EUR", kACCOUNT, kACCOUNT, quality)
+        .getSerializer()
+        .peekData();
+}
+
+Blob
+createBookDirPage(std::vector<ripple::uint256> offers, std::string_view quality, std::uint64_t next = 0)
+{
+    auto dir = createOwnerDirLedgerObject(std::move(offers), quality);
+    if (next != 0u)
+        dir.setFieldU64(ripple::sfIndexNext, next);
+    return dir.getSerializer().peekData();
+}
+
+}  // namespace
+
+struct OrderBookIndexTest : ::testing::Test {
+    OrderBookIndex index;
+    std::map<ripple::uint256, Blob> objects;
+
+    ripple::uint256 const quality1{kQUALITY1};
+    ripple::uint256 const quality2{kQUALITY2};
+    ripple::uint256 const quality2Page1 = ripple::keylet::page(quality2, 1).key;
+
+    OrderBookIndexTest()
+    {
+        objects[quality1] = createBookDirPage({kOFFER1, kOFFER2}, kQUALITY1);
+        objects[quality2] = createBookDirPage({kOFFER3}, kQUALITY2, 1);
+        objects[quality2Page1] = createBookDirPage({kOFFER4}, kQUALITY2);
+        objects[kOFFER1] = createOffer(10, kQUALITY1);
+        objects[kOFFER2] = createOffer(11, kQUALITY1);
+        objects[kOFFER3] = createOffer(12, kQUALITY2);
+        objects[kOFFER4] = createOffer(13, kQUALITY2);
+    }
+
+    Blob const*
+    lookup(ripple::uint256 const& key) const
+    {
+        auto const it = objects.find(key);
+        return it != objects.end() ? &it->second : nullptr;
+    }
+
+    void
+    rebuild(uint32_t seq)
+    {
+        std::vector<ripple::uint256> keys;
+        for (auto const& [key, _] : objects)
+            keys.push_back(key);
+        index.rebuild(keys, seq, [this](auto const& key) { return lookup(key); });
+    }
+
+    void
+    update(std::vector<ripple::uint256> const& keys, uint32_t seq)
+    {
+        index.update(keys, seq, [this](auto const& key) { return lookup(key); });
+    }
+
+    std::vector<ripple::uint256>
+    offerKeys(uint32_t seq, uint32_t limit = 10) const
+    {
+        auto const offers = index.getOffers(kBOOK, seq, limit);
+        EXPECT_TRUE(offers.has_value());
+
+        std::vector<ripple::uint256> keys;
+        for (auto const& offer : offers.value_or(std::vector<BookOfferPtr>{}))
+            keys.push_back(offer->key);
+        return keys;
+    }
+};
+
+TEST_F(OrderBookIndexTest, NotServedBeforeBuilt)
+{
+    update({kOFFER1}, kSEQ);
+
+    EXPECT_FALSE(index.isReady());
+    EXPECT_FALSE(index.getOffers(kBOOK, kSEQ, 10).has_value());
+    EXPECT_EQ(index.numOffers(), 0u);
+}
+
+TEST_F(OrderBookIndexTest, OffersOrderedByQualityAndDirectoryPage)
+{
+    rebuild(kSEQ);
+
+    EXPECT_TRUE(index.isReady());
+    EXPECT_EQ(index.numOffers(), 4u);
+    EXPECT_EQ(offerKeys(kSEQ), (std::vector{kOFFER1, kOFFER2, kOFFER3, kOFFER4}));
+    EXPECT_EQ(offerKeys(kSEQ, 3), (std::vector{kOFFER1, kOFFER2, kOFFER3}));
+
+    auto const offers = index.getOffers(kBOOK, kSEQ, 1);
+    ASSERT_TRUE(offers.has_value());
+    ASSERT_EQ(offers->size(), 1u);
+    EXPECT_EQ(offers->front()->bookDirectory, quality1);
+    EXPECT_EQ(offers->front()->owner, getAccountIdWithString(kACCOUNT2));
+    EXPECT_EQ(offers->front()->takerGets, ripple::STAmount(getIssue("USD", kACCOUNT), 10));
+
+    auto const other = index.getOffers(kOTHER_BOOK, kSEQ, 10);
+    ASSERT_TRUE(other.has_value());
+    EXPECT_TRUE(other->empty());
+}
+
+TEST_F(OrderBookIndexTest, OnlyLatestSequenceIsServed)
+{
+    rebuild(kSEQ);
+    EXPECT_FALSE(index.getOffers(kBOOK, kSEQ - 1, 10).has_value());
+    EXPECT_FALSE(index.getOffers(kBOOK, kSEQ + 1, 10).has_value());
+
+    update({}, kSEQ + 1);
+    EXPECT_FALSE(index.getOffers(kBOOK, kSEQ, 10).has_value());
+    EXPECT_TRUE(index.getOffers(kBOOK, kSEQ + 1, 10).has_value());
+}
+
+TEST_F(OrderBookIndexTest, UpdateAppliesCreatedModifiedAndDeletedOffers)
+{
+    rebuild(kSEQ);
+
+    // first offer consumed, second partially filled
+    objects.erase(kOFFER1);
+    objects[quality1] = createBookDirPage({kOFFER2}, kQUALITY1);
+    objects[kOFFER2] = createOffer(5, kQUALITY1);
+    update({kOFFER1, kOFFER2, quality1}, kSEQ + 1);
+
+    EXPECT_EQ(offerKeys(kSEQ + 1), (std::vector{kOFFER2, kOFFER3, kOFFER4}));
+    auto const offers = index.getOffers(kBOOK, kSEQ + 1, 1);
+    ASSERT_TRUE(offers.has_value());
+    EXPECT_EQ(offers->front()->takerGets, ripple::STAmount(getIssue("USD", kACCOUNT), 5));
+
+    // a new offer at the end of the second page
+    objects[kOFFER1] = createOffer(10, kQUALITY2);
+    objects[quality2Page1] = createBookDirPage({kOFFER4, kOFFER1}, kQUALITY2);
+    update({kOFFER1, quality2Page1}, kSEQ + 2);
+
+    EXPECT_EQ(offerKeys(kSEQ + 2), (std::vector{kOFFER2, kOFFER3, kOFFER4, kOFFER1}));
+    EXPECT_EQ(index.numOffers(), 4u);
+}
+
+TEST_F(OrderBookIndexTest, DeletedQualityIsRemoved)
+{
+    rebuild(kSEQ);
+
+    objects.erase(kOFFER3);
+    objects.erase(kOFFER4);
+    objects.erase(quality2);
+    objects.erase(quality2Page1);
+    update({kOFFER3, kOFFER4, quality2, quality2Page1}, kSEQ + 1);
+
+    EXPECT_EQ(offerKeys(kSEQ + 1), (std::vector{kOFFER1, kOFFER2}));
+    EXPECT_EQ(index.numOffers(), 2u);
+}
+
+TEST_F(OrderBookIndexTest, ClearStopsServing)
+{
+    rebuild(kSEQ);
+    index.clear();
+
+    EXPECT_FALSE(index.isReady());
+    EXPECT_FALSE(index.getOffers(kBOOK, kSEQ, 10).has_value());
+    EXPECT_EQ(index.numOffers(), 0u);
+}
+
+TEST_F(OrderBookIndexTest, MissedLedgerDropsIndex)
+{
+    rebuild(kSEQ);
+    update({}, kSEQ + 2);
+
+    EXPECT_FALSE(index.isReady());
+    EXPECT_FALSE(index.getOffers(kBOOK, kSEQ + 2, 10).has_value());
+    EXPECT_EQ(index.numOffers(), 0u);
+}
@@ -38,6 +38,7 @@
 #include <optional>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 #include <vector>
 
 using namespace data::cassandra;
@@ -61,6 +62,7 @@ protected:
         MOCK_METHOD(void, registerWriteStarted, (), ());
         MOCK_METHOD(void, registerWriteFinished, (std::chrono::steady_clock::time_point), ());
         MOCK_METHOD(void, registerWriteRetry, (), ());
+        MOCK_METHOD(void, registerWriteBatch, (std::uint64_t), ());
 
         void
         registerReadStarted(std::uint64_t count = 1)
@@ -89,6 +91,10 @@ protected:
             registerReadErrorImpl(count);
         }
         MOCK_METHOD(void, registerReadErrorImpl, (std::uint64_t), ());
+        MOCK_METHOD(void, registerReadHedgeFired, (), ());
+        MOCK_METHOD(void, registerReadHedgeWon, (), ());
+        MOCK_METHOD(std::chrono::microseconds, readLatency, (), ());
+        MOCK_METHOD(std::chrono::microseconds, readTailLatency, (), ());
         MOCK_METHOD(boost::json::object, report, (), ());
     };
 
@@ -176,6 +182,54 @@ TEST_F(BackendCassandraExecutionStrategyTest, ReadOneInCoroutineThrowsOnInvalidQ
     });
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, ReadOneInCoroutineHedgedWhenSlow)
+{
+    auto strat = makeStrategy(Settings{.hedgeReads = true});
+    std::function<void(FakeResultOrError)> slowCallback;
+
+    EXPECT_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillOnce([&slowCallback](auto const&, auto&& cb) {
+            slowCallback = std::move(cb);  // the first attempt does not answer in time
+            return FakeFutureWithCallback{};
+        })
+        .WillOnce([](auto const&, auto&& cb) {
+            cb({});
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(*counters_, readTailLatency()).WillOnce(Return(std::chrono::milliseconds{1}));
+    EXPECT_CALL(*counters_, registerReadStartedImpl(1));
+    EXPECT_CALL(*counters_, registerReadHedgeFired());
+    EXPECT_CALL(*counters_, registerReadHedgeWon());
+    EXPECT_CALL(*counters_, registerReadFinishedImpl(testing::_, 1));
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        auto statement = FakeStatement{};
+        EXPECT_TRUE(strat.read(yield, statement));
+    });
+
+    // a late answer of the first attempt is ignored
+    slowCallback(FakeResultOrError{CassandraError{"timeout", CASS_ERROR_LIB_REQUEST_TIMED_OUT}});
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadOneInCoroutineNotHedgedWhenAnsweredInTime)
+{
+    auto strat = makeStrategy(Settings{.hedgeReads = true});
+
+    EXPECT_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillOnce([](auto const&, auto&& cb) {
+            cb({});
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(*counters_, readTailLatency()).WillOnce(Return(std::chrono::seconds{1}));
+    EXPECT_CALL(*counters_, registerReadStartedImpl(1));
+    EXPECT_CALL(*counters_, registerReadFinishedImpl(testing::_, 1));
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        auto statement = FakeStatement{};
+        EXPECT_TRUE(strat.read(yield, statement));
+    });
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, ReadBatchInCoroutineSuccessful)
 {
     auto strat = makeStrategy();
@@ -343,6 +397,98 @@ TEST_F(BackendCassandraExecutionStrategyTest, ReadEachInCoroutineThrowsOnFailure
     });
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, ReadEachPageInCoroutineVisitsAllPages)
+{
+    static constexpr auto kNUM_PAGES = 3u;
+    auto strat = makeStrategy(Settings{.readPageSize = 10});
+
+    ON_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([](auto const& statement, auto&& cb) {
+            EXPECT_EQ(statement.pageSize, 10u);
+            cb(FakeResultOrError{.result = FakeResult{.morePages = statement.page + 1 < kNUM_PAGES}});
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .Times(kNUM_PAGES);
+    EXPECT_CALL(*counters_, registerReadStartedImpl(1)).Times(kNUM_PAGES);
+    EXPECT_CALL(*counters_, registerReadFinishedImpl(testing::_, 1)).Times(kNUM_PAGES);
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        auto numPages = 0u;
+        strat.readEachPage(yield, FakeStatement{}, [&numPages](FakeResult const&) { ++numPages; });
+        EXPECT_EQ(numPages, kNUM_PAGES);
+    });
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadEachPageInCoroutineRetriesFailedPage)
+{
+    auto strat = makeStrategy();
+    auto callCount = std::atomic_int{0};
+
+    ON_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&callCount](auto const&, auto&& cb) {
+            if (callCount++ == 0) {
+                cb({CassandraError{"invalid data", CASS_ERROR_LIB_INVALID_DATA}});
+            } else {
+                cb({});  // pretend we got the only page
+            }
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .Times(2);
+    EXPECT_CALL(*counters_, registerReadStartedImpl(1)).Times(2);
+    EXPECT_CALL(*counters_, registerReadRetryImpl(1));
+    EXPECT_CALL(*counters_, registerReadFinishedImpl(testing::_, 1));
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        auto numPages = 0u;
+        strat.readEachPage(yield, FakeStatement{}, [&numPages](FakeResult const&) { ++numPages; });
+        EXPECT_EQ(numPages, 1u);
+    });
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadEachPageInCoroutineThrowsOnTimeoutFailure)
+{
+    auto strat = makeStrategy();
+
+    ON_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([](auto const&, auto&& cb) {
+            cb({CassandraError{"timeout", CASS_ERROR_LIB_REQUEST_TIMED_OUT}});
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .Times(1);
+    EXPECT_CALL(*counters_, registerReadStartedImpl(1));
+    EXPECT_CALL(*counters_, registerReadErrorImpl(1));
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        EXPECT_THROW(strat.readEachPage(yield, FakeStatement{}, [](FakeResult const&) {}), data::DatabaseTimeout);
+    });
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadEachPageInCoroutineWaitsForPrefetchedPageWhenCallbackThrows)
+{
+    auto strat = makeStrategy(Settings{.maxReadRequestsOutstanding = 1});
+
+    ON_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([](auto const&, auto&& cb) {
+            cb(FakeResultOrError{.result = FakeResult{.morePages = true}});
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .Times(2);  // the first page and the prefetched second one
+    EXPECT_CALL(*counters_, registerReadStartedImpl(1)).Times(2);
+    EXPECT_CALL(*counters_, registerReadFinishedImpl(testing::_, 1));
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        EXPECT_THROW(
+            strat.readEachPage(yield, FakeStatement{}, [](FakeResult const&) { throw std::runtime_error{"stop"}; }),
+            std::runtime_error
+        );
+        EXPECT_FALSE(strat.isTooBusy());
+    });
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, WriteSyncFirstTrySuccessful)
 {
     auto strat = makeStrategy();
@@ -415,6 +561,35 @@ TEST_F(BackendCassandraExecutionStrategyTest, WriteMultipleAndCallSyncSucceeds)
     thread.join();
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, WritePartitionedBatchesStatementsOfSamePartition)
+{
+    auto strat = makeStrategy(Settings{.writeBatchSize = 2});
+
+    EXPECT_CALL(
+        handle_,
+        asyncExecute(A<UnloggedBatch<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>())
+    )
+        .WillOnce([](auto const& batch, auto&& cb) {
+            EXPECT_EQ(batch.statements.size(), 2u);
+            cb({});
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle_, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .Times(2)
+        .WillRepeatedly([](auto const&, auto&& cb) {
+            cb({});
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(*counters_, registerWriteBatch(2u));
+    EXPECT_CALL(*counters_, registerWriteBatch(1u)).Times(2);
+    EXPECT_CALL(*counters_, registerWriteStarted()).Times(3);
+    EXPECT_CALL(*counters_, registerWriteFinished(testing::_)).Times(3);
+
+    // partition 1 gets a batch of two and a single write for the remainder, partition 2 gets a single write
+    strat.writePartitioned(std::vector<std::pair<std::uint32_t, FakeStatement>>{{1, {}}, {2, {}}, {1, {}}, {1, {}}});
+    strat.sync();
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, StatsCallsCountersReport)
 {
     auto strat = makeStrategy();
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/RequestCredits.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace data::cassandra::impl;
+
+struct BackendCassandraRequestCreditsTest : ::testing::Test {
+    static constexpr auto kMAX = 3u;
+    RequestCredits credits{kMAX};
+};
+
+TEST_F(BackendCassandraRequestCreditsTest, TryAcquireUpToMax)
+{
+    for (auto i = 0u; i < kMAX; ++i)
+        EXPECT_TRUE(credits.tryAcquire());
+
+    EXPECT_FALSE(credits.tryAcquire());
+    EXPECT_TRUE(credits.exhausted());
+    EXPECT_EQ(credits.outstanding(), kMAX);
+
+    credits.release();
+    EXPECT_FALSE(credits.exhausted());
+    EXPECT_TRUE(credits.tryAcquire());
+}
+
+TEST_F(BackendCassandraRequestCreditsTest, AddIgnoresMax)
+{
+    credits.add(kMAX + 2);
+    EXPECT_EQ(credits.outstanding(), kMAX + 2);
+    EXPECT_TRUE(credits.exhausted());
+    EXPECT_FALSE(credits.tryAcquire());
+
+    credits.release(kMAX + 2);
+    EXPECT_EQ(credits.outstanding(), 0u);
+}
+
+TEST_F(BackendCassandraRequestCreditsTest, AcquireBlocksUntilReleased)
+{
+    credits.add(kMAX);
+
+    std::atomic_bool acquired = false;
+    std::thread waiter{[&] {
+        credits.acquire();
+        acquired = true;
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_FALSE(acquired);
+
+    credits.release();
+    waiter.join();
+
+    EXPECT_TRUE(acquired);
+    EXPECT_EQ(credits.outstanding(), kMAX);
+}
+
+TEST_F(BackendCassandraRequestCreditsTest, WaitUntilIdleReturnsWhenAllReleased)
+{
+    credits.add(2);
+
+    std::atomic_bool idle = false;
+    std::thread waiter{[&] {
+        credits.waitUntilIdle();
+        idle = true;
+    }};
+
+    credits.release();
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_FALSE(idle);
+
+    credits.release();
+    waiter.join();
+
+    EXPECT_TRUE(idle);
+}
+
+TEST_F(BackendCassandraRequestCreditsTest, ManyThreadsNeverExceedMax)
+{
+    static constexpr auto kTHREADS = 8;
+    static constexpr auto kITERATIONS = 1000;
+
+    std::atomic_uint32_t peak = 0;
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < kTHREADS; ++i) {
+        threads.emplace_back([&] {
+            for (auto j = 0; j < kITERATIONS; ++j) {
+                credits.acquire();
+                auto const current = credits.outstanding();
+                auto seen = peak.load();
+                while (seen < current and not peak.compare_exchange_weak(seen, current)) {
+                }
+                credits.release();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_LE(peak, kMAX);
+    EXPECT_EQ(credits.outstanding(), 0u);
+}
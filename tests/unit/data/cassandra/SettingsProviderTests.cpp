@@ -30,6 +30,7 @@
 
 #include <boost/json/parse.hpp>
 #include <boost/json/value.hpp>
+#include <cassandra.h>
 #include <fmt/core.h>
 #include <gtest/gtest.h>
 
@@ -61,6 +62,13 @@ getParseSettingsConfig(boost::json::value val)
         {"database.cassandra.password", ConfigValue{ConfigType::String}.optional()},
         {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional()},
         {"database.cassandra.write_batch_size", ConfigValue{ConfigType::Integer}.defaultValue(20)},
+        {"database.cassandra.read_page_size", ConfigValue{ConfigType::Integer}.defaultValue(5000)},
+        {"database.cassandra.immutable_read_consistency", ConfigValue{ConfigType::String}.defaultValue("quorum")},
+        {"database.cassandra.speculative_execution_delay", ConfigValue{ConfigType::Integer}.optional()},
+        {"database.cassandra.max_speculative_executions", ConfigValue{ConfigType::Integer}.defaultValue(1)},
+        {"database.cassandra.hedge_reads", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"database.cassandra.account_tx_cache.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"database.cassandra.account_tx_cache.max_bytes", ConfigValue{ConfigType::Integer}.defaultValue(1024 * 1024)},
         {"database.cassandra.connect_timeout", ConfigValue{ConfigType::Integer}.optional()},
         {"database.cassandra.certfile", ConfigValue{ConfigType::String}.optional()},
         {"database.cassandra.request_timeout", ConfigValue{ConfigType::Integer}.defaultValue(0)},
@@ -93,6 +101,11 @@ TEST_F(SettingsProviderTest, Defaults)
     EXPECT_EQ(settings.maxWriteRequestsOutstanding, 10'000);
     EXPECT_EQ(settings.maxReadRequestsOutstanding, 100'000);
     EXPECT_EQ(settings.coreConnectionsPerHost, 1);
+    EXPECT_EQ(settings.readPageSize, 5000);
+    EXPECT_EQ(settings.immutableReadConsistency, CASS_CONSISTENCY_QUORUM);
+    EXPECT_EQ(settings.speculativeExecutionDelay, std::nullopt);
+    EXPECT_FALSE(settings.hedgeReads);
+    EXPECT_EQ(settings.accountTxCacheMaxBytes, std::nullopt);
     EXPECT_EQ(settings.certificate, std::nullopt);
     EXPECT_EQ(settings.username, std::nullopt);
     EXPECT_EQ(settings.password, std::nullopt);
@@ -145,6 +158,37 @@ TEST_F(SettingsProviderTest, DriverOptionalOptionsSpecified)
     EXPECT_EQ(settings.queueSizeIO, 2);
 }
 
+TEST_F(SettingsProviderTest, ReadPoliciesSpecified)
+{
+    auto const cfg = getParseSettingsConfig(json::parse(R"({
+        "database.cassandra.contact_points": "123.123.123.123",
+        "database.cassandra.immutable_read_consistency": "local_one",
+        "database.cassandra.speculative_execution_delay": 20,
+        "database.cassandra.max_speculative_executions": 2,
+        "database.cassandra.hedge_reads": true
+    })"));
+    SettingsProvider const provider{cfg.getObject("database.cassandra")};
+
+    auto const settings = provider.getSettings();
+    EXPECT_EQ(settings.immutableReadConsistency, CASS_CONSISTENCY_LOCAL_ONE);
+    EXPECT_EQ(settings.speculativeExecutionDelay, std::chrono::milliseconds{20});
+    EXPECT_EQ(settings.maxSpeculativeExecutions, 2);
+    EXPECT_TRUE(settings.hedgeReads);
+}
+
+TEST_F(SettingsProviderTest, AccountTxCacheSpecified)
+{
+    auto const cfg = getParseSettingsConfig(json::parse(R"({
+        "database.cassandra.contact_points": "123.123.123.123",
+        "database.cassandra.account_tx_cache.enabled": true,
+        "database.cassandra.account_tx_cache.max_bytes": 4096
+    })"));
+    SettingsProvider const provider{cfg.getObject("database.cassandra")};
+
+    auto const settings = provider.getSettings();
+    EXPECT_EQ(settings.accountTxCacheMaxBytes, 4096u);
+}
+
 TEST_F(SettingsProviderTest, SecureBundleConfig)
 {
     auto const cfg =
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/PagedOrderedMap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace data::impl;
+
+namespace {
+constexpr std::size_t kSMALL_PAGE = 4;
+}  // namespace
+
+TEST(PagedOrderedMapTests, EmptyMap)
+{
+    PagedOrderedMap<int, int, kSMALL_PAGE> const map;
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.size(), 0u);
+    EXPECT_EQ(map.find(1), nullptr);
+    EXPECT_EQ(map.upperBound(1), nullptr);
+    EXPECT_EQ(map.lowerNeighbour(1), nullptr);
+    EXPECT_EQ(map.first(), nullptr);
+    EXPECT_EQ(map.last(), nullptr);
+}
+
+TEST(PagedOrderedMapTests, InsertFindAndOverwrite)
+{
+    PagedOrderedMap<int, int, kSMALL_PAGE> map;
+    for (auto i = 20; i > 0; --i)
+        map[i * 2] = i;
+
+    EXPECT_EQ(map.size(), 20u);
+    for (auto i = 1; i <= 20; ++i) {
+        ASSERT_NE(map.find(i * 2), nullptr);
+        EXPECT_EQ(*map.find(i * 2), i);
+        EXPECT_EQ(map.find((i * 2) + 1), nullptr);
+    }
+
+    map[10] = 100;
+    EXPECT_EQ(map.size(), 20u);
+    EXPECT_EQ(*map.find(10), 100);
+
+    EXPECT_EQ(map.first()->first, 2);
+    EXPECT_EQ(map.last()->first, 40);
+}
+
+TEST(PagedOrderedMapTests, NeighboursAcrossPages)
+{
+    PagedOrderedMap<int, int, kSMALL_PAGE> map;
+    for (auto i = 1; i <= 20; ++i)
+        map[i * 10] = i;
+
+    for (auto i = 1; i < 20; ++i) {
+        EXPECT_EQ(map.upperBound(i * 10)->first, (i + 1) * 10);
+        EXPECT_EQ(map.upperBound((i * 10) + 5)->first, (i + 1) * 10);
+        EXPECT_EQ(map.lowerNeighbour((i + 1) * 10)->first, i * 10);
+        EXPECT_EQ(map.lowerNeighbour((i * 10) + 5)->first, i * 10);
+    }
+
+    EXPECT_EQ(map.upperBound(0)->first, 10);
+    EXPECT_EQ(map.upperBound(200), nullptr);
+    EXPECT_EQ(map.lowerNeighbour(10), nullptr);
+    EXPECT_EQ(map.lowerNeighbour(1000)->first, 200);
+}
+
+TEST(PagedOrderedMapTests, Erase)
+{
+    PagedOrderedMap<int, int, kSMALL_PAGE> map;
+    for (auto i = 0; i < 10; ++i)
+        map[i] = i;
+
+    EXPECT_FALSE(map.erase(42));
+    for (auto i = 0; i < 10; i += 2)
+        EXPECT_TRUE(map.erase(i));
+
+    EXPECT_EQ(map.size(), 5u);
+    EXPECT_EQ(map.find(4), nullptr);
+    EXPECT_EQ(map.upperBound(3)->first, 5);
+    EXPECT_EQ(map.lowerNeighbour(5)->first, 3);
+
+    for (auto i = 1; i < 10; i += 2)
+        EXPECT_TRUE(map.erase(i));
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.first(), nullptr);
+}
+
+TEST(PagedOrderedMapTests, ForEachVisitsEntriesInOrder)
+{
+    PagedOrderedMap<int, int, kSMALL_PAGE> map;
+    for (auto i = 10; i > 0; --i)
+        map[i] = i * 2;
+
+    std::vector<int> keys;
+    map.forEach([&](int key, int value) {
+        EXPECT_EQ(value, key * 2);
+        keys.push_back(key);
+    });
+
+    EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+TEST(PagedOrderedMapTests, BehavesLikeStdMap)
+{
+    PagedOrderedMap<int, int, kSMALL_PAGE> map;
+    std::map<int, int> reference;
+    std::mt19937 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<int> keys{0, 300};
+
+    for (auto i = 0; i < 20'000; ++i) {
+        auto const key = keys(gen);
+        switch (i % 3) {
+            case 0:
+                map[key] = i;
+                reference[key] = i;
+                break;
+            case 1:
+                EXPECT_EQ(map.erase(key), reference.erase(key) == 1);
+                break;
+            default: {
+                auto const* upper = map.upperBound(key);
+                auto const expectedUpper = reference.upper_bound(key);
+                ASSERT_EQ(upper == nullptr, expectedUpper == reference.end());
+                if (upper != nullptr) {
+                    EXPECT_EQ(upper->first, expectedUpper->first);
+                    EXPECT_EQ(upper->second, expectedUpper->second);
+                }
+                break;
+            }
+        }
+        ASSERT_EQ(map.size(), reference.size());
+    }
+}
@@ -42,7 +42,9 @@ generateDefaultCacheConfig()
          {"cache.num_cursors_from_diff", ConfigValue{ConfigType::Integer}.defaultValue(0)},
          {"cache.num_cursors_from_account", ConfigValue{ConfigType::Integer}.defaultValue(0)},
          {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512)},
-         {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async")}}
+         {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async")},
+         {"cache.num_retained_ledgers", ConfigValue{ConfigType::Integer}.defaultValue(0)},
+         {"cache.order_book_index", ConfigValue{ConfigType::Boolean}.defaultValue(false)}}
     };
 }
 
@@ -134,3 +136,19 @@ TEST_F(CacheLoaderSettingsTest, NoLoadStyleCorrectlyPropagatedThroughConfig)
         EXPECT_TRUE(settings.isDisabled());
     }
 }
+
+TEST_F(CacheLoaderSettingsTest, NumRetainedLedgersCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = getParseCacheConfig(json::parse(R"({"cache": {"num_retained_ledgers": 10}})"));
+    auto const settings = makeCacheLoaderSettings(cfg);
+
+    EXPECT_EQ(settings.numRetainedLedgers, 10);
+}
+
+TEST_F(CacheLoaderSettingsTest, OrderBookIndexCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = getParseCacheConfig(json::parse(R"({"cache": {"order_book_index": true}})"));
+    auto const settings = makeCacheLoaderSettings(cfg);
+
+    EXPECT_TRUE(settings.orderBookIndex);
+}
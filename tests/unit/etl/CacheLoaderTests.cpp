@@ -57,7 +57,9 @@ generateDefaultCacheConfig()
          {"cache.num_cursors_from_diff", ConfigValue{ConfigType::Integer}.defaultValue(0)},
          {"cache.num_cursors_from_account", ConfigValue{ConfigType::Integer}.defaultValue(0)},
          {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512)},
-         {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async")}}
+         {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async")},
+         {"cache.num_retained_ledgers", ConfigValue{ConfigType::Integer}.defaultValue(0)},
+         {"cache.order_book_index", ConfigValue{ConfigType::Boolean}.defaultValue(false)}}
     };
 }
 
@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/ExtractionController.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace etl::impl;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto kMAX_CONCURRENCY = 4u;
+constexpr auto kCAPACITY = 1000uz;
+
+}  // namespace
+
+struct ExtractionControllerTests : util::prometheus::WithPrometheus {
+protected:
+    ExtractionController::ClockType::time_point const start_ = ExtractionController::ClockType::now();
+    double writeLoad_ = 0.0;
+    ExtractionController controller_{
+        ExtractionController::Settings{
+            .maxConcurrency = kMAX_CONCURRENCY, .interval = 100ms, .writeLoad = [this] { return writeLoad_; }
+        },
+        start_
+    };
+
+    // extraction keeps the transformer waiting and each fetch takes the given time
+    std::uint32_t
+    starving(std::chrono::microseconds fetchLatency, std::chrono::milliseconds at)
+    {
+        return controller_.update({.queued = 0, .capacity = kCAPACITY, .fetchLatency = fetchLatency}, start_ + at);
+    }
+
+    std::uint32_t
+    lagging(std::chrono::milliseconds at)
+    {
+        return controller_.update({.queued = kCAPACITY / 2, .capacity = kCAPACITY, .fetchLatency = 10ms}, start_ + at);
+    }
+
+    static std::int64_t
+    bottleneckGauge(std::string const& stage)
+    {
+        return PrometheusService::gaugeInt("etl_extraction_bottleneck", util::prometheus::Labels({{"stage", stage}}))
+            .value();
+    }
+};
+
+TEST_F(ExtractionControllerTests, StartsAtMaxConcurrency)
+{
+    EXPECT_EQ(controller_.concurrency(), kMAX_CONCURRENCY);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::None);
+    EXPECT_EQ(PrometheusService::gaugeInt("etl_extraction_concurrency", {}).value(), kMAX_CONCURRENCY);
+}
+
+TEST_F(ExtractionControllerTests, UpdatesOncePerInterval)
+{
+    EXPECT_FALSE(controller_.shouldUpdate(start_ + 50ms));
+    EXPECT_TRUE(controller_.shouldUpdate(start_ + 100ms));
+
+    lagging(100ms);
+    EXPECT_FALSE(controller_.shouldUpdate(start_ + 150ms));
+    EXPECT_TRUE(controller_.shouldUpdate(start_ + 200ms));
+}
+
+TEST_F(ExtractionControllerTests, StepsDownWhileDatabaseIsBusy)
+{
+    writeLoad_ = 0.95;
+    EXPECT_EQ(starving(10ms, 100ms), kMAX_CONCURRENCY - 1);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::Database);
+    EXPECT_EQ(bottleneckGauge("database"), 1);
+    EXPECT_EQ(bottleneckGauge("none"), 0);
+}
+
+TEST_F(ExtractionControllerTests, StepsDownWhileTransformerLagsButNotBelowOne)
+{
+    for (auto i = 1; i <= 5; ++i)
+        lagging(i * 100ms);
+
+    EXPECT_EQ(controller_.concurrency(), 1u);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::Transformer);
+    EXPECT_EQ(PrometheusService::gaugeInt("etl_extraction_concurrency", {}).value(), 1);
+}
+
+TEST_F(ExtractionControllerTests, HoldsWhileExtractionKeepsUp)
+{
+    lagging(100ms);
+    auto const concurrency =
+        controller_.update({.queued = 5, .capacity = kCAPACITY, .fetchLatency = 10ms}, start_ + 200ms);
+
+    EXPECT_EQ(concurrency, kMAX_CONCURRENCY - 1);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::None);
+}
+
+TEST_F(ExtractionControllerTests, StepsUpWhileExtractionScales)
+{
+    lagging(100ms);
+    lagging(200ms);
+    ASSERT_EQ(controller_.concurrency(), 2u);
+
+    // 2 / 100ms = 20 ledgers per second
+    EXPECT_EQ(starving(100ms, 300ms), 3u);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::Extraction);
+
+    // 3 / 100ms = 30 ledgers per second, the step paid off
+    EXPECT_EQ(starving(100ms, 400ms), 4u);
+
+    EXPECT_EQ(starving(100ms, 500ms), kMAX_CONCURRENCY);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::Extraction);
+}
+
+TEST_F(ExtractionControllerTests, UndoesStepWhenSourcesDoNotScale)
+{
+    lagging(100ms);
+    lagging(200ms);
+    ASSERT_EQ(starving(100ms, 300ms), 3u);
+
+    // 3 / 150ms = 20 ledgers per second, same as before the step
+    EXPECT_EQ(starving(150ms, 400ms), 2u);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::Sources);
+    EXPECT_EQ(bottleneckGauge("sources"), 1);
+    EXPECT_EQ(bottleneckGauge("extraction"), 0);
+
+    EXPECT_EQ(starving(100ms, 500ms), 2u);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::Sources);
+
+    EXPECT_EQ(starving(100ms, 1500ms), 3u);
+    EXPECT_EQ(controller_.bottleneck(), ExtractionController::Bottleneck::Extraction);
+}
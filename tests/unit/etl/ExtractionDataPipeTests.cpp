@@ -17,8 +17,10 @@
 */
 //==============================================================================
 
+#include "etl/impl/ExtractionController.hpp"
 #include "etl/impl/ExtractionDataPipe.hpp"
 #include "util/LoggerFixtures.hpp"
+#include "util/MockPrometheus.hpp"
 
 #include <gtest/gtest.h>
 
@@ -26,7 +28,9 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace {
 
@@ -85,3 +89,79 @@ TEST_F(ETLExtractionDataPipeTest, CallingCleanupUnblocksOtherThread)
     bgThread.join();
     EXPECT_TRUE(unblocked);
 }
+
+TEST_F(ETLExtractionDataPipeTest, SizeCountsQueuedData)
+{
+    for (std::size_t i = 0; i < 6; ++i)
+        pipe_.push(kSTART_SEQ + i, kSTART_SEQ + i);
+
+    EXPECT_EQ(pipe_.size(), 6);
+    [[maybe_unused]] auto const data = pipe_.popNext(kSTART_SEQ);
+    EXPECT_EQ(pipe_.size(), 5);
+}
+
+TEST_F(ETLExtractionDataPipeTest, FetchSlotsAreUnlimitedWithoutController)
+{
+    for (std::size_t i = 0; i < 8; ++i)
+        pipe_.waitForFetchSlot(kSTART_SEQ + i);
+}
+
+class ETLExtractionDataPipeAdaptiveTest : public util::prometheus::WithPrometheus, public NoLoggerFixture {
+protected:
+    // the interval is long enough for the concurrency to stay at the stride
+    etl::impl::ExtractionDataPipe<uint32_t> pipe_{
+        2, kSTART_SEQ, etl::impl::ExtractionController::Settings{.maxConcurrency = 0, .interval = std::chrono::hours{1}}
+    };
+};
+
+TEST_F(ETLExtractionDataPipeAdaptiveTest, LowestWaitingSequenceGetsFreedSlotFirst)
+{
+    pipe_.waitForFetchSlot(kSTART_SEQ);
+    pipe_.waitForFetchSlot(kSTART_SEQ + 1);
+
+    std::mutex mutex;
+    std::vector<uint32_t> admitted;
+    auto const fetch = [&](uint32_t sequence) {
+        pipe_.waitForFetchSlot(sequence);
+        std::scoped_lock const lock{mutex};
+        admitted.push_back(sequence);
+    };
+
+    auto later = std::thread(fetch, kSTART_SEQ + 3);
+    auto sooner = std::thread(fetch, kSTART_SEQ + 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    {
+        std::scoped_lock const lock{mutex};
+        EXPECT_TRUE(admitted.empty());
+    }
+
+    pipe_.releaseFetchSlot(std::chrono::milliseconds{1});
+    sooner.join();
+    {
+        std::scoped_lock const lock{mutex};
+        EXPECT_EQ(admitted, std::vector<uint32_t>{kSTART_SEQ + 2});
+    }
+
+    pipe_.releaseFetchSlot(std::chrono::milliseconds{1});
+    later.join();
+    EXPECT_EQ(admitted, (std::vector<uint32_t>{kSTART_SEQ + 2, kSTART_SEQ + 3}));
+}
+
+TEST_F(ETLExtractionDataPipeAdaptiveTest, CallingCleanupUnblocksFetchSlotWaiters)
+{
+    pipe_.waitForFetchSlot(kSTART_SEQ);
+    pipe_.waitForFetchSlot(kSTART_SEQ + 1);
+
+    std::atomic_bool unblocked = false;
+    auto bgThread = std::thread([this, &unblocked] {
+        pipe_.waitForFetchSlot(kSTART_SEQ + 2);
+        unblocked = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_FALSE(unblocked);
+    pipe_.cleanup();
+
+    bgThread.join();
+    EXPECT_TRUE(unblocked);
+}
@@ -60,7 +60,9 @@ TEST_F(ETLExtractorTest, StopsWhenCurrentSequenceExceedsFinishSequence)
     EXPECT_CALL(dataPipe_, getStride).Times(3).WillRepeatedly(Return(4));
 
     auto response = FakeFetchResponse{};
+    EXPECT_CALL(dataPipe_, waitForFetchSlot).Times(3);
     EXPECT_CALL(ledgerFetcher_, fetchDataAndDiff).Times(3).WillRepeatedly(Return(response));
+    EXPECT_CALL(dataPipe_, releaseFetchSlot).Times(3);
     EXPECT_CALL(dataPipe_, push).Times(3);
     EXPECT_CALL(dataPipe_, finish(0)).Times(1);
 
@@ -91,7 +93,9 @@ TEST_F(ETLExtractorTest, StopsIfFetchIsUnsuccessful)
 {
     EXPECT_CALL(*networkValidatedLedgers_, waitUntilValidatedByNetwork).WillOnce(Return(true));
 
+    EXPECT_CALL(dataPipe_, waitForFetchSlot(0));
     EXPECT_CALL(ledgerFetcher_, fetchDataAndDiff).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(dataPipe_, releaseFetchSlot);
     EXPECT_CALL(dataPipe_, finish(0));
 
     // we break immediately because fetchDataAndDiff returns nullopt
@@ -115,7 +119,9 @@ TEST_F(ETLExtractorTest, SendsCorrectResponseToDataPipe)
 
     auto response = FakeFetchResponse{1234};
 
+    EXPECT_CALL(dataPipe_, waitForFetchSlot(0));
     EXPECT_CALL(ledgerFetcher_, fetchDataAndDiff).WillOnce(Return(response));
+    EXPECT_CALL(dataPipe_, releaseFetchSlot);
     EXPECT_CALL(dataPipe_, push(_, std::optional{response}));
     EXPECT_CALL(dataPipe_, finish(0));
 
@@ -124,6 +130,25 @@ TEST_F(ETLExtractorTest, SendsCorrectResponseToDataPipe)
     extractor.waitTillFinished();  // this is what clio does too. waiting for the thread to join
 }
 
+TEST_F(ETLExtractorTest, FetchesWhileHoldingFetchSlot)
+{
+    EXPECT_CALL(*networkValidatedLedgers_, waitUntilValidatedByNetwork).WillOnce(Return(true));
+    EXPECT_CALL(dataPipe_, getStride).WillOnce(Return(4));
+
+    auto response = FakeFetchResponse{1234};
+    {
+        InSequence const seq;
+        EXPECT_CALL(dataPipe_, waitForFetchSlot(0));
+        EXPECT_CALL(ledgerFetcher_, fetchDataAndDiff(0)).WillOnce(Return(response));
+        EXPECT_CALL(dataPipe_, releaseFetchSlot);
+        EXPECT_CALL(dataPipe_, push(0, std::optional{response}));
+        EXPECT_CALL(dataPipe_, finish(0));
+    }
+
+    ExtractorType extractor{dataPipe_, networkValidatedLedgers_, ledgerFetcher_, 0, 1, state_};
+    extractor.waitTillFinished();
+}
+
 TEST_F(ETLExtractorTest, CallsPipeFinishWithInitialSequenceAtExit)
 {
     EXPECT_CALL(dataPipe_, finish(123));
@@ -158,7 +158,7 @@ TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderInRange)
     EXPECT_CALL(*mockSubscriptionManagerPtr, pubLedger(_, _, fmt::format("{}-{}", kSEQ - 1, kSEQ), 1));
     EXPECT_CALL(*mockSubscriptionManagerPtr, pubBookChanges);
     // mock 1 transaction
-    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction);
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransactions);
 
     ctx_.run();
     // last publish time should be set
@@ -200,7 +200,7 @@ TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderCloseTimeGreaterThanNow)
     EXPECT_CALL(*mockSubscriptionManagerPtr, pubLedger(_, _, fmt::format("{}-{}", kSEQ - 1, kSEQ), 1));
     EXPECT_CALL(*mockSubscriptionManagerPtr, pubBookChanges);
     // mock 1 transaction
-    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction);
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransactions);
 
     ctx_.run();
     // last publish time should be set
@@ -285,10 +285,8 @@ TEST_F(ETLLedgerPublisherTest, PublishMultipleTxInOrder)
 
     EXPECT_CALL(*mockSubscriptionManagerPtr, pubLedger(_, _, fmt::format("{}-{}", kSEQ - 1, kSEQ), 2));
     EXPECT_CALL(*mockSubscriptionManagerPtr, pubBookChanges);
-    // should call pubTransaction t2 first (greater tx index)
-    Sequence const s;
-    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction(t2, _)).InSequence(s);
-    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransaction(t1, _)).InSequence(s);
+    // should publish t2 first (greater tx index)
+    EXPECT_CALL(*mockSubscriptionManagerPtr, pubTransactions(ElementsAre(t2, t1), _));
 
     ctx_.run();
     // last publish time should be set
@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/ETLHelpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace etl;
+
+TEST(LockFreeQueueTests, PopsInPushOrder)
+{
+    LockFreeQueue<int> queue{4};
+    for (auto i = 0; i < 4; ++i)
+        queue.push(i);
+
+    EXPECT_EQ(queue.size(), 4);
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_EQ(queue.pop(), i);
+
+    EXPECT_EQ(queue.size(), 0);
+}
+
+TEST(LockFreeQueueTests, TryPushFailsWhenFull)
+{
+    LockFreeQueue<std::unique_ptr<int>> queue{2};
+    EXPECT_TRUE(queue.tryPush(std::make_unique<int>(1)));
+    EXPECT_TRUE(queue.tryPush(std::make_unique<int>(2)));
+
+    auto elt = std::make_unique<int>(3);
+    EXPECT_FALSE(queue.tryPush(std::move(elt)));
+    ASSERT_NE(elt, nullptr);  // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+
+    EXPECT_EQ(*queue.pop(), 1);
+    EXPECT_TRUE(queue.tryPush(std::move(elt)));
+    EXPECT_EQ(*queue.pop(), 2);
+    EXPECT_EQ(*queue.pop(), 3);
+}
+
+TEST(LockFreeQueueTests, TryPopOnEmptyQueue)
+{
+    LockFreeQueue<int> queue{2};
+    EXPECT_FALSE(queue.tryPop().has_value());
+
+    queue.push(42);
+    EXPECT_EQ(queue.tryPop(), 42);
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(LockFreeQueueTests, WrapsAroundManyTimes)
+{
+    LockFreeQueue<std::size_t> queue{3};
+    for (auto i = 0uz; i < 1000; ++i) {
+        queue.push(i);
+        queue.push(i + 1);
+        EXPECT_EQ(queue.pop(), i);
+        EXPECT_EQ(queue.pop(), i + 1);
+    }
+}
+
+TEST(LockFreeQueueTests, PushBlocksUntilSpaceIsAvailable)
+{
+    LockFreeQueue<int> queue{2};
+    queue.push(1);
+    queue.push(2);
+
+    std::atomic_bool pushed = false;
+    std::thread producer{[&] {
+        queue.push(3);
+        pushed = true;
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_FALSE(pushed);
+
+    EXPECT_EQ(queue.pop(), 1);
+    producer.join();
+    EXPECT_TRUE(pushed);
+}
+
+TEST(LockFreeQueueTests, PopBlocksUntilDataIsAvailable)
+{
+    LockFreeQueue<int> queue{2};
+
+    std::atomic_bool popped = false;
+    std::thread consumer{[&] {
+        EXPECT_EQ(queue.pop(), 7);
+        popped = true;
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_FALSE(popped);
+
+    queue.push(7);
+    consumer.join();
+    EXPECT_TRUE(popped);
+}
+
+TEST(LockFreeQueueTests, ManyProducersAndConsumers)
+{
+    static constexpr auto kNUM_THREADS = 4;
+    static constexpr auto kNUM_ELEMENTS = 10'000;
+
+    LockFreeQueue<std::optional<std::uint64_t>> queue{16};
+    std::atomic_uint64_t sum = 0;
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < kNUM_THREADS; ++i) {
+        threads.emplace_back([&queue] {
+            for (std::uint64_t value = 1; value <= kNUM_ELEMENTS; ++value)
+                queue.push(value);
+            queue.push(std::nullopt);
+        });
+        threads.emplace_back([&queue, &sum] {
+            while (auto value = queue.pop())
+                sum += *value;
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(sum, std::uint64_t{kNUM_THREADS} * kNUM_ELEMENTS * (kNUM_ELEMENTS + 1) / 2);
+}
@@ -21,14 +21,23 @@
 #include "etlng/impl/Registry.hpp"
 #include "util/BinaryTestObject.hpp"
 #include "util/LoggerFixtures.hpp"
+#include "util/MockPrometheus.hpp"
 #include "util/TestObject.hpp"
+#include "util/async/context/BasicExecutionContext.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <xrpl/protocol/TxFormats.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -123,6 +132,36 @@ struct ValidSpec {
 
 static_assert(ContainsSpec<ValidSpec>);
 
+struct ExtDependsOnExt1 {
+    using dependencies = std::tuple<Ext1>;
+
+    static void
+    onLedgerData(etlng::model::LedgerData const&);
+};
+
+struct ExtDependsOnBoth {
+    using dependencies = std::tuple<Ext1, ExtDependsOnExt1>;
+
+    static void
+    onObject(uint32_t, etlng::model::Object const&);
+};
+
+struct ExtConcurrent {
+    static constexpr bool kCONCURRENT_HOOKS = true;
+    static constexpr std::string_view kNAME = "concurrent";
+
+    static void
+    onObject(uint32_t, etlng::model::Object const&);
+};
+
+static_assert(dependencyLevel<Ext1>() == 0);
+static_assert(dependencyLevel<ExtDependsOnExt1>() == 1);
+static_assert(dependencyLevel<ExtDependsOnBoth&>() == 2);
+static_assert(dependenciesRegistered<ExtDependsOnExt1, Ext1, ExtDependsOnExt1>());
+static_assert(not dependenciesRegistered<ExtDependsOnBoth, ExtDependsOnBoth, Ext1>());
+static_assert(HasConcurrentHooks<ExtConcurrent> and not HasConcurrentHooks<Ext1>);
+static_assert(HasName<ExtConcurrent> and not HasName<Ext1>);
+
 }  // namespace compiletime::checks
 
 namespace {
@@ -176,7 +215,70 @@ struct MockExtNftOffer {
     MOCK_METHOD(void, onInitialTransaction, (uint32_t, etlng::model::Transaction const&), (const));
 };
 
-struct RegistryTest : NoLoggerFixture {};
+struct RegistryTest : util::prometheus::WithPrometheus, NoLoggerFixture {};
+
+struct CallLog {
+    std::mutex mtx;
+    std::vector<std::string> calls;
+
+    void
+    add(std::string call)
+    {
+        std::scoped_lock const lock{mtx};
+        calls.push_back(std::move(call));
+    }
+};
+
+struct ExtFirst {
+    static constexpr std::string_view kNAME = "first";
+    CallLog* log;
+
+    void
+    onLedgerData(etlng::model::LedgerData const&) const
+    {
+        log->add("first");
+    }
+};
+
+struct ExtSecond {
+    using dependencies = std::tuple<ExtFirst>;
+    CallLog* log;
+
+    void
+    onLedgerData(etlng::model::LedgerData const&) const
+    {
+        log->add("second");
+    }
+};
+
+struct ExtIndependent {
+    CallLog* log;
+
+    void
+    onObject(uint32_t, etlng::model::Object const&) const
+    {
+        log->add("independent");
+    }
+};
+
+struct ExtCountingObjects {
+    static constexpr bool kCONCURRENT_HOOKS = true;
+    std::atomic_size_t* count;
+
+    void
+    onObject(uint32_t, etlng::model::Object const&) const
+    {
+        ++*count;
+    }
+};
+
+struct ExtThrowing {
+    static void
+    onLedgerData(etlng::model::LedgerData const&)
+    {
+        throw std::runtime_error("extension failed");
+    }
+};
 
 }  // namespace
 
@@ -380,3 +482,78 @@ TEST_F(RegistryTest, LedgerDataCorrectOrderOfHookCalls)
         .seq = kSEQ
     });
 }
+
+struct RegistryConcurrentTest : RegistryTest {
+protected:
+    static constexpr auto kNUM_WORKERS = 4uz;
+    util::async::PoolExecutionContext ctx_{kNUM_WORKERS};
+
+    static etlng::model::LedgerData
+    makeLedgerData(std::size_t numObjects)
+    {
+        std::vector<etlng::model::Object> objects;
+        objects.reserve(numObjects);
+        for (auto i = 0uz; i < numObjects; ++i)
+            objects.push_back(util::createObject());
+
+        return etlng::model::LedgerData{
+            .transactions = {},
+            .objects = std::move(objects),
+            .successors = {},
+            .edgeKeys = {},
+            .header = createLedgerHeader(kLEDGER_HASH, kSEQ),
+            .rawHeader = {},
+            .seq = kSEQ
+        };
+    }
+};
+
+TEST_F(RegistryConcurrentTest, DependentExtensionRunsAfterItsDependency)
+{
+    CallLog log;
+    auto reg = Registry<ExtSecond, ExtIndependent, ExtFirst>(
+        ctx_, kNUM_WORKERS, ExtSecond{.log = &log}, ExtIndependent{.log = &log}, ExtFirst{.log = &log}
+    );
+
+    reg.dispatch(makeLedgerData(3));
+
+    ASSERT_EQ(log.calls.size(), 5);
+    auto const first = std::ranges::find(log.calls, "first");
+    auto const second = std::ranges::find(log.calls, "second");
+    EXPECT_LT(first, second);
+    EXPECT_EQ(std::ranges::count(log.calls, "independent"), 3);
+}
+
+TEST_F(RegistryConcurrentTest, ConcurrentHooksCalledForEveryObject)
+{
+    static constexpr auto kNUM_OBJECTS = 2000uz;
+
+    std::atomic_size_t count = 0;
+    auto reg = Registry<ExtCountingObjects>(ctx_, kNUM_WORKERS, ExtCountingObjects{.count = &count});
+
+    reg.dispatch(makeLedgerData(kNUM_OBJECTS));
+    EXPECT_EQ(count.load(), kNUM_OBJECTS);
+
+    reg.dispatchInitialObjects(kSEQ, makeLedgerData(kNUM_OBJECTS).objects, {});
+    EXPECT_EQ(count.load(), kNUM_OBJECTS);  // ExtCountingObjects has no onInitialObject hook
+}
+
+TEST_F(RegistryConcurrentTest, ExceptionFromHookIsRethrown)
+{
+    CallLog log;
+    auto reg = Registry<ExtIndependent, ExtThrowing>(ctx_, kNUM_WORKERS, ExtIndependent{.log = &log}, ExtThrowing{});
+
+    EXPECT_THROW(reg.dispatch(makeLedgerData(1)), std::runtime_error);
+}
+
+TEST_F(RegistryConcurrentTest, MockExtensionsWithoutDependencies)
+{
+    auto extLedgerData = MockExtLedgerData{};
+    auto extOnObject = MockExtOnObject{};
+
+    EXPECT_CALL(extLedgerData, onLedgerData);
+    EXPECT_CALL(extOnObject, onObject).Times(3);
+
+    auto reg = Registry<MockExtOnObject&, MockExtLedgerData&>(ctx_, kNUM_WORKERS, extOnObject, extLedgerData);
+    reg.dispatch(makeLedgerData(3));
+}
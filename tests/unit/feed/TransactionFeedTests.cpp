@@ -39,7 +39,9 @@
 #include <xrpl/protocol/STObject.h>
 #include <xrpl/protocol/TER.h>
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -166,7 +168,27 @@ constexpr auto kTRAN_V2 =
 using namespace feed::impl;
 using namespace util::prometheus;
 
-using FeedTransactionTest = FeedBaseTest<TransactionFeed>;
+struct FeedTransactionTest : FeedBaseTest<TransactionFeed> {
+protected:
+    /**
+     * @brief Answer a doFetchLedgerObjects call for the owner funds of an offer: the issuer's account root for its key
+     * and the trust line for any other key.
+     */
+    static auto
+    ownerFundsObjects(ripple::STObject const& accountRoot, ripple::STObject const& line)
+    {
+        auto const issuerKey = ripple::keylet::account(getAccountIdWithString(kISSUER)).key;
+        return [issuerKey,
+                accountRoot = accountRoot.getSerializer().peekData(),
+                line = line.getSerializer().peekData()](std::vector<ripple::uint256> const& keys, auto, auto) {
+            std::vector<Blob> objects;
+            std::ranges::transform(keys, std::back_inserter(objects), [&](ripple::uint256 const& key) {
+                return key == issuerKey ? accountRoot : line;
+            });
+            return objects;
+        };
+    }
+};
 
 TEST_F(FeedTransactionTest, SubTransactionV1)
 {
@@ -817,14 +839,9 @@ TEST_F(FeedTransactionTest, PubTransactionWithOwnerFund)
     auto const issue2 = getIssue(kCURRENCY, kISSUER);
     line.setFieldAmount(ripple::sfBalance, ripple::STAmount(issue2, 100));
 
-    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(3);
-    auto const issueAccount = getAccountIdWithString(kISSUER);
-    auto const kk = ripple::keylet::account(issueAccount).key;
-    ON_CALL(*backend_, doFetchLedgerObject(testing::_, testing::_, testing::_))
-        .WillByDefault(testing::Return(line.getSerializer().peekData()));
     ripple::STObject const accountRoot = createAccountRootObject(kISSUER, 0, 1, 10, 2, kTXN_ID, 3);
-    ON_CALL(*backend_, doFetchLedgerObject(kk, testing::_, testing::_))
-        .WillByDefault(testing::Return(accountRoot.getSerializer().peekData()));
+    // the trust line and the issuer's account root are fetched together
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).WillOnce(ownerFundsObjects(accountRoot, line));
 
     static constexpr auto kTRANSACTION_FOR_OWNER_FUND =
         R"({
@@ -868,6 +885,66 @@ TEST_F(FeedTransactionTest, PubTransactionWithOwnerFund)
     testFeedPtr->pub(trans1, ledgerHeader, backend_);
 }
 
+TEST_F(FeedTransactionTest, PubTransactionWithoutSubscriberSkipsOwnerFund)
+{
+    auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = createCreateOfferTransactionObject(kACCOUNT1, 1, 32, kCURRENCY, kISSUER, 1, 3);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    ripple::STArray const metaArray{0};
+    ripple::STObject metaObj(ripple::sfTransactionMetaData);
+    metaObj.setFieldArray(ripple::sfAffectedNodes, metaArray);
+    metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    metaObj.setFieldU32(ripple::sfTransactionIndex, 22);
+    trans1.metadata = metaObj.getSerializer().peekData();
+
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).Times(0);
+    EXPECT_CALL(*mockSessionPtr, send).Times(0);
+    testFeedPtr->pub(trans1, ledgerHeader, backend_);
+}
+
+TEST_F(FeedTransactionTest, PubTransactionsFetchesOwnerFundsOnce)
+{
+    EXPECT_CALL(*mockSessionPtr, onDisconnect);
+    testFeedPtr->sub(sessionPtr);
+
+    auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, 33);
+    ripple::STArray const metaArray{0};
+    ripple::STObject metaObj(ripple::sfTransactionMetaData);
+    metaObj.setFieldArray(ripple::sfAffectedNodes, metaArray);
+    metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    metaObj.setFieldU32(ripple::sfTransactionIndex, 22);
+
+    std::vector<TransactionAndMetadata> transactions(2);
+    for (auto i = 0u; i < transactions.size(); ++i) {
+        ripple::STObject const obj = createCreateOfferTransactionObject(kACCOUNT1, 1, 32 + i, kCURRENCY, kISSUER, 1, 3);
+        transactions[i].transaction = obj.getSerializer().peekData();
+        transactions[i].ledgerSequence = 32;
+        transactions[i].metadata = metaObj.getSerializer().peekData();
+    }
+
+    ripple::STObject line(ripple::sfIndexes);
+    line.setFieldU16(ripple::sfLedgerEntryType, ripple::ltRIPPLE_STATE);
+    line.setFieldAmount(ripple::sfLowLimit, ripple::STAmount(10, false));
+    line.setFieldAmount(ripple::sfHighLimit, ripple::STAmount(100, false));
+    line.setFieldH256(ripple::sfPreviousTxnID, ripple::uint256{kTXN_ID});
+    line.setFieldU32(ripple::sfPreviousTxnLgrSeq, 3);
+    line.setFieldU32(ripple::sfFlags, 0);
+    line.setFieldAmount(ripple::sfBalance, ripple::STAmount(getIssue(kCURRENCY, kISSUER), 100));
+
+    ripple::STObject const accountRoot = createAccountRootObject(kISSUER, 0, 1, 10, 2, kTXN_ID, 3);
+
+    // both offers share the same owner, trust line and issuer so only two distinct objects are fetched in one go
+    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(0);
+    EXPECT_CALL(*backend_, doFetchLedgerObjects(testing::SizeIs(2), 33, testing::_))
+        .WillOnce(ownerFundsObjects(accountRoot, line));
+
+    EXPECT_CALL(*mockSessionPtr, apiSubversion).Times(2).WillRepeatedly(testing::Return(1));
+    EXPECT_CALL(*mockSessionPtr, send).Times(2);
+    testFeedPtr->pub(transactions, ledgerHeader, backend_);
+}
+
 static constexpr auto kTRAN_FROZEN =
     R"({
         "transaction":
@@ -930,14 +1007,9 @@ TEST_F(FeedTransactionTest, PubTransactionOfferCreationFrozenLine)
     line.setFieldU32(ripple::sfFlags, ripple::lsfHighFreeze);
     line.setFieldAmount(ripple::sfBalance, ripple::STAmount(getIssue(kCURRENCY, kISSUER), 100));
 
-    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(3);
-    auto const issueAccount = getAccountIdWithString(kISSUER);
-    auto const kk = ripple::keylet::account(issueAccount).key;
-    ON_CALL(*backend_, doFetchLedgerObject(testing::_, testing::_, testing::_))
-        .WillByDefault(testing::Return(line.getSerializer().peekData()));
     ripple::STObject const accountRoot = createAccountRootObject(kISSUER, 0, 1, 10, 2, kTXN_ID, 3);
-    ON_CALL(*backend_, doFetchLedgerObject(kk, testing::_, testing::_))
-        .WillByDefault(testing::Return(accountRoot.getSerializer().peekData()));
+    // the trust line and the issuer's account root are fetched together
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).WillOnce(ownerFundsObjects(accountRoot, line));
 
     EXPECT_CALL(*mockSessionPtr, apiSubversion).WillOnce(testing::Return(1));
     EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kTRAN_FROZEN))).Times(1);
@@ -968,17 +1040,12 @@ TEST_F(FeedTransactionTest, SubTransactionOfferCreationGlobalFrozen)
     line.setFieldH256(ripple::sfPreviousTxnID, ripple::uint256{kTXN_ID});
     line.setFieldU32(ripple::sfPreviousTxnLgrSeq, 3);
     line.setFieldU32(ripple::sfFlags, ripple::lsfHighFreeze);
-    auto const issueAccount = getAccountIdWithString(kISSUER);
     line.setFieldAmount(ripple::sfBalance, ripple::STAmount(getIssue(kCURRENCY, kISSUER), 100));
 
-    EXPECT_CALL(*backend_, doFetchLedgerObject).Times(2);
-    auto const kk = ripple::keylet::account(issueAccount).key;
-    ON_CALL(*backend_, doFetchLedgerObject(testing::_, testing::_, testing::_))
-        .WillByDefault(testing::Return(line.getSerializer().peekData()));
     ripple::STObject const accountRoot =
         createAccountRootObject(kISSUER, ripple::lsfGlobalFreeze, 1, 10, 2, kTXN_ID, 3);
-    ON_CALL(*backend_, doFetchLedgerObject(kk, testing::_, testing::_))
-        .WillByDefault(testing::Return(accountRoot.getSerializer().peekData()));
+    // the trust line and the issuer's account root are fetched together
+    EXPECT_CALL(*backend_, doFetchLedgerObjects).WillOnce(ownerFundsObjects(accountRoot, line));
 
     EXPECT_CALL(*mockSessionPtr, apiSubversion).WillOnce(testing::Return(1));
     EXPECT_CALL(*mockSessionPtr, send(sharedStringJsonEq(kTRAN_FROZEN))).Times(1);
@@ -1083,6 +1150,44 @@ TEST_F(FeedTransactionTest, SubProposedAccountDisconnect)
     testFeedPtr->pub(trans1, ledgerHeader, backend_);
 }
 
+TEST_F(FeedTransactionTest, ShardedFeedNotifiesEverySubscriberOnce)
+{
+    static constexpr auto kNUM_SHARDS = 4uz;
+    static constexpr auto kNUM_SESSIONS = 16uz;
+
+    TransactionFeed shardedFeed{ctx_, kNUM_SHARDS};
+    auto const account1 = getAccountIdWithString(kACCOUNT1);
+    auto const account2 = getAccountIdWithString(kACCOUNT2);
+
+    std::vector<std::shared_ptr<testing::StrictMock<MockSession>>> sessions;
+    for (auto i = 0uz; i < kNUM_SESSIONS; ++i) {
+        auto session = std::make_shared<testing::StrictMock<MockSession>>();
+        EXPECT_CALL(*session, onDisconnect).Times(2);
+        shardedFeed.sub(account1, session);
+        shardedFeed.sub(account2, session);
+        EXPECT_CALL(*session, apiSubversion).WillOnce(testing::Return(2));
+        EXPECT_CALL(*session, send(sharedStringJsonEq(kTRAN_V2)));
+        sessions.push_back(std::move(session));
+    }
+    EXPECT_EQ(shardedFeed.accountSubCount(), 2 * kNUM_SESSIONS);
+
+    auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = createPaymentTransactionObject(kACCOUNT1, kACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = createPaymentTransactionMetaObject(kACCOUNT1, kACCOUNT2, 110, 30, 22).getSerializer().peekData();
+
+    // the transaction affects both watched accounts but each subscriber still receives it once
+    shardedFeed.pub(trans1, ledgerHeader, backend_);
+
+    for (auto const& session : sessions) {
+        shardedFeed.unsub(account1, session);
+        shardedFeed.unsub(account2, session);
+    }
+    EXPECT_EQ(shardedFeed.accountSubCount(), 0);
+}
+
 struct TransactionFeedMockPrometheusTest : WithMockPrometheus, SyncExecutionCtxFixture {
 protected:
     web::SubscriptionContextPtr sessionPtr_ = std::make_shared<MockSession>();
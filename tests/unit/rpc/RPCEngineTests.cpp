@@ -49,6 +49,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <optional>
@@ -77,9 +78,19 @@ generateDefaultRPCEngineConfig()
 {
     return ClioConfigDefinition{
         {"server.max_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(2)},
+        {"server.max_running_requests", ConfigValue{ConfigType::Integer}.defaultValue(0)},
+        {"server.load_shedding.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.load_shedding.target_wait_ms", ConfigValue{ConfigType::Integer}.defaultValue(5)},
+        {"server.load_shedding.interval_ms", ConfigValue{ConfigType::Integer}.defaultValue(100)},
+        {"server.load_shedding.target_read_latency_ms", ConfigValue{ConfigType::Integer}.defaultValue(0)},
         {"workers", ConfigValue{ConfigType::Integer}.defaultValue(4).withConstraint(gValidateUint16)},
         {"rpc.cache_timeout", ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(gValidatePositiveDouble)
         },
+        {"rpc.response_cache.methods.[]", Array{ConfigValue{ConfigType::String}.optional()}},
+        {"rpc.response_cache.max_entries",
+         ConfigValue{ConfigType::Integer}.defaultValue(1024).withConstraint(gValidateUint32)},
+        {"rpc.response_cache.max_bytes",
+         ConfigValue{ConfigType::Integer}.defaultValue(64 * 1024 * 1024).withConstraint(gValidateUint32)},
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint")},
         {"dos_guard.whitelist.[]", Array{ConfigValue{ConfigType::String}.optional()}},
         {"dos_guard.max_fetches",
@@ -468,7 +479,12 @@ TEST_F(RPCEngineTest, NotCacheIfErrorHappen)
         {"server.max_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(2)},
         {"workers", ConfigValue{ConfigType::Integer}.defaultValue(4).withConstraint(gValidateUint16)},
         {"rpc.cache_timeout", ConfigValue{ConfigType::Double}.defaultValue(10.0).withConstraint(gValidatePositiveDouble)
-        }
+        },
+        {"rpc.response_cache.methods.[]", Array{ConfigValue{ConfigType::String}.optional()}},
+        {"rpc.response_cache.max_entries",
+         ConfigValue{ConfigType::Integer}.defaultValue(1024).withConstraint(gValidateUint32)},
+        {"rpc.response_cache.max_bytes",
+         ConfigValue{ConfigType::Integer}.defaultValue(64 * 1024 * 1024).withConstraint(gValidateUint32)}
     };
 
     auto const notAdmin = false;
@@ -507,3 +523,65 @@ TEST_F(RPCEngineTest, NotCacheIfErrorHappen)
         });
     }
 }
+
+struct RPCEngineLedgerResponseCacheTest : RPCEngineTest {
+    ClioConfigDefinition cfgCache = [] {
+        auto config = generateDefaultRPCEngineConfig();
+        auto const configJson = json::parse(R"JSON({"rpc": {"response_cache": {"methods": ["ledger"]}}})JSON");
+        auto const errors = config.parse(ConfigFileJson{configJson.as_object()});
+        EXPECT_FALSE(errors.has_value());
+        return config;
+    }();
+
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::makeRPCEngine(
+            cfgCache, backend_, mockLoadBalancerPtr_, dosGuard, queue, *mockCountersPtr_, handlerProvider
+        );
+
+    void
+    expectComputed(std::string const& params, std::uint32_t maxSequence)
+    {
+        runSpawn([&](auto yield) {
+            auto const ctx = web::Context(
+                yield,
+                "ledger",
+                1,
+                json::parse(params).as_object(),
+                nullptr,
+                tagFactory,
+                LedgerRange{.minSequence = 10, .maxSequence = maxSequence},
+                "127.0.0.2",
+                false
+            );
+
+            auto const res = engine->buildResponse(ctx);
+            auto const response = std::get_if<boost::json::object>(&res.response);
+            ASSERT_NE(response, nullptr);
+            EXPECT_EQ(*response, json::parse(R"JSON({"computed": "world_50"})JSON").as_object());
+        });
+    }
+};
+
+TEST_F(RPCEngineLedgerResponseCacheTest, ResponseForFixedLedgerIsServedWithoutHandler)
+{
+    EXPECT_CALL(*handlerProvider, isClioOnly).Times(3).WillRepeatedly(Return(false));
+    EXPECT_CALL(*backend_, isTooBusy).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler).WillOnce(Return(AnyHandler{tests::common::HandlerFake{}}));
+
+    expectComputed(R"JSON({"hello": "world", "limit": 50, "ledger_index": 20})JSON", 30);
+    expectComputed(R"JSON({"ledger_index": 20, "limit": 50, "hello": "world", "id": 1})JSON", 30);
+
+    // a newer validated ledger does not change the response for ledger 20
+    expectComputed(R"JSON({"hello": "world", "limit": 50, "ledger_index": 20})JSON", 31);
+}
+
+TEST_F(RPCEngineLedgerResponseCacheTest, ResponseForLatestLedgerIsDroppedWhenNewLedgerIsPublished)
+{
+    EXPECT_CALL(*handlerProvider, isClioOnly).Times(3).WillRepeatedly(Return(false));
+    EXPECT_CALL(*backend_, isTooBusy).Times(2).WillRepeatedly(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler).Times(2).WillRepeatedly(Return(AnyHandler{tests::common::HandlerFake{}}));
+
+    expectComputed(R"JSON({"hello": "world", "limit": 50})JSON", 30);
+    expectComputed(R"JSON({"limit": 50, "hello": "world"})JSON", 30);
+    expectComputed(R"JSON({"hello": "world", "limit": 50})JSON", 31);
+}
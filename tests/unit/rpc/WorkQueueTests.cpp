@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include "rpc/WorkQueue.hpp"
+#include "rpc/impl/AdmissionController.hpp"
 #include "util/LoggerFixtures.hpp"
 #include "util/MockPrometheus.hpp"
 #include "util/newconfig/ConfigDefinition.hpp"
@@ -25,14 +26,18 @@
 #include "util/newconfig/Types.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <semaphore>
+#include <string>
+#include <vector>
 
 using namespace util;
 using namespace util::config;
@@ -42,6 +47,11 @@ using namespace util::prometheus;
 struct RPCWorkQueueTestBase : NoLoggerFixture {
     ClioConfigDefinition cfg = {
         {"server.max_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(2)},
+        {"server.max_running_requests", ConfigValue{ConfigType::Integer}.defaultValue(0)},
+        {"server.load_shedding.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.load_shedding.target_wait_ms", ConfigValue{ConfigType::Integer}.defaultValue(5)},
+        {"server.load_shedding.interval_ms", ConfigValue{ConfigType::Integer}.defaultValue(100)},
+        {"server.load_shedding.target_read_latency_ms", ConfigValue{ConfigType::Integer}.defaultValue(0)},
         {"workers", ConfigValue{ConfigType::Integer}.defaultValue(4)}
     };
 
@@ -104,6 +114,108 @@ TEST_F(WorkQueueTest, NonWhitelistedPreventSchedulingAtQueueLimitExceeded)
     EXPECT_TRUE(unblocked);
 }
 
+TEST_F(WorkQueueTest, CostClassOfMethod)
+{
+    EXPECT_EQ(WorkQueue::costClassOf("ping"), WorkQueue::CostClass::Cheap);
+    EXPECT_EQ(WorkQueue::costClassOf("server_info"), WorkQueue::CostClass::Cheap);
+    EXPECT_EQ(WorkQueue::costClassOf("account_info"), WorkQueue::CostClass::Default);
+    EXPECT_EQ(WorkQueue::costClassOf(""), WorkQueue::CostClass::Default);
+    EXPECT_EQ(WorkQueue::costClassOf("account_tx"), WorkQueue::CostClass::Expensive);
+    EXPECT_EQ(WorkQueue::costClassOf("ledger_data"), WorkQueue::CostClass::Expensive);
+}
+
+struct WorkQueueSchedulingTest : WithPrometheus, NoLoggerFixture {
+    WorkQueue queue{1u, 0u, 1u};
+
+    std::binary_semaphore blocker{0};
+    std::mutex mtx;
+    std::vector<std::string> executed;
+
+    WorkQueueSchedulingTest()
+    {
+        // occupies the only running slot so that all the jobs posted by the test are queued
+        queue.postCoro([this](auto /* yield */) { blocker.acquire(); }, false);
+    }
+
+    void
+    post(std::string name, WorkQueue::CostClass costClass, std::string const& client)
+    {
+        auto const res = queue.postCoro(
+            [this, name = std::move(name)](auto /* yield */) {
+                std::scoped_lock const lk{mtx};
+                executed.push_back(name);
+            },
+            false,
+            costClass,
+            client
+        );
+        EXPECT_TRUE(res);
+    }
+};
+
+TEST_F(WorkQueueSchedulingTest, CheapJobsAreNotStuckBehindExpensiveOnes)
+{
+    post("expensive1", WorkQueue::CostClass::Expensive, "client");
+    post("expensive2", WorkQueue::CostClass::Expensive, "client");
+    post("expensive3", WorkQueue::CostClass::Expensive, "client");
+    post("cheap", WorkQueue::CostClass::Cheap, "client");
+
+    blocker.release();
+    queue.join();
+
+    EXPECT_THAT(executed, testing::ElementsAre("cheap", "expensive1", "expensive2", "expensive3"));
+}
+
+TEST_F(WorkQueueSchedulingTest, ClientsAreServedFairly)
+{
+    post("a1", WorkQueue::CostClass::Default, "a");
+    post("a2", WorkQueue::CostClass::Default, "a");
+    post("a3", WorkQueue::CostClass::Default, "a");
+    post("b1", WorkQueue::CostClass::Default, "b");
+
+    blocker.release();
+    queue.join();
+
+    EXPECT_THAT(executed, testing::ElementsAre("a1", "b1", "a2", "a3"));
+}
+
+struct WorkQueueLoadSheddingTest : WithPrometheus, NoLoggerFixture {
+    std::chrono::microseconds readLatency{std::chrono::milliseconds{1}};
+
+    WorkQueue queue{
+        1u,
+        0u,
+        1u,
+        rpc::impl::AdmissionController::Settings{
+            .targetWait = std::chrono::hours{1},
+            .interval = std::chrono::hours{1},
+            .targetReadLatency = std::chrono::milliseconds{10},
+            .readLatency = [this] { return readLatency; }
+        }
+    };
+
+    std::binary_semaphore blocker{0};
+};
+
+TEST_F(WorkQueueLoadSheddingTest, RejectsLowPriorityJobsWhenOverloaded)
+{
+    auto const noop = [](auto /* yield */) {};
+
+    EXPECT_TRUE(queue.postCoro([this](auto /* yield */) { blocker.acquire(); }, false));
+    EXPECT_TRUE(queue.postCoro(noop, false, WorkQueue::CostClass::Expensive, "client"));
+
+    readLatency = std::chrono::milliseconds{20};
+    EXPECT_FALSE(queue.postCoro(noop, false, WorkQueue::CostClass::Expensive, "client"));
+    EXPECT_FALSE(queue.postCoro(noop, false, WorkQueue::CostClass::Default, "client"));
+    EXPECT_TRUE(queue.postCoro(noop, false, WorkQueue::CostClass::Cheap, "client"));
+    EXPECT_TRUE(queue.postCoro(noop, true, WorkQueue::CostClass::Expensive, "client"));
+
+    blocker.release();
+    queue.join();
+
+    EXPECT_EQ(queue.report().at("queued"), 4);
+}
+
 struct WorkQueueStopTest : WorkQueueTest {
     testing::StrictMock<testing::MockFunction<void()>> onTasksComplete;
     testing::StrictMock<testing::MockFunction<void()>> taskMock;
@@ -156,12 +268,16 @@ TEST_F(WorkQueueMockPrometheusTest, postCoroCouhters)
     auto& queuedMock = makeMock<CounterInt>("work_queue_queued_total_number", "");
     auto& durationMock = makeMock<CounterInt>("work_queue_cumulitive_tasks_duration_us", "");
     auto& curSizeMock = makeMock<GaugeInt>("work_queue_current_size", "");
+    auto& depthMock = makeMock<HistogramInt>("work_queue_depth_histogram", "{class=\"default\"}");
+    auto& waitMock = makeMock<HistogramInt>("work_queue_wait_duration_microseconds_histogram", "{class=\"default\"}");
 
     std::binary_semaphore semaphore{0};
 
     EXPECT_CALL(curSizeMock, value()).Times(2).WillRepeatedly(::testing::Return(0));
     EXPECT_CALL(curSizeMock, add(1));
     EXPECT_CALL(queuedMock, add(1));
+    EXPECT_CALL(depthMock, observe(1));
+    EXPECT_CALL(waitMock, observe(::testing::Gt(0)));
     EXPECT_CALL(durationMock, add(::testing::Gt(0))).WillOnce([&](auto) {
         EXPECT_CALL(curSizeMock, add(-1));
         semaphore.release();
@@ -31,6 +31,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/STObject.h>
 
 #include <cstdint>
@@ -1574,7 +1575,8 @@ TEST_F(RPCAccountTxHandlerTest, NFTTxs_API_v2)
         .Times(1);
 
     auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, 11);
-    EXPECT_CALL(*backend_, fetchLedgerBySequence).Times(transactions.size()).WillRepeatedly(Return(ledgerHeader));
+    EXPECT_CALL(*backend_, doFetchLedgersBySequence(ElementsAre(kMIN_SEQ + 1), _))
+        .WillOnce(Return(std::vector<std::optional<ripple::LedgerHeader>>{ledgerHeader}));
 
     runSpawn([&, this](auto yield) {
         auto const handler = AnyHandler{AccountTxHandler{backend_}};
@@ -2095,7 +2097,10 @@ TEST_P(AccountTxTransactionTypeTest, SpecificTransactionType)
 
     auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, kMAX_SEQ);
     ON_CALL(*backend_, fetchLedgerBySequence(kMAX_SEQ, _)).WillByDefault(Return(ledgerHeader));
-    EXPECT_CALL(*backend_, fetchLedgerBySequence(kMAX_SEQ, _)).Times(Between(1, 2));
+    EXPECT_CALL(*backend_, fetchLedgerBySequence(kMAX_SEQ, _));
+    ON_CALL(*backend_, doFetchLedgersBySequence(ElementsAre(kMAX_SEQ, kMAX_SEQ - 1), _))
+        .WillByDefault(Return(std::vector<std::optional<ripple::LedgerHeader>>{ledgerHeader, std::nullopt}));
+    EXPECT_CALL(*backend_, doFetchLedgersBySequence).Times(AtMost(1));
 
     auto const testBundle = GetParam();
     runSpawn([&, this](auto yield) {
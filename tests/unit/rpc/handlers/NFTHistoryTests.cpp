@@ -31,6 +31,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/STObject.h>
 
 #include <cstdint>
@@ -599,8 +600,8 @@ TEST_F(RPCNFTHistoryHandlerTest, IndexSpecificForwardFalseV2)
         .WillOnce(Return(transCursor));
 
     auto const ledgerHeader = createLedgerHeader(kLEDGER_HASH, kMAX_SEQ);
-    ON_CALL(*backend_, fetchLedgerBySequence).WillByDefault(Return(ledgerHeader));
-    EXPECT_CALL(*backend_, fetchLedgerBySequence).Times(2);
+    EXPECT_CALL(*backend_, doFetchLedgersBySequence(ElementsAre(kMIN_SEQ + 1, kMAX_SEQ - 1), _))
+        .WillOnce(Return(std::vector<std::optional<ripple::LedgerHeader>>{ledgerHeader, ledgerHeader}));
 
     runSpawn([&, this](auto yield) {
         auto const handler = AnyHandler{NFTHistoryHandler{backend_}};
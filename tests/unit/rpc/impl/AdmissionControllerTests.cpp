@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/impl/AdmissionController.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace rpc::impl;
+using namespace std::chrono_literals;
+
+struct AdmissionControllerTests : ::testing::Test {
+protected:
+    AdmissionController::ClockType::time_point const start_ = AdmissionController::ClockType::now();
+    AdmissionController controller_{AdmissionController::Settings{.targetWait = 5ms, .interval = 100ms}};
+};
+
+TEST_F(AdmissionControllerTests, NotOverloadedByDefault)
+{
+    EXPECT_FALSE(controller_.isOverloaded(true, start_));
+}
+
+TEST_F(AdmissionControllerTests, ShortBurstIsTolerated)
+{
+    controller_.onJobStarted(50ms, start_);
+    controller_.onJobStarted(50ms, start_ + 50ms);
+    EXPECT_FALSE(controller_.isOverloaded(true, start_ + 50ms));
+
+    controller_.onJobStarted(1ms, start_ + 60ms);
+    controller_.onJobStarted(50ms, start_ + 120ms);
+    EXPECT_FALSE(controller_.isOverloaded(true, start_ + 120ms));
+}
+
+TEST_F(AdmissionControllerTests, OverloadedWhenWaitStaysAboveTargetForInterval)
+{
+    controller_.onJobStarted(50ms, start_);
+    controller_.onJobStarted(50ms, start_ + 100ms);
+    EXPECT_TRUE(controller_.isOverloaded(true, start_ + 100ms));
+    EXPECT_TRUE(controller_.isOverloaded(false, start_ + 150ms));
+}
+
+TEST_F(AdmissionControllerTests, RecoversWhenWaitDropsBelowTarget)
+{
+    controller_.onJobStarted(50ms, start_);
+    controller_.onJobStarted(50ms, start_ + 100ms);
+    ASSERT_TRUE(controller_.isOverloaded(true, start_ + 100ms));
+
+    controller_.onJobStarted(1ms, start_ + 110ms);
+    EXPECT_FALSE(controller_.isOverloaded(true, start_ + 110ms));
+}
+
+TEST_F(AdmissionControllerTests, RecoversWhenNoJobStartsForInterval)
+{
+    controller_.onJobStarted(50ms, start_);
+    controller_.onJobStarted(50ms, start_ + 100ms);
+    ASSERT_TRUE(controller_.isOverloaded(true, start_ + 100ms));
+
+    EXPECT_FALSE(controller_.isOverloaded(true, start_ + 200ms));
+}
+
+TEST(AdmissionControllerReadLatencyTests, OverloadedWhenReadsAreSlowAndJobsAreWaiting)
+{
+    auto latency = 1ms;
+    AdmissionController const controller{AdmissionController::Settings{
+        .targetWait = 5ms, .interval = 100ms, .targetReadLatency = 10ms, .readLatency = [&latency] { return latency; }
+    }};
+
+    EXPECT_FALSE(controller.isOverloaded(true));
+
+    latency = 20ms;
+    EXPECT_TRUE(controller.isOverloaded(true));
+    EXPECT_FALSE(controller.isOverloaded(false));
+}
+
+TEST(AdmissionControllerReadLatencyTests, ReadLatencyIsIgnoredWithoutTarget)
+{
+    AdmissionController const controller{AdmissionController::Settings{
+        .targetWait = 5ms, .interval = 100ms, .readLatency = [] { return std::chrono::microseconds{10s}; }
+    }};
+
+    EXPECT_FALSE(controller.isOverloaded(true));
+}
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/impl/FairScheduler.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace rpc::impl;
+
+namespace {
+
+std::vector<int>
+popAll(FairScheduler<int>& scheduler)
+{
+    std::vector<int> result;
+    while (auto next = scheduler.pop())
+        result.push_back(next->first);
+    return result;
+}
+
+}  // namespace
+
+TEST(FairSchedulerTests, EmptySchedulerReturnsNothing)
+{
+    FairScheduler<int> scheduler{{1}};
+    EXPECT_EQ(scheduler.size(), 0u);
+    EXPECT_FALSE(scheduler.pop().has_value());
+}
+
+TEST(FairSchedulerTests, SingleClientIsServedInOrder)
+{
+    FairScheduler<int> scheduler{{1}};
+    for (auto i = 0; i < 5; ++i)
+        scheduler.push(0, "client", i);
+
+    EXPECT_EQ(scheduler.size(), 5u);
+    EXPECT_THAT(popAll(scheduler), testing::ElementsAre(0, 1, 2, 3, 4));
+    EXPECT_EQ(scheduler.size(), 0u);
+}
+
+TEST(FairSchedulerTests, ClientsOfTheSameClassAreServedInTurns)
+{
+    FairScheduler<int> scheduler{{1}};
+    for (auto i = 0; i < 4; ++i)
+        scheduler.push(0, "greedy", i);
+    scheduler.push(0, "other", 100);
+    scheduler.push(0, "third", 200);
+
+    EXPECT_THAT(popAll(scheduler), testing::ElementsAre(0, 100, 200, 1, 2, 3));
+}
+
+TEST(FairSchedulerTests, ClassesAreServedAccordingToTheirWeights)
+{
+    FairScheduler<int> scheduler{{3, 1}};
+    for (auto i = 0; i < 8; ++i) {
+        scheduler.push(0, "client", i);
+        scheduler.push(1, "client", 100 + i);
+    }
+    EXPECT_EQ(scheduler.size(0), 8u);
+    EXPECT_EQ(scheduler.size(1), 8u);
+
+    std::vector<std::size_t> classes;
+    for (auto i = 0; i < 8; ++i)
+        classes.push_back(scheduler.pop()->second);
+
+    EXPECT_THAT(classes, testing::ElementsAre(0, 0, 1, 0, 0, 0, 1, 0));
+    EXPECT_EQ(scheduler.size(0), 2u);
+    EXPECT_EQ(scheduler.size(1), 6u);
+}
+
+TEST(FairSchedulerTests, LowWeightClassIsNotStarved)
+{
+    FairScheduler<int> scheduler{{8, 1}};
+    scheduler.push(1, "client", 100);
+    for (auto i = 0; i < 100; ++i)
+        scheduler.push(0, "client", i);
+
+    auto const result = popAll(scheduler);
+    auto const position = std::ranges::find(result, 100) - result.begin();
+    EXPECT_LT(position, 9);
+}
+
+TEST(FairSchedulerTests, EmptyClassGivesUpItsShare)
+{
+    FairScheduler<int> scheduler{{1, 8}};
+    for (auto i = 0; i < 3; ++i)
+        scheduler.push(0, "client", i);
+
+    EXPECT_THAT(popAll(scheduler), testing::ElementsAre(0, 1, 2));
+}
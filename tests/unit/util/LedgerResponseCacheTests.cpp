@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/LedgerResponseCache.hpp"
+#include "util/MockPrometheus.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace util;
+
+struct LedgerResponseCacheTests : util::prometheus::WithPrometheus {
+protected:
+    LedgerResponseCache cache_{2, 1024, {"ledger", "account_info"}};
+    boost::json::object params_{{"account", "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"}, {"ledger_index", 10}};
+    boost::json::object response_{{"key", "value"}};
+};
+
+TEST_F(LedgerResponseCacheTests, PutAndGet)
+{
+    EXPECT_FALSE(cache_.get("account_info", params_, 2, 10).has_value());
+
+    cache_.put("account_info", params_, 2, 10, false, response_);
+    auto const result = cache_.get("account_info", params_, 2, 10);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, response_);
+
+    EXPECT_FALSE(cache_.get("account_info", params_, 1, 10).has_value());
+    EXPECT_FALSE(cache_.get("account_info", params_, 2, 11).has_value());
+    EXPECT_FALSE(cache_.get("ledger", params_, 2, 10).has_value());
+}
+
+TEST_F(LedgerResponseCacheTests, MethodsNotOptedInAreNotCached)
+{
+    EXPECT_FALSE(cache_.shouldCache("server_info"));
+    cache_.put("server_info", params_, 2, 10, false, response_);
+    EXPECT_FALSE(cache_.get("server_info", params_, 2, 10).has_value());
+    EXPECT_EQ(cache_.size(), 0u);
+}
+
+TEST_F(LedgerResponseCacheTests, EquivalentParamsShareTheKey)
+{
+    auto const params = boost::json::parse(R"JSON({
+        "id": 42,
+        "command": "account_info",
+        "api_version": 2,
+        "ledger_index": 10,
+        "account": "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"
+    })JSON");
+
+    EXPECT_EQ(
+        LedgerResponseCache::makeKey("account_info", params.as_object(), 2, 10),
+        LedgerResponseCache::makeKey("account_info", params_, 2, 10)
+    );
+    EXPECT_NE(
+        LedgerResponseCache::makeKey("account_info", boost::json::object{{"account", "a"}, {"strict", true}}, 2, 10),
+        LedgerResponseCache::makeKey("account_info", boost::json::object{{"account", "a"}}, 2, 10)
+    );
+}
+
+TEST_F(LedgerResponseCacheTests, NewLedgerDropsResponsesResolvedToLatestLedger)
+{
+    boost::json::object const latestParams{{"account", "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"}};
+
+    cache_.put("account_info", params_, 2, 10, false, response_);
+    cache_.put("account_info", latestParams, 2, 20, true, response_);
+
+    cache_.onLedgerRange(5, 20);
+    EXPECT_EQ(cache_.size(), 2u);
+
+    cache_.onLedgerRange(5, 21);
+    EXPECT_TRUE(cache_.get("account_info", params_, 2, 10).has_value());
+    EXPECT_FALSE(cache_.get("account_info", latestParams, 2, 20).has_value());
+
+    // responses resolved to an older ledger than the latest one are not stored
+    cache_.put("account_info", latestParams, 2, 20, true, response_);
+    EXPECT_EQ(cache_.size(), 1u);
+}
+
+TEST_F(LedgerResponseCacheTests, LedgersOutOfRangeAreDropped)
+{
+    cache_.put("account_info", params_, 2, 10, false, response_);
+    cache_.onLedgerRange(11, 21);
+    EXPECT_EQ(cache_.size(), 0u);
+}
+
+TEST_F(LedgerResponseCacheTests, EvictsLeastRecentlyUsedResponse)
+{
+    cache_.put("account_info", params_, 2, 10, false, response_);
+    cache_.put("account_info", params_, 2, 11, false, response_);
+    EXPECT_TRUE(cache_.get("account_info", params_, 2, 10).has_value());
+
+    cache_.put("account_info", params_, 2, 12, false, response_);
+    EXPECT_EQ(cache_.size(), 2u);
+    EXPECT_TRUE(cache_.get("account_info", params_, 2, 10).has_value());
+    EXPECT_FALSE(cache_.get("account_info", params_, 2, 11).has_value());
+    EXPECT_TRUE(cache_.get("account_info", params_, 2, 12).has_value());
+}
+
+TEST_F(LedgerResponseCacheTests, EvictsByTheSizeOfTheResponses)
+{
+    auto const responseBytes = boost::json::serialize(response_).size();
+    LedgerResponseCache cache{10, 2 * responseBytes, {"account_info"}};
+
+    cache.put("account_info", params_, 2, 10, false, response_);
+    cache.put("account_info", params_, 2, 11, false, response_);
+    EXPECT_EQ(cache.bytes(), 2 * responseBytes);
+
+    cache.put("account_info", params_, 2, 12, false, response_);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.bytes(), 2 * responseBytes);
+    EXPECT_FALSE(cache.get("account_info", params_, 2, 10).has_value());
+
+    // a response larger than the whole cache is not stored
+    cache.put("account_info", params_, 2, 13, false, {{"key", std::string(2 * responseBytes, 'x')}});
+    EXPECT_FALSE(cache.get("account_info", params_, 2, 13).has_value());
+    EXPECT_EQ(cache.size(), 2u);
+
+    cache.onLedgerRange(12, 20);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.bytes(), responseBytes);
+}
@@ -27,6 +27,7 @@
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 using namespace util::prometheus;
 
@@ -142,6 +143,28 @@ TEST_F(CounterIntTests, multithreadAdd)
     EXPECT_EQ(counter.value(), kNUM_ADDITIONS + (kNUM_NUMBER_ADDITIONS * kNUMBER_TO_ADD));
 }
 
+TEST_F(CounterIntTests, resetAfterMultithreadAdd)
+{
+    static constexpr auto kNUM_THREADS = 8;
+    static constexpr auto kNUM_ADDITIONS = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNUM_THREADS; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kNUM_ADDITIONS; ++j) {
+                ++counter;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_EQ(counter.value(), kNUM_THREADS * kNUM_ADDITIONS);
+
+    counter.reset();
+    EXPECT_EQ(counter.value(), 0);
+    ++counter;
+    EXPECT_EQ(counter.value(), 1);
+}
+
 struct CounterDoubleTests : ::testing::Test {
     CounterDouble counter{"test_counter", R"(label1="value1",label2="value2")"};
 };
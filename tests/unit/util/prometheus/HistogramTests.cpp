@@ -19,12 +19,14 @@
 
 #include "util/prometheus/Histogram.hpp"
 #include "util/prometheus/OStream.hpp"
+#include "util/prometheus/impl/HistogramImpl.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <cstdint>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -119,3 +121,45 @@ TEST_F(HistogramTests, observe)
         "t_count{label1=\"value1\",label2=\"value2\"} 3\n"
     );
 }
+
+TEST_F(HistogramTests, multithreadObserve)
+{
+    static constexpr auto kNUM_THREADS = 8;
+    static constexpr auto kNUM_OBSERVATIONS = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNUM_THREADS; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kNUM_OBSERVATIONS; ++j) {
+                histogram.observe(j % 5);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(
+        serialize(),
+        "t_bucket{label1=\"value1\",label2=\"value2\",le=\"1\"} 3200\n"
+        "t_bucket{label1=\"value1\",label2=\"value2\",le=\"2\"} 4800\n"
+        "t_bucket{label1=\"value1\",label2=\"value2\",le=\"3\"} 6400\n"
+        "t_bucket{label1=\"value1\",label2=\"value2\",le=\"+Inf\"} 8000\n"
+        "t_sum{label1=\"value1\",label2=\"value2\"} 16000\n"
+        "t_count{label1=\"value1\",label2=\"value2\"} 8000\n"
+    );
+}
+
+TEST(MutexHistogramTests, serializesSameAsDefault)
+{
+    HistogramInt sharded{"t", "", {1, 2, 3}};
+    HistogramInt mutexBased{"t", "", {1, 2, 3}, impl::HistogramImpl<std::int64_t>{}};
+    for (auto const value : {0, 2, 3, 123}) {
+        sharded.observe(value);
+        mutexBased.observe(value);
+    }
+
+    OStream shardedStream{false};
+    sharded.serializeValue(shardedStream);
+    OStream mutexBasedStream{false};
+    mutexBased.serializeValue(mutexBasedStream);
+    EXPECT_EQ(std::move(shardedStream).data(), std::move(mutexBasedStream).data());
+}
@@ -28,6 +28,8 @@
 #include "util/newconfig/ConfigFileJson.hpp"
 #include "util/newconfig/ConfigValue.hpp"
 #include "util/newconfig/Types.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 #include "web/AdminVerificationStrategy.hpp"
@@ -36,22 +38,32 @@
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/dosguard/IntervalSweepHandler.hpp"
 #include "web/dosguard/WhitelistHandler.hpp"
+#include "web/impl/JsonStream.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/spawn.hpp>
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/http/field.hpp>
+#include <boost/beast/http/message.hpp>
 #include <boost/beast/http/status.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/verb.hpp>
 #include <boost/beast/websocket/error.hpp>
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/value.hpp>
+#include <boost/json/value_to.hpp>
 #include <boost/system/system_error.hpp>
 #include <fmt/core.h>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <test_data/SslCert.hpp>
 
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -120,6 +132,14 @@ getParseServerConfig(boost::json::value val)
         {"server.admin_password", ConfigValue{ConfigType::String}.optional()},
         {"server.local_admin", ConfigValue{ConfigType::Boolean}.optional()},
         {"server.ws_max_sending_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(1500)},
+        {"server.ws_compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.server_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.client_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.server_max_window_bits", ConfigValue{ConfigType::Integer}.defaultValue(15)},
+        {"server.ws_compression.client_max_window_bits", ConfigValue{ConfigType::Integer}.defaultValue(15)},
+        {"server.ws_compression.level", ConfigValue{ConfigType::Integer}.defaultValue(8)},
+        {"server.ws_compression.memory_level", ConfigValue{ConfigType::Integer}.defaultValue(4)},
+        {"server.ws_compression.min_message_size", ConfigValue{ConfigType::Integer}.defaultValue(256)},
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint")},
         {"dos_guard.max_fetches", ConfigValue{ConfigType::Integer}},
         {"dos_guard.sweep_interval", ConfigValue{ConfigType::Integer}},
@@ -549,6 +569,14 @@ getParseAdminServerConfig(boost::json::value val)
         {"server.processing_policy", ConfigValue{ConfigType::String}.defaultValue("parallel")},
         {"server.parallel_requests_limit", ConfigValue{ConfigType::Integer}.optional()},
         {"server.ws_max_sending_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(1500)},
+        {"server.ws_compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.server_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.client_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.server_max_window_bits", ConfigValue{ConfigType::Integer}.defaultValue(15)},
+        {"server.ws_compression.client_max_window_bits", ConfigValue{ConfigType::Integer}.defaultValue(15)},
+        {"server.ws_compression.level", ConfigValue{ConfigType::Integer}.defaultValue(8)},
+        {"server.ws_compression.memory_level", ConfigValue{ConfigType::Integer}.defaultValue(4)},
+        {"server.ws_compression.min_message_size", ConfigValue{ConfigType::Integer}.defaultValue(256)},
         {"ssl_cert_file", ConfigValue{ConfigType::String}.optional()},
         {"ssl_key_file", ConfigValue{ConfigType::String}.optional()},
         {"prometheus.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
@@ -775,3 +803,324 @@ TEST_F(WebServerPrometheusTest, validResponse)
     EXPECT_EQ(res, "# TYPE test_counter counter\ntest_counter 1\n\n");
     EXPECT_EQ(status, boost::beast::http::status::ok);
 }
+
+class BurstExecutor {
+    std::size_t count_;
+    bool fromOtherThread_;
+
+public:
+    explicit BurstExecutor(std::size_t count, bool fromOtherThread = false)
+        : count_(count), fromOtherThread_(fromOtherThread)
+    {
+    }
+
+    void
+    operator()(std::string const& /* req */, std::shared_ptr<web::ConnectionBase> const& ws)
+    {
+        auto const sendAll = [this, &ws] {
+            for (auto i = 0uz; i < count_; ++i)
+                ws->send(std::make_shared<std::string>(std::to_string(i)));
+        };
+
+        if (fromOtherThread_) {
+            // the session is busy until the handler returns so all the messages are queued as one batch
+            std::thread{sendAll}.join();
+        } else {
+            sendAll();
+        }
+    }
+
+    void
+    operator()(boost::beast::error_code /* ec */, std::shared_ptr<web::ConnectionBase> const& /* ws */)
+    {
+    }
+};
+
+namespace {
+
+ClioConfigDefinition
+getParseServerConfigWithSendingQueueSize(std::string_view port, std::uint32_t queueSize)
+{
+    auto json = generateJSONWithDynamicPort(port);
+    json.as_object()["server"].as_object()["ws_max_sending_queue_size"] = queueSize;
+    return getParseServerConfig(json);
+}
+
+}  // namespace
+
+TEST_F(WebServerTest, WsBatchOfMessagesIsSentInOrder)
+{
+    static constexpr auto kCOUNT = 100uz;
+    auto const e = std::make_shared<BurstExecutor>(kCOUNT, true);
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+
+    EXPECT_EQ(wsClient.syncPost("{}"), "0");
+    for (auto i = 1uz; i < kCOUNT; ++i)
+        EXPECT_EQ(wsClient.receive(), std::to_string(i));
+
+    wsClient.disconnect();
+}
+
+struct WebServerMockPrometheusTest : util::prometheus::WithMockPrometheus, WebServerTest {};
+
+TEST_F(WebServerMockPrometheusTest, WsClientFallingBehindIsReportedUntilItCatchesUp)
+{
+    // more than half of the queue is filled before the first message is written
+    static constexpr auto kCOUNT = 6uz;
+    auto& fallingBehindMock = makeMock<prometheus::GaugeInt>("ws_falling_behind_connections_total_number", "");
+    auto& disconnectsMock = makeMock<prometheus::CounterInt>("ws_slow_client_disconnects_total_number", "");
+
+    testing::Sequence const sequence;
+    EXPECT_CALL(fallingBehindMock, add(1)).InSequence(sequence);
+    EXPECT_CALL(fallingBehindMock, add(-1)).InSequence(sequence);
+    EXPECT_CALL(disconnectsMock, add).Times(0);
+
+    ClioConfigDefinition const serverConfig{getParseServerConfigWithSendingQueueSize(port, 10)};
+    auto const e = std::make_shared<BurstExecutor>(kCOUNT);
+    auto const server = makeServerSync(serverConfig, ctx, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+
+    EXPECT_EQ(wsClient.syncPost("{}"), "0");
+    for (auto i = 1uz; i < kCOUNT; ++i)
+        EXPECT_EQ(wsClient.receive(), std::to_string(i));
+
+    wsClient.disconnect();
+}
+
+TEST_F(WebServerMockPrometheusTest, WsSlowClientIsDisconnectedWhenQueueIsFull)
+{
+    static constexpr auto kCOUNT = 12uz;
+    auto& fallingBehindMock = makeMock<prometheus::GaugeInt>("ws_falling_behind_connections_total_number", "");
+    auto& disconnectsMock = makeMock<prometheus::CounterInt>("ws_slow_client_disconnects_total_number", "");
+
+    testing::Sequence const sequence;
+    EXPECT_CALL(fallingBehindMock, add(1)).InSequence(sequence);
+    EXPECT_CALL(fallingBehindMock, add(-1)).InSequence(sequence);
+    EXPECT_CALL(disconnectsMock, add(1));
+
+    ClioConfigDefinition const serverConfig{getParseServerConfigWithSendingQueueSize(port, 10)};
+    auto const e = std::make_shared<BurstExecutor>(kCOUNT);
+    auto const server = makeServerSync(serverConfig, ctx, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+
+    // the connection is closed before all the messages are sent
+    EXPECT_THROW(
+        {
+            wsClient.syncPost("{}");
+            for (auto i = 1uz; i < kCOUNT; ++i)
+                wsClient.receive();
+        },
+        boost::system::system_error
+    );
+}
+
+class PayloadExecutor {
+public:
+    void
+    operator()(std::string const& reqStr, std::shared_ptr<web::ConnectionBase> const& ws)
+    {
+        auto const size = boost::json::value_to<std::size_t>(boost::json::parse(reqStr).at("size"));
+        ws->send(boost::json::object{{"payload", std::string(size, 'a')}}, http::status::ok);
+    }
+
+    void
+    operator()(boost::beast::error_code /* ec */, std::shared_ptr<web::ConnectionBase> const& /* ws */)
+    {
+    }
+};
+
+namespace {
+
+constexpr auto kSTREAMED_PAYLOAD_SIZE = 3 * JsonStream::kCHUNK_SIZE + 42;
+constexpr auto kCLIENT_TIMEOUT = std::chrono::seconds{5};
+
+std::string
+payloadRequest(std::size_t size)
+{
+    return fmt::format(R"({{"size":{}}})", size);
+}
+
+std::string
+payloadResponse(std::size_t size)
+{
+    return fmt::format(R"({{"payload":"{}"}})", std::string(size, 'a'));
+}
+
+}  // namespace
+
+TEST_F(WebServerTest, HttpLargeJsonResponseIsChunked)
+{
+    auto const e = std::make_shared<PayloadExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+
+    boost::asio::io_context clientCtx;
+    HttpAsyncClient client{clientCtx};
+    boost::asio::spawn(clientCtx, [&](boost::asio::yield_context yield) {
+        auto maybeError = client.connect("localhost", port, yield, kCLIENT_TIMEOUT);
+        [&]() { ASSERT_FALSE(maybeError.has_value()) << maybeError->message(); }();
+
+        http::request<http::string_body> request{http::verb::post, "/", 11, payloadRequest(kSTREAMED_PAYLOAD_SIZE)};
+        maybeError = client.send(std::move(request), yield, kCLIENT_TIMEOUT);
+        [&]() { ASSERT_FALSE(maybeError.has_value()) << maybeError->message(); }();
+
+        auto const response = client.receive(yield, kCLIENT_TIMEOUT);
+        [&]() { ASSERT_TRUE(response.has_value()) << response.error().message(); }();
+        EXPECT_EQ(response->result(), http::status::ok);
+        EXPECT_TRUE(response->chunked());
+        EXPECT_EQ(response->body(), payloadResponse(kSTREAMED_PAYLOAD_SIZE));
+
+        client.gracefulShutdown();
+    });
+    clientCtx.run();
+}
+
+TEST_F(WebServerTest, HttpLargeJsonResponseForHttp10Client)
+{
+    auto const e = std::make_shared<PayloadExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+    auto const [status, res] = HttpSyncClient::post("localhost", port, payloadRequest(kSTREAMED_PAYLOAD_SIZE));
+    EXPECT_EQ(res, payloadResponse(kSTREAMED_PAYLOAD_SIZE));
+    EXPECT_EQ(status, boost::beast::http::status::ok);
+}
+
+TEST_F(WebServerTest, WsLargeJsonResponseIsOneMessage)
+{
+    auto const e = std::make_shared<PayloadExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+    auto const res = wsClient.syncPost(payloadRequest(kSTREAMED_PAYLOAD_SIZE));
+    wsClient.disconnect();
+    EXPECT_EQ(res, payloadResponse(kSTREAMED_PAYLOAD_SIZE));
+}
+
+TEST_F(WebServerTest, WsLargeJsonResponseOverloadHasWarningAtTheEnd)
+{
+    auto const e = std::make_shared<PayloadExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuardOverload, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+    auto const res = wsClient.syncPost(payloadRequest(kSTREAMED_PAYLOAD_SIZE));
+    wsClient.disconnect();
+    EXPECT_EQ(
+        res,
+        fmt::format(
+            R"({{"payload":"{}","warning":"load","warnings":[{{"id":2003,"message":"You are about to be rate limited"}}]}})",
+            std::string(kSTREAMED_PAYLOAD_SIZE, 'a')
+        )
+    );
+}
+
+TEST_F(WebServerTest, HttpClientDisconnectsDuringLargeJsonResponse)
+{
+    // much more than the socket buffers can hold, so the response is still being streamed when the client leaves
+    static constexpr auto kHUGE_PAYLOAD_SIZE = 64uz * 1024 * 1024;
+    auto const e = std::make_shared<PayloadExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+
+    boost::asio::io_context clientCtx;
+    HttpAsyncClient client{clientCtx};
+    boost::asio::spawn(clientCtx, [&](boost::asio::yield_context yield) {
+        auto maybeError = client.connect("localhost", port, yield, kCLIENT_TIMEOUT);
+        [&]() { ASSERT_FALSE(maybeError.has_value()) << maybeError->message(); }();
+
+        http::request<http::string_body> request{http::verb::post, "/", 11, payloadRequest(kHUGE_PAYLOAD_SIZE)};
+        maybeError = client.send(std::move(request), yield, kCLIENT_TIMEOUT);
+        [&]() { ASSERT_FALSE(maybeError.has_value()) << maybeError->message(); }();
+
+        client.disconnect();
+    });
+    clientCtx.run();
+
+    auto const [status, res] = HttpSyncClient::post("localhost", port, payloadRequest(kSTREAMED_PAYLOAD_SIZE));
+    EXPECT_EQ(res, payloadResponse(kSTREAMED_PAYLOAD_SIZE));
+    EXPECT_EQ(status, boost::beast::http::status::ok);
+}
+
+TEST_F(WebServerTest, WsClientDisconnectsDuringLargeJsonResponse)
+{
+    static constexpr auto kHUGE_PAYLOAD_SIZE = 64uz * 1024 * 1024;
+    auto const e = std::make_shared<PayloadExecutor>();
+    auto const server = makeServerSync(cfg, ctx, dosGuard, e);
+
+    boost::asio::io_context clientCtx;
+    WebSocketAsyncClient client{clientCtx};
+    boost::asio::spawn(clientCtx, [&](boost::asio::yield_context yield) {
+        auto maybeError = client.connect("localhost", port, yield, kCLIENT_TIMEOUT);
+        [&]() { ASSERT_FALSE(maybeError.has_value()) << maybeError->message(); }();
+
+        maybeError = client.send(yield, payloadRequest(kHUGE_PAYLOAD_SIZE), kCLIENT_TIMEOUT);
+        [&]() { ASSERT_FALSE(maybeError.has_value()) << maybeError->message(); }();
+
+        client.close();
+    });
+    clientCtx.run();
+
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+    auto const res = wsClient.syncPost(payloadRequest(kSTREAMED_PAYLOAD_SIZE));
+    wsClient.disconnect();
+    EXPECT_EQ(res, payloadResponse(kSTREAMED_PAYLOAD_SIZE));
+}
+
+namespace {
+
+ClioConfigDefinition
+getParseServerConfigWithCompression(std::string_view port)
+{
+    auto json = generateJSONWithDynamicPort(port);
+    json.as_object()["server"].as_object()["ws_compression"] = boost::json::object{{"enabled", true}};
+    return getParseServerConfig(json);
+}
+
+}  // namespace
+
+TEST_F(WebServerPrometheusTest, WsResponseIsCompressedIfClientOffersPermessageDeflate)
+{
+    ClioConfigDefinition const serverConfig{getParseServerConfigWithCompression(port)};
+    auto const e = std::make_shared<EchoExecutor>();
+    auto const server = makeServerSync(serverConfig, ctx, dosGuard, e);
+
+    // above the default minimum size of compressed messages
+    auto const request = fmt::format(R"({{"payload":"{}"}})", std::string(1000, 'a'));
+    WebSocketSyncClient wsClient;
+    wsClient.enablePermessageDeflate();
+    wsClient.connect("localhost", port);
+    EXPECT_EQ(wsClient.syncPost(request), request);
+    wsClient.disconnect();
+
+    auto const& compressed = PrometheusService::counterInt(
+        "ws_sent_message_bytes_total_number", util::prometheus::Labels{{{"compression", "deflate"}}}
+    );
+    auto const& uncompressed = PrometheusService::counterInt(
+        "ws_sent_message_bytes_total_number", util::prometheus::Labels{{{"compression", "none"}}}
+    );
+    EXPECT_EQ(compressed.value(), request.size());
+    EXPECT_EQ(uncompressed.value(), 0u);
+}
+
+TEST_F(WebServerPrometheusTest, WsClientNotOfferingPermessageDeflateGetsUncompressedResponse)
+{
+    ClioConfigDefinition const serverConfig{getParseServerConfigWithCompression(port)};
+    auto const e = std::make_shared<EchoExecutor>();
+    auto const server = makeServerSync(serverConfig, ctx, dosGuard, e);
+
+    auto const request = fmt::format(R"({{"payload":"{}"}})", std::string(1000, 'a'));
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+    EXPECT_EQ(wsClient.syncPost(request), request);
+    wsClient.disconnect();
+
+    auto const& compressed = PrometheusService::counterInt(
+        "ws_sent_message_bytes_total_number", util::prometheus::Labels{{{"compression", "deflate"}}}
+    );
+    auto const& uncompressed = PrometheusService::counterInt(
+        "ws_sent_message_bytes_total_number", util::prometheus::Labels{{{"compression", "none"}}}
+    );
+    EXPECT_EQ(compressed.value(), 0u);
+    EXPECT_EQ(uncompressed.value(), request.size());
+}
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/MockPrometheus.hpp"
+#include "util/newconfig/ConfigDefinition.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "web/WsCompression.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/websocket/rfc6455.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace web;
+using namespace util::prometheus;
+
+TEST(WsCompressionOptionsTests, ToStreamOption)
+{
+    WsCompressionOptions const options{
+        .enabled = true,
+        .serverNoContextTakeover = true,
+        .clientNoContextTakeover = false,
+        .serverMaxWindowBits = 10,
+        .clientMaxWindowBits = 12,
+        .compressionLevel = 3,
+        .memoryLevel = 7,
+        .minMessageSize = 100
+    };
+
+    auto const option = options.toStreamOption();
+    EXPECT_TRUE(option.server_enable);
+    EXPECT_FALSE(option.client_enable);
+    EXPECT_TRUE(option.server_no_context_takeover);
+    EXPECT_FALSE(option.client_no_context_takeover);
+    EXPECT_EQ(option.server_max_window_bits, 10);
+    EXPECT_EQ(option.client_max_window_bits, 12);
+    EXPECT_EQ(option.compLevel, 3);
+    EXPECT_EQ(option.memLevel, 7);
+}
+
+TEST(WsCompressionOptionsTests, DefaultsMatchConfigDefaults)
+{
+    auto const fromConfig = WsCompressionOptions::fromConfig(util::config::gClioConfig);
+    WsCompressionOptions const defaults{};
+
+    EXPECT_EQ(fromConfig.enabled, defaults.enabled);
+    EXPECT_EQ(fromConfig.serverNoContextTakeover, defaults.serverNoContextTakeover);
+    EXPECT_EQ(fromConfig.clientNoContextTakeover, defaults.clientNoContextTakeover);
+    EXPECT_EQ(fromConfig.serverMaxWindowBits, defaults.serverMaxWindowBits);
+    EXPECT_EQ(fromConfig.clientMaxWindowBits, defaults.clientMaxWindowBits);
+    EXPECT_EQ(fromConfig.compressionLevel, defaults.compressionLevel);
+    EXPECT_EQ(fromConfig.memoryLevel, defaults.memoryLevel);
+    EXPECT_EQ(fromConfig.minMessageSize, defaults.minMessageSize);
+}
+
+struct WsCompressionTests : WithMockPrometheus {
+    WsCompression compression_{WsCompressionOptions{.enabled = true, .minMessageSize = 100}};
+
+    static boost::beast::websocket::response_type
+    makeResponse(char const* extensions)
+    {
+        boost::beast::websocket::response_type response;
+        if (extensions != nullptr)
+            response.set(boost::beast::http::field::sec_websocket_extensions, extensions);
+        return response;
+    }
+};
+
+TEST_F(WsCompressionTests, NotNegotiatedByDefault)
+{
+    EXPECT_FALSE(compression_.negotiated());
+
+    compression_.onHandshake(makeResponse(nullptr));
+    EXPECT_FALSE(compression_.negotiated());
+}
+
+TEST_F(WsCompressionTests, NegotiatedFromHandshakeResponse)
+{
+    compression_.onHandshake(makeResponse("permessage-deflate; server_no_context_takeover"));
+    EXPECT_TRUE(compression_.negotiated());
+}
+
+TEST_F(WsCompressionTests, OnlyMessagesAboveThresholdAreCompressed)
+{
+    auto& compressedMock = makeMock<CounterInt>("ws_sent_message_bytes_total_number", "{compression=\"deflate\"}");
+    auto& uncompressedMock = makeMock<CounterInt>("ws_sent_message_bytes_total_number", "{compression=\"none\"}");
+
+    compression_.onHandshake(makeResponse("permessage-deflate"));
+
+    EXPECT_CALL(uncompressedMock, add(99));
+    EXPECT_FALSE(compression_.shouldCompress(99));
+
+    EXPECT_CALL(compressedMock, add(100));
+    EXPECT_TRUE(compression_.shouldCompress(100));
+}
+
+TEST_F(WsCompressionTests, NothingIsCompressedWithoutNegotiation)
+{
+    auto& uncompressedMock = makeMock<CounterInt>("ws_sent_message_bytes_total_number", "{compression=\"none\"}");
+
+    EXPECT_CALL(uncompressedMock, add(1000));
+    EXPECT_FALSE(compression_.shouldCompress(1000));
+}
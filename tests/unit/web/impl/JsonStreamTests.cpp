@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/JsonStream.hpp"
+#include "web/impl/WarningsTail.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace web::impl;
+
+struct JsonStreamTests : testing::Test {
+protected:
+    boost::json::object const warning_{{"id", 2003}, {"message", "You are about to be rate limited"}};
+    boost::json::object const response_{
+        {"result", {{"ledger_index", 123}, {"state", boost::json::array{"a", "b", "c", "d", "e", "f", "g"}}}},
+        {"warnings", boost::json::array{1}},
+        {"id", 1}
+    };
+
+    std::vector<std::size_t> reportedSizes_;
+
+    JsonStream::LoadWarningHook
+    hook(bool overLimit = false)
+    {
+        return [this, overLimit](std::size_t size) -> std::optional<boost::json::object> {
+            reportedSizes_.push_back(size);
+            if (overLimit)
+                return warning_;
+            return std::nullopt;
+        };
+    }
+
+    static std::string
+    readAll(JsonStream& stream, std::size_t maxChunkSize)
+    {
+        std::string message;
+        for (auto chunk = stream.read(); not chunk.empty(); chunk = stream.read()) {
+            EXPECT_LE(chunk.size(), maxChunkSize);
+            message += chunk;
+        }
+        return message;
+    }
+};
+
+TEST_F(JsonStreamTests, SmallResponseIsSerializedInOneChunk)
+{
+    JsonStream stream{response_, hook()};
+
+    auto const chunk = std::string{stream.read()};
+    EXPECT_TRUE(stream.serialized());
+    EXPECT_FALSE(stream.done());
+
+    auto const message = chunk + std::string{stream.read()};
+    EXPECT_TRUE(stream.done());
+    EXPECT_TRUE(stream.read().empty());
+
+    EXPECT_EQ(boost::json::parse(message).as_object(), response_);
+    EXPECT_EQ(stream.size(), message.size());
+    ASSERT_EQ(reportedSizes_.size(), 1);
+    EXPECT_EQ(reportedSizes_.front(), message.size());
+}
+
+TEST_F(JsonStreamTests, LargeResponseIsSerializedInChunks)
+{
+    static constexpr auto kCHUNK_SIZE = 8;
+    JsonStream stream{response_, hook(), kCHUNK_SIZE};
+
+    auto const message = readAll(stream, kCHUNK_SIZE);
+    EXPECT_TRUE(stream.done());
+    EXPECT_EQ(boost::json::parse(message).as_object(), response_);
+    EXPECT_TRUE(message.ends_with(R"("warnings":[1]})")) << message;
+    ASSERT_EQ(reportedSizes_.size(), 1);
+    EXPECT_EQ(reportedSizes_.front(), message.size());
+}
+
+TEST_F(JsonStreamTests, LoadWarningIsAddedAtTheEnd)
+{
+    static constexpr auto kCHUNK_SIZE = 8;
+    JsonStream stream{response_, hook(true), kCHUNK_SIZE};
+
+    auto const message = readAll(stream, kCHUNK_SIZE);
+
+    auto expected = response_;
+    addLoadWarning(expected, warning_);
+    EXPECT_EQ(boost::json::parse(message).as_object(), expected);
+    EXPECT_EQ(stream.size(), message.size());
+    ASSERT_EQ(reportedSizes_.size(), 1);
+    EXPECT_LT(reportedSizes_.front(), message.size());
+}
+
+TEST_F(JsonStreamTests, ClosingBraceAloneInLastChunk)
+{
+    boost::json::object const response{{"a", 1}};
+    auto const serialized = boost::json::serialize(response);
+
+    JsonStream stream{response, hook(), serialized.size() - 1};
+
+    EXPECT_EQ(stream.read(), serialized.substr(0, serialized.size() - 1));
+    EXPECT_FALSE(stream.serialized());
+    EXPECT_EQ(stream.read(), "}");
+    EXPECT_TRUE(stream.done());
+}
+
+TEST_F(JsonStreamTests, EmptyResponse)
+{
+    JsonStream stream{boost::json::object{}, hook(true)};
+
+    auto const message = readAll(stream, JsonStream::kCHUNK_SIZE);
+    EXPECT_EQ(message, R"({"warning":"load","warnings":[)" + boost::json::serialize(warning_) + "]}");
+}
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2025, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/WarningsTail.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <gtest/gtest.h>
+
+using namespace web::impl;
+
+struct WarningsTailTests : testing::Test {
+protected:
+    boost::json::object const warning_{{"id", 2003}, {"message", "You are about to be rate limited"}};
+};
+
+TEST_F(WarningsTailTests, SerializeKeepsOtherFields)
+{
+    boost::json::object const response{{"result", {{"status", "success"}}}, {"id", 1}};
+
+    auto const [message, tail] = WarningsTail::serialize(response);
+    EXPECT_EQ(message, boost::json::serialize(response));
+}
+
+TEST_F(WarningsTailTests, SerializeMovesWarningsToTheEnd)
+{
+    boost::json::object const response{{"warnings", boost::json::array{1}}, {"result", "ok"}, {"warning", "x"}};
+
+    auto const [message, tail] = WarningsTail::serialize(response);
+    EXPECT_TRUE(message.ends_with(R"("warning":"x","warnings":[1]})")) << message;
+    EXPECT_EQ(boost::json::parse(message).as_object(), response);
+}
+
+TEST_F(WarningsTailTests, AddLoadWarningAppendsToExistingWarnings)
+{
+    boost::json::object response{{"result", "ok"}, {"warnings", boost::json::array{1}}};
+
+    auto [message, tail] = WarningsTail::serialize(response);
+    tail.addLoadWarning(message, warning_);
+
+    addLoadWarning(response, warning_);
+    EXPECT_EQ(boost::json::parse(message).as_object(), response);
+    EXPECT_EQ(response.at("warnings").as_array().size(), 2);
+}
+
+TEST_F(WarningsTailTests, AddLoadWarningWithoutWarnings)
+{
+    boost::json::object response{{"result", "ok"}};
+
+    auto [message, tail] = WarningsTail::serialize(response);
+    tail.addLoadWarning(message, warning_);
+
+    addLoadWarning(response, warning_);
+    EXPECT_EQ(boost::json::parse(message).as_object(), response);
+    EXPECT_EQ(response.at("warning").as_string(), "load");
+}
+
+TEST_F(WarningsTailTests, AddLoadWarningToEmptyResponse)
+{
+    auto [message, tail] = WarningsTail::serialize(boost::json::object{});
+    EXPECT_EQ(message, "{}");
+
+    tail.addLoadWarning(message, warning_);
+    EXPECT_EQ(message, R"({"warning":"load","warnings":[)" + boost::json::serialize(warning_) + "]}");
+}
+
+TEST_F(WarningsTailTests, AddLoadWarningTwice)
+{
+    boost::json::object response{{"result", "ok"}};
+
+    auto [message, tail] = WarningsTail::serialize(response);
+    tail.addLoadWarning(message, warning_);
+    tail.addLoadWarning(message, warning_);
+
+    addLoadWarning(response, warning_);
+    addLoadWarning(response, warning_);
+    EXPECT_EQ(boost::json::parse(message).as_object(), response);
+}
@@ -32,7 +32,9 @@
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/http/verb.hpp>
+#include <boost/json/array.hpp>
 #include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <fmt/core.h>
 #include <gmock/gmock.h>
@@ -223,3 +225,49 @@ TEST_F(ResponseTest, setMessageJson_WsResponse)
 
     EXPECT_EQ(response.message(), boost::json::serialize(newMessage));
 }
+
+TEST_F(ResponseTest, addLoadWarningJson_HttpResponse)
+{
+    Request const request{http::request<http::string_body>{http::verb::post, "/", httpVersion_, "some request"}};
+    boost::json::object const warning{{"id", 2003}};
+    Response response{boost::beast::http::status::ok, boost::json::object{{"key", "value"}}, request};
+
+    response.addLoadWarning(warning);
+
+    auto const httpResponse = std::move(response).intoHttpResponse();
+    boost::json::object const expected{
+        {"key", "value"}, {"warning", "load"}, {"warnings", boost::json::array{warning}}
+    };
+    EXPECT_EQ(boost::json::parse(httpResponse.body()).as_object(), expected);
+    EXPECT_EQ(httpResponse[http::field::content_length], std::to_string(httpResponse.body().size()));
+}
+
+TEST_F(ResponseTest, addLoadWarningJson_WsResponse)
+{
+    Request const request{"some request", headers_};
+    boost::json::object const warning{{"id", 2003}};
+    Response response{
+        boost::beast::http::status::ok,
+        boost::json::object{{"warnings", boost::json::array{boost::json::object{{"id", 2001}}}}, {"key", "value"}},
+        request
+    };
+
+    response.addLoadWarning(warning);
+
+    auto const json = boost::json::parse(response.message()).as_object();
+    EXPECT_EQ(json.at("warning").as_string(), "load");
+    ASSERT_EQ(json.at("warnings").as_array().size(), 2);
+    EXPECT_EQ(json.at("warnings").as_array().at(1).as_object(), warning);
+}
+
+TEST_F(ResponseTest, addLoadWarningString)
+{
+    Request const request{"some request", headers_};
+    Response response{boost::beast::http::status::ok, R"JSON({"key":"value"})JSON", request};
+
+    response.addLoadWarning(boost::json::object{{"id", 2003}});
+
+    auto const json = boost::json::parse(response.message()).as_object();
+    EXPECT_EQ(json.at("warning").as_string(), "load");
+    EXPECT_EQ(json.at("warnings").as_array().size(), 1);
+}
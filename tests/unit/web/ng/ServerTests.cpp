@@ -84,6 +84,14 @@ TEST_P(MakeServerTest, Make)
         {"server.processing_policy", ConfigValue{ConfigType::String}.defaultValue("parallel")},
         {"server.parallel_requests_limit", ConfigValue{ConfigType::Integer}.optional()},
         {"server.ws_max_sending_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(1500)},
+        {"server.ws_compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.server_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.client_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.server_max_window_bits", ConfigValue{ConfigType::Integer}.defaultValue(15)},
+        {"server.ws_compression.client_max_window_bits", ConfigValue{ConfigType::Integer}.defaultValue(15)},
+        {"server.ws_compression.level", ConfigValue{ConfigType::Integer}.defaultValue(8)},
+        {"server.ws_compression.memory_level", ConfigValue{ConfigType::Integer}.defaultValue(4)},
+        {"server.ws_compression.min_message_size", ConfigValue{ConfigType::Integer}.defaultValue(256)},
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint")},
         {"ssl_cert_file", ConfigValue{ConfigType::String}.optional()},
         {"ssl_key_file", ConfigValue{ConfigType::String}.optional()}
@@ -171,6 +179,14 @@ protected:
         {"server.local_admin", ConfigValue{ConfigType::Boolean}.optional()},
         {"server.parallel_requests_limit", ConfigValue{ConfigType::Integer}.optional()},
         {"server.ws_max_sending_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(1500)},
+        {"server.ws_compression.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.server_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.client_no_context_takeover", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+        {"server.ws_compression.server_max_window_bits", ConfigValue{ConfigType::Integer}.defaultValue(15)},
+        {"server.ws_compression.client_max_window_bits", ConfigValue{ConfigType::Integer}.defaultValue(15)},
+        {"server.ws_compression.level", ConfigValue{ConfigType::Integer}.defaultValue(8)},
+        {"server.ws_compression.memory_level", ConfigValue{ConfigType::Integer}.defaultValue(4)},
+        {"server.ws_compression.min_message_size", ConfigValue{ConfigType::Integer}.defaultValue(256)},
         {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint")},
         {"ssl_key_file", ConfigValue{ConfigType::String}.optional()},
         {"ssl_cert_file", ConfigValue{ConfigType::String}.optional()}